@@ -0,0 +1,89 @@
+#ifndef ASSET_BUNDLE_H
+#define ASSET_BUNDLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "block_reader.h"
+
+/**
+ * Packed asset bundle ("CRKB"): all of a schedule's images in one file, sent
+ * with one transfer. Little-endian:
+ *   header  magic "CRKB" u32 | version u16 | count u16 | index_crc u32 | reserved u32
+ *   index   count x { name[32] (NUL-padded) | offset u32 | size u32 | crc u32 }
+ *   assets  each at an offset that is a multiple of ASSET_BUNDLE_ALIGN
+ * Assets are LVGL binaries, named "<stem>.bin" after the schedule's image.
+ * The mounted bundle is read in place: its assets appear as files
+ * ASSET_BUNDLE_PREFIX<name>, which are byte ranges of the bundle file.
+ * tools/bundle_check feeds it malformed bundles on host.
+ */
+
+#define ASSET_BUNDLE_MAGIC 0x424B5243u       // "CRKB"
+#define ASSET_BUNDLE_VERSION 1
+#define ASSET_BUNDLE_ALIGN 512               // Assets start on SD sectors
+#define ASSET_BUNDLE_NAME_LEN 32
+#define ASSET_BUNDLE_MAX_ENTRIES 64
+#define ASSET_BUNDLE_VERIFY_CHUNK 1024       // Stack buffer for checking asset CRCs
+#define ASSET_BUNDLE_PREFIX "/bundle/"       // Virtual directory of the mounted assets
+#define ASSET_BUNDLE_FILE "assets.crkb"      // Transfer name of a bundle
+#define ASSET_BUNDLE_PATH "/lvgl_images/" ASSET_BUNDLE_FILE
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t index_crc;      // CRC-32 of the index entries
+    uint32_t reserved;
+} AssetBundleHeader;
+
+typedef struct {
+    char name[ASSET_BUNDLE_NAME_LEN];
+    uint32_t offset;         // From the start of the bundle
+    uint32_t size;
+    uint32_t crc;            // CRC-32 of the asset
+} AssetBundleEntry;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Validate a bundle's header and index and make its assets visible.
+ * Entries must be uniquely named, aligned, inside the file and disjoint.
+ * @param path SD path of the bundle file, reported by asset_bundle_path()
+ * @param verify_assets also read every asset and check it against its CRC
+ *        (after a transfer; a bundle already checked on arrival can skip it)
+ * @return false (nothing mounted) if the bundle is malformed
+ */
+bool asset_bundle_mount(block_read_at_fn read_at, void* ctx, uint32_t file_size, const char* path,
+                        bool verify_assets);
+
+void asset_bundle_unmount();
+
+/**
+ * File holding the mounted bundle, or NULL
+ */
+const char* asset_bundle_path();
+
+/**
+ * Asset of the mounted bundle by name ("breakfast.bin"), or NULL
+ */
+const AssetBundleEntry* asset_bundle_find(const char* name);
+
+/**
+ * Asset for a path in ASSET_BUNDLE_PREFIX (relative to the SD mount), or NULL
+ */
+const AssetBundleEntry* asset_bundle_lookup(const char* path);
+
+#ifdef ARDUINO
+/**
+ * Mount a bundle file from the SD card (see asset_bundle_mount)
+ */
+bool asset_bundle_mount_file(const char* path, bool verify_assets);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ASSET_BUNDLE_H */
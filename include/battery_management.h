@@ -8,10 +8,29 @@
 #define MAX_BATTERY_VOLTAGE 4.2
 #define MIN_BATTERY_VOLTAGE 2.5
 #define ADC_MAX_VALUE 4095
+#define BATTERY_SAMPLE_INTERVAL_MS 1000
 
 void battery_init();
 uint8_t get_battery_percentage();
 float get_battery_voltage();
+
+/**
+ * Sample the battery (at most every BATTERY_SAMPLE_INTERVAL_MS) and publish
+ * VM_TOPIC_BATTERY when the reading changes. Widgets are only touched through
+ * battery_refresh_ui() while Screen 3 is shown.
+ */
 void update_battery_display();
 
+/**
+ * Percentage of the last sample taken by update_battery_display(), without
+ * reading the ADC
+ * @return false before the first sample
+ */
+bool get_sampled_battery_percentage(uint8_t* percent);
+
+/**
+ * Render the last sample into the Screen 3 battery widgets
+ */
+void battery_refresh_ui();
+
 #endif
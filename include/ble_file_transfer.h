@@ -4,22 +4,40 @@
 #include <Arduino.h>
 #include <cstdint>
 
+// Data is written to <name>.part and renamed into place once its CRC verifies;
+// a manifest on the SD card lets an interrupted transfer resume, even after a reboot
+#define FILE_TRANSFER_MANIFEST "/lvgl_images/.transfer"
+#ifndef FILE_TRANSFER_CHECKPOINT_BYTES
+#define FILE_TRANSFER_CHECKPOINT_BYTES (32 * 1024)  // Sync and save the manifest this often (writer task); 0: only at the end,
+                                                    // so a power loss restarts the file
+#endif
+
 typedef struct {
     char filename[128];
     uint32_t fileSize;
     uint32_t bytesReceived;
-    uint32_t checksum;
+    uint32_t checksum;          // CRC-32 of the bytes on the card (updated when the writer finishes)
+    uint32_t expectedChecksum;  // CRC-32 of the whole file, from the phone
+    uint32_t transferId;
+    uint16_t chunkSize;
     bool isTransferring;
 } FileTransferState;
 
 // File transfer control functions
-void initFileTransfer(const char* filename, uint32_t fileSize);
+/**
+ * Start or resume a transfer. Resumes when the manifest matches id, name, size
+ * and CRC and its chunk size is no larger than *chunkSize, which is then set to it.
+ * @return Bytes already stored (0 for a fresh start); check isFileTransferring()
+ */
+uint32_t openFileTransfer(const char* filename, uint32_t fileSize, uint32_t transferId,
+                          uint32_t expectedChecksum, uint16_t* chunkSize);
 void receiveFileChunk(const uint8_t* data, size_t length);
 bool isFileTransferComplete();
 bool isFileTransferring();
 uint32_t getTransferProgress();
 const char* getCurrentFilename();
-void cancelFileTransfer();
+void suspendFileTransfer();   // Link lost: keep the data and manifest for a resume
+void cancelFileTransfer();    // Discard the data and manifest
 uint32_t getFileChecksum();
 
 #endif
@@ -0,0 +1,140 @@
+#ifndef BLE_PROTOCOL_H
+#define BLE_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ble_transport.h"
+#include "xfer_protocol.h"
+#include "device_state.h"
+
+/**
+ * Device side of the BLE protocol: the config, time sync, status, file and
+ * device-state characteristics' handlers, independent of the BLE stack and of storage.
+ * Writes arrive from the transport's task and are queued; the main loop
+ * handles them and stores data through BleProtocolOps.
+ * tools/ble_bench drives it over a simulated link on host.
+ */
+
+// Framed config upload on the config characteristic, for configs of any size
+// (a write starting with any other byte is a whole JSON document):
+//   BEGIN  10 | flags u8 | size u32 | crc u32   (size and CRC-32 of the document)
+//   DATA   11 | offset u32 | bytes              (offset into the bytes sent)
+//   COMMIT 12
+//   ABORT  13
+#define CONFIG_FRAME_BEGIN  0x10
+#define CONFIG_FRAME_DATA   0x11
+#define CONFIG_FRAME_COMMIT 0x12
+#define CONFIG_FRAME_ABORT  0x13
+#define CONFIG_FLAG_LZ4     0x01   // DATA carries an lz4_stream of the document
+#define CONFIG_FLAG_CBOR    0x02   // The document is CBOR (schedule_cbor.h), not JSON
+
+// A whole JSON document may end with this and 8 hex digits: the CRC-32 of the JSON before it
+#define CONFIG_CRC_TRAILER "\n#crc32:"
+
+// Image manifest sync on the file characteristic (image_store.h), beside the
+// xfer_protocol.h frames; replies are notified on the status characteristic:
+//   ENTRY  04 | seq u8 | sha256 [32] | name_len u8 | name  -> HAVE   82 | seq u8 | present u8
+//   COMMIT 05 | count u8                                 -> SYNCED 83 | ok u8 | missing u8 | removed u8
+// Missing blobs are uploaded with the file transfer, named by their hex SHA-256
+#define IMAGE_SYNC_OP_ENTRY  0x04
+#define IMAGE_SYNC_OP_COMMIT 0x05
+#define IMAGE_SYNC_OP_HAVE   0x82
+#define IMAGE_SYNC_OP_SYNCED 0x83
+#define IMAGE_SYNC_HASH_LEN  32
+#define IMAGE_SYNC_NAME_MAX  31
+
+#define BLE_PROTOCOL_FRAME_MAX 512           // Largest queued write (file and framed config)
+#define BLE_PROTOCOL_JSON_MAX 4096           // Largest config sent as one JSON write
+#define BLE_PROTOCOL_CONFIG_MAX (256 * 1024) // Largest framed config (decompressed)
+
+typedef enum {
+    STATUS_IDLE = 0,
+    STATUS_RECEIVING_JSON = 1,
+    STATUS_RECEIVING_FILE = 2,
+    STATUS_SUCCESS = 3,
+    STATUS_ERROR = 4,
+    STATUS_TRANSFER_COMPLETE = 5,
+    STATUS_PROCESSING_CONFIG = 6
+} BLEStatus;
+
+/**
+ * Storage and clock behind the handlers. All but time_sync are called from
+ * the main loop.
+ */
+typedef struct {
+    void* ctx;
+
+    // Config: written to a part file that replaces the live schedule once verified
+    bool (*config_open)(void* ctx, bool cbor);
+    bool (*config_write)(void* ctx, const uint8_t* data, size_t len);
+    void (*config_close)(void* ctx, bool keep);                     // keep false: also delete the part file
+    bool (*config_count_cbor)(void* ctx, size_t* events);           // Decode the closed CBOR part file
+    bool (*config_commit)(void* ctx, bool cbor, uint32_t size, uint32_t crc); // Check stored bytes, replace
+
+    // Time sync (called from the transport's task)
+    void (*time_sync)(void* ctx, uint64_t unix_time);
+
+    // File transfer
+    bool (*file_open)(void* ctx, XferHeader* header, uint32_t* stored);  // May lower chunk; stored: bytes kept for a resume
+    bool (*file_write)(void* ctx, const uint8_t* data, size_t len);
+    bool (*file_finish)(void* ctx);                // All data received: verify and put in place
+    void (*file_close)(void* ctx, XferEnd how);    // Cancelled (discard) or suspended (keep)
+
+    // Image manifest sync
+    bool (*image_entry)(void* ctx, uint8_t seq, const uint8_t* hash, const char* name, bool* present);
+    bool (*image_commit)(void* ctx, uint8_t count, uint8_t* missing, uint8_t* removed);
+} BleProtocolOps;
+
+/**
+ * Allocate the queues and reset all state
+ * @return false if the buffers cannot be allocated
+ */
+bool ble_protocol_init(const BleTransport* transport, const BleProtocolOps* ops);
+
+/**
+ * A write from the phone (transport's task)
+ */
+void ble_protocol_write(BleChannel channel, const uint8_t* data, size_t len);
+
+/**
+ * A read is about to be answered (transport's task); may set the value
+ */
+void ble_protocol_read(BleChannel channel);
+
+/**
+ * Link up or down; a dropped link suspends the file transfer and fails a
+ * framed config upload
+ */
+void ble_protocol_link(bool connected);
+
+bool ble_protocol_connected();
+
+/**
+ * Handle queued config writes (main loop)
+ */
+void ble_protocol_process_config();
+
+/**
+ * Handle queued file frames and send the idle SACK when due (main loop)
+ */
+void ble_protocol_process_file(uint32_t now_ms);
+
+/**
+ * Set the status characteristic to "<status>:<message>" and notify it
+ */
+void ble_protocol_status(BLEStatus status, const char* message);
+
+/**
+ * Sample of the device state (main loop). Fills in the file transfer's
+ * progress, keeps the characteristic's value current and notifies it when
+ * device_state_publish() says so.
+ */
+void ble_protocol_device_state(DeviceState* state, uint32_t now_ms);
+
+/**
+ * Set a characteristic's value and notify it
+ */
+bool ble_protocol_send(BleChannel channel, const uint8_t* data, size_t len);
+
+#endif /* BLE_PROTOCOL_H */
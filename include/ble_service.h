@@ -6,6 +6,7 @@
 #include <BLEServer.h>
 #include <BLEUtils.h>
 #include <BLE2902.h>
+#include "ble_protocol.h"   // Frame formats and BLEStatus
 
 // BLE UUIDs - Custom service for CrockerDisplay
 #define SERVICE_UUID           "550e8400-e29b-41d4-a716-446655440000"
@@ -13,26 +14,20 @@
 #define FILE_TRANSFER_CHAR_UUID "550e8400-e29b-41d4-a716-446655440002"
 #define STATUS_CHAR_UUID       "550e8400-e29b-41d4-a716-446655440003"
 #define TIME_SYNC_CHAR_UUID    "550e8400-e29b-41d4-a716-446655440004"
+#define DEVICE_STATE_CHAR_UUID "550e8400-e29b-41d4-a716-446655440005"
+
+#define DEVICE_STATE_SAMPLE_MS 250   // Device state sampling; notifications are rate limited separately
 
 // BLE MTU size (typically 512 bytes, minus overhead leaves ~480 for payload)
 #define BLE_FILE_CHUNK_SIZE 480
 
-typedef enum {
-    STATUS_IDLE = 0,
-    STATUS_RECEIVING_JSON = 1,
-    STATUS_RECEIVING_FILE = 2,
-    STATUS_SUCCESS = 3,
-    STATUS_ERROR = 4,
-    STATUS_TRANSFER_COMPLETE = 5,
-    STATUS_PROCESSING_CONFIG = 6
-} BLEStatus;
-
 // Main BLE functions
 void initBLEService();
 void updateBLEStatus(BLEStatus status, const char* message = nullptr);
 void sendConfigOverBLE(const char* jsonData);
 void processBLEConfig();    // Call from main loop to process JSON config (safe with full stack)
 void processBLEFileData();  // Call from main loop to process file transfers
+void updateBLEDeviceState();  // Call from main loop to sample the device state characteristic
 void checkAndSyncScheduleIfNeeded();  // Call from main loop to check for 2 AM sync
 bool isBLEConnected();
 
@@ -0,0 +1,31 @@
+#ifndef BLE_TRANSPORT_H
+#define BLE_TRANSPORT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * The link the BLE protocol (ble_protocol.h) runs over: the Bluedroid GATT
+ * server on the device, a simulated link (tools/ble_bench/ble_loopback.h) on host.
+ * Writes from the phone go the other way, into ble_protocol_write().
+ */
+
+// One per characteristic of the service
+typedef enum {
+    BLE_CHANNEL_CONFIG,
+    BLE_CHANNEL_FILE,
+    BLE_CHANNEL_STATUS,
+    BLE_CHANNEL_TIME_SYNC,
+    BLE_CHANNEL_DEVICE_STATE,
+    BLE_CHANNEL_COUNT
+} BleChannel;
+
+typedef struct {
+    void* ctx;
+    bool (*notify)(void* ctx, BleChannel channel, const uint8_t* data, size_t len);    // Set the value and notify; false if not sent
+    void (*set_value)(void* ctx, BleChannel channel, const uint8_t* data, size_t len); // Value the next read returns
+    uint16_t (*mtu)(void* ctx);                                                        // ATT MTU of the link, 0 if unknown
+} BleTransport;
+
+#endif /* BLE_TRANSPORT_H */
@@ -0,0 +1,50 @@
+#ifndef BLEND_KERNELS_H
+#define BLEND_KERNELS_H
+
+#include <stdint.h>
+
+/**
+ * RGB565 fill, blend and copy kernels plugged into LVGL's software renderer
+ * through LV_DRAW_SW_ASM_CUSTOM (see lv_blend_custom.h). They follow LVGL's
+ * own loops (lv_color_16_16_mix()) but have not yet been checked against
+ * them: tools/blend_bench does that once built against the pinned LVGL.
+ * Until it passes, set LV_USE_DRAW_SW_ASM to LV_DRAW_SW_ASM_NONE if
+ * blended edges look wrong.
+ *
+ * Written with GCC/Clang vector extensions, 4 pixels per step, where the
+ * compiler lowers them to SIMD; elsewhere (e.g. the ESP32-S3's GCC 8) a
+ * scalar version that writes two pixels per 32-bit store is used instead.
+ *
+ * Strides are in bytes. mix = opa when mask is NULL, the mask value when
+ * opa is 255, otherwise (mask * opa) >> 8, as in LVGL.
+ */
+
+#ifndef BLEND_KERNELS_VECTOR
+#if (defined(__SSE2__) || defined(__ARM_NEON)) && (defined(__clang__) || __GNUC__ >= 9)
+#define BLEND_KERNELS_VECTOR 1
+#else
+#define BLEND_KERNELS_VECTOR 0
+#endif
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void blend_rgb565_fill(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color);
+
+void blend_rgb565_fill_mix(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color,
+                           uint8_t opa, const uint8_t* mask, int32_t mask_stride);
+
+void blend_rgb565_copy(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride,
+                       const uint16_t* src, int32_t src_stride);
+
+void blend_rgb565_copy_mix(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride,
+                           const uint16_t* src, int32_t src_stride,
+                           uint8_t opa, const uint8_t* mask, int32_t mask_stride);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLEND_KERNELS_H */
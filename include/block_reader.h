@@ -0,0 +1,58 @@
+#ifndef BLOCK_READER_H
+#define BLOCK_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// SD cards transfer in 512-byte sectors; reads are aligned to this
+#define BLOCK_READER_SECTOR_SIZE 512U
+
+/**
+ * Positioned read from the underlying storage
+ * @return Bytes read, or negative on error
+ */
+typedef int32_t (*block_read_at_fn)(void* ctx, uint32_t offset, uint8_t* buf, uint32_t len);
+
+typedef struct {
+    uint32_t requested_bytes;  // Bytes asked for by the caller
+    uint32_t device_reads;     // Calls into the storage
+    uint32_t device_bytes;     // Bytes transferred from storage
+} BlockReaderStats;
+
+/**
+ * Sector-aligned read-ahead window over a file.
+ * Small reads are served from the window; reads larger than the window go
+ * straight to storage as a single aligned multi-sector transfer.
+ */
+typedef struct {
+    block_read_at_fn read_at;
+    void* ctx;
+    uint32_t file_size;
+    uint32_t pos;
+    uint8_t* window;         // Caller-provided, window_size bytes
+    uint32_t window_size;    // Multiple of BLOCK_READER_SECTOR_SIZE
+    uint32_t window_offset;  // File offset of window[0] (sector aligned)
+    uint32_t window_len;     // Valid bytes in window
+    BlockReaderStats* stats; // Optional shared counters
+} BlockReader;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void block_reader_init(BlockReader* r, block_read_at_fn read_at, void* ctx, uint32_t file_size,
+                       uint8_t* window, uint32_t window_size, BlockReaderStats* stats);
+
+/**
+ * Read up to len bytes at the current position
+ * @return Bytes read (0 at end of file), or negative on storage error
+ */
+int32_t block_reader_read(BlockReader* r, void* out, uint32_t len);
+
+void block_reader_seek(BlockReader* r, uint32_t pos);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_READER_H */
@@ -0,0 +1,16 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Incremental CRC-32 (IEEE 802.3 / zlib). Start with crc = 0 and feed the
+ * previous result back in: crc32_update(crc32_update(0, a, n), b, m) equals
+ * the CRC of a followed by b.
+ * Uses the ROM routine on the ESP32 and slice-by-4 tables elsewhere, so it
+ * can be built on host.
+ */
+uint32_t crc32_update(uint32_t crc, const void* data, size_t len);
+
+#endif
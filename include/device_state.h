@@ -0,0 +1,78 @@
+#ifndef DEVICE_STATE_H
+#define DEVICE_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Device state record for the device-state characteristic: everything the
+ * phone would otherwise poll for, in one read or notification. A sample is
+ * notified only when it differs from the last one sent, at most once per
+ * DEVICE_STATE_MIN_INTERVAL_MS; the countdown running down on schedule is
+ * not a change.
+ * tools/ble_bench decodes the notifications on its simulated phone.
+ */
+
+// Record, little-endian:
+//   version u8 | flags u8 | schedule generation u32 | current u8 | next u8 |
+//   seconds remaining u32 | battery u8 | transfer u8
+#define DEVICE_STATE_VERSION 1
+#define DEVICE_STATE_LEN 14
+#define DEVICE_STATE_NONE 0xFF                   // No event, battery not sampled, or no transfer
+
+#define DEVICE_STATE_FLAG_TIME_VALID   0x01      // Clock synced from the phone
+#define DEVICE_STATE_FLAG_EVENT_ACTIVE 0x02      // Seconds remaining count down the current event, else to the next
+#define DEVICE_STATE_FLAG_TRANSFERRING 0x04      // A file transfer is in progress
+
+#define DEVICE_STATE_MIN_INTERVAL_MS 1000        // Between notifications
+#define DEVICE_STATE_DRIFT_S 2                   // Countdown error tolerated before it counts as a change
+
+typedef struct {
+    uint8_t flags;
+    uint32_t schedule_generation;  // Changes whenever the loaded schedule does
+    uint8_t current_event;         // Index into the day's events by start time
+    uint8_t next_event;
+    uint32_t seconds_remaining;    // 0 when there is neither a current nor a next event
+    uint8_t battery;               // Percent
+    uint8_t transfer;              // Percent of the file received
+} DeviceState;
+
+typedef struct {
+    DeviceState sent;
+    uint32_t sent_ms;
+    bool has_sent;
+} DeviceStatePublisher;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @param out DEVICE_STATE_LEN bytes
+ * @return DEVICE_STATE_LEN
+ */
+size_t device_state_encode(const DeviceState* state, uint8_t* out);
+
+/**
+ * @return false if the record is short or of another version
+ */
+bool device_state_decode(const uint8_t* data, size_t len, DeviceState* state);
+
+/**
+ * Forget the last record sent, so the next sample is notified (new connection)
+ */
+void device_state_reset(DeviceStatePublisher* pub);
+
+/**
+ * Decide whether to notify a sample; a change held back by the rate limit
+ * is still a change at the next sample
+ * @return true if the sample should be sent now (it becomes the last sent)
+ */
+bool device_state_publish(DeviceStatePublisher* pub, const DeviceState* state, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DEVICE_STATE_H */
@@ -0,0 +1,36 @@
+#ifndef DIGIT_ATLAS_H
+#define DIGIT_ATLAS_H
+
+#include <lvgl.h>
+
+// Characters held by an atlas; anything else falls back to the font engine
+#define DIGIT_ATLAS_CHARS "0123456789: "
+#define DIGIT_ATLAS_CHAR_COUNT 12
+
+// Fonts that can have an atlas (countdown 48 pt, clock 32 pt)
+#ifndef DIGIT_ATLAS_MAX_FONTS
+#define DIGIT_ATLAS_MAX_FONTS 2
+#endif
+
+/**
+ * Rasterise DIGIT_ATLAS_CHARS of a font once into A8 bitmaps (with the font's
+ * kerning between them). Idempotent per font.
+ * @return false if out of memory or the font lacks a glyph
+ */
+bool digit_atlas_build(const lv_font_t* font);
+
+/**
+ * Draw the label's text by blitting atlas glyphs (A8 + recolor) instead of the
+ * generic glyph path. The label's draw task is intercepted on
+ * LV_EVENT_DRAW_TASK_ADDED; text the atlas cannot lay out exactly (other
+ * characters, multiple lines, selection, decoration, recolor) is left to LVGL.
+ * Safe to call with NULL.
+ */
+void digit_atlas_attach(lv_obj_t* label);
+
+/**
+ * Log atlas blits vs fallbacks since the last call, then reset
+ */
+void digit_atlas_log_stats();
+
+#endif
@@ -37,19 +37,48 @@ extern struct DisplayState display_state;
  */
 void display_state_init();
 
+// ============ TIMER ARC ============
+// Arc value range (0.1 degree steps, under half a pixel on a 240 px radius)
+#define TIMER_ARC_RANGE 3600
+// Frame rate while the arc moves faster than this; slower arcs step once per pixel
+#define TIMER_ARC_FPS 30
+// Radius of the timer arcs, used to convert progress to pixels moved
+#define TIMER_ARC_RADIUS_PX 240
+// update_timer() only resyncs the end time when it drifts by more than this
+#define TIMER_ARC_RESYNC_MS 50
+
 /**
- * Update timer value and automatically update UI
+ * Update timer value. The arc is then animated from the resulting end time
+ * by an LVGL timer, independent of how often this is called.
  * @param milliseconds Current timer value in milliseconds
  * @param max_milliseconds Maximum timer value for arc calculation
  */
 void update_timer(uint32_t milliseconds, uint32_t max_milliseconds);
 
+/**
+ * Timer arc position right now
+ * @return Time remaining, 0..TIMER_ARC_RANGE
+ */
+uint16_t get_timer_arc_value();
+
+/**
+ * Show the current timer progress on an lv_arc (sets its range on first use).
+ * lv_arc invalidates only the sector between the old and new angle.
+ */
+void apply_timer_arc(lv_obj_t* arc);
+
 /**
  * Update brightness value and apply to display
  * @param value Brightness value (0-255)
  */
 void update_brightness(uint8_t value);
 
+/**
+ * Brightness for a Screen 3 slider position, as update_brightness() applies it
+ * @param slider_value Slider position (0-100)
+ */
+uint8_t brightness_from_slider(int32_t slider_value);
+
 /**
  * Update event text label
  * @param text New text for event label
@@ -62,6 +91,12 @@ void update_event_text(const char* text);
  */
 void update_time_text(const char* text);
 
+/**
+ * Set a label's text only if it differs from what is shown, so per-loop
+ * updates with the same text do not invalidate the label
+ */
+void update_label_text(lv_obj_t* label, const char* text);
+
 /**
  * Update background image from SD card
  * @param image_path Path to image on SD card (e.g., "/sd/display/bg.png")
@@ -0,0 +1,82 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Default byte budget for decoded images (allocated from PSRAM on the device)
+// Override with -DIMAGE_CACHE_BUDGET_BYTES=... in platformio.ini build_flags
+#ifndef IMAGE_CACHE_BUDGET_BYTES
+#define IMAGE_CACHE_BUDGET_BYTES (2U * 1024U * 1024U)
+#endif
+
+#define IMAGE_CACHE_MAX_ENTRIES 16
+#define IMAGE_CACHE_PATH_LEN 96
+
+/* Counters exposed for diagnostics */
+typedef struct {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t insert_failures;
+    size_t bytes_used;
+    size_t budget_bytes;
+    uint8_t entries;
+} ImageCacheStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * LRU cache of decoded image buffers, keyed by path + file generation.
+ * tools/cache_check checks it against a reference model on host.
+ *
+ * Buffers returned by lookup/insert are pinned: they are never evicted until
+ * image_cache_release() is called for every lookup/insert that returned them.
+ */
+
+void image_cache_init(size_t budget_bytes);
+void image_cache_set_budget(size_t budget_bytes);
+
+/**
+ * Find a cached buffer for path/generation. Counts a hit or miss.
+ * @return Pinned buffer, or NULL on miss
+ */
+void* image_cache_lookup(const char* path, uint32_t generation, size_t* out_size);
+
+/**
+ * Allocate a new buffer for path/generation, evicting least recently used
+ * unpinned entries until it fits the budget. Older generations of the same
+ * path are dropped.
+ * @return Pinned buffer for the caller to fill, or NULL if it cannot fit
+ */
+void* image_cache_insert(const char* path, uint32_t generation, size_t size);
+
+/**
+ * Unpin a buffer returned by lookup/insert
+ */
+void image_cache_release(const void* data);
+
+/**
+ * Unpin and drop a buffer (e.g. the caller failed to fill it)
+ */
+void image_cache_discard(const void* data);
+
+/**
+ * Drop all generations of a path (freed once unpinned)
+ */
+void image_cache_invalidate(const char* path);
+
+/**
+ * Drop every unpinned entry
+ */
+void image_cache_clear(void);
+
+void image_cache_get_stats(ImageCacheStats* out_stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMAGE_CACHE_H */
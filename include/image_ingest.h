@@ -0,0 +1,61 @@
+#ifndef IMAGE_INGEST_H
+#define IMAGE_INGEST_H
+
+#include <Arduino.h>
+
+// Output size of transcoded images (full-screen background)
+#define IMAGE_INGEST_TARGET_W 480
+#define IMAGE_INGEST_TARGET_H 480
+
+// Set to 0 (-DIMAGE_INGEST_RLE=0) to always store raw RGB565
+#ifndef IMAGE_INGEST_RLE
+#define IMAGE_INGEST_RLE 1
+#endif
+
+// Transcoded images live here as <name>.bin, extension kept ("breakfast.png.bin")
+#define IMAGE_INGEST_DIR "/lvgl_images"
+
+// Conversions run on their own task so the loop never waits for a decode
+#define IMAGE_INGEST_QUEUE 4               // Sources waiting to be converted
+#define IMAGE_INGEST_FAILED_MAX 8          // Unconvertible sources remembered, oldest forgotten first
+#define IMAGE_INGEST_TASK_STACK 8192
+#define IMAGE_INGEST_TASK_PRIORITY 1
+#define IMAGE_INGEST_TASK_CORE 0           // The Arduino loop runs on core 1
+
+/**
+ * Convert a PNG or BMP on the SD card into a display-native RGB565 .bin.
+ * Blocks for the whole decode; the ingest task calls it.
+ * @param src_path Source image (e.g. "/lvgl_images/breakfast.png" or "/sdcard/breakfast.png")
+ * @return true if a .bin was written (false for unsupported or already-LVGL files)
+ */
+bool image_ingest_convert(const char* src_path);
+
+/**
+ * Queue a conversion on the ingest task. For new uploads: a source that
+ * failed before is tried again.
+ * @return false if the queue is full
+ */
+bool image_ingest_request(const char* src_path);
+
+/**
+ * Map an image path to its transcoded .bin. Never converts: a missing or
+ * stale .bin is queued on the ingest task and the caller shows the source
+ * until image_ingest_generation() changes. An image packed in the mounted
+ * asset bundle maps to its ASSET_BUNDLE_PREFIX path; a file name bound in
+ * the image store maps to its blob's .bin.
+ * @return true if out holds a transcoded .bin path, false to use path as-is
+ */
+bool image_ingest_resolve(const char* path, char* out, size_t out_len);
+
+/**
+ * Whether a conversion is queued or running
+ */
+bool image_ingest_busy();
+
+/**
+ * Changes whenever a conversion finishes, so callers showing a source can
+ * resolve it again
+ */
+uint32_t image_ingest_generation();
+
+#endif
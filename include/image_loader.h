@@ -0,0 +1,68 @@
+#ifndef IMAGE_LOADER_H
+#define IMAGE_LOADER_H
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "FS.h"
+
+/**
+ * Loads LVGL binary images (.bin) from the SD card into the PSRAM image cache
+ * and hands them to LVGL as in-memory image descriptors, so an image shown
+ * repeatedly during the day is only read from the card once per file version.
+ * RLE-compressed binaries (written by image_ingest) are decoded into the cache.
+ */
+
+/* Incremental load of one image into the cache (used by the prefetcher) */
+struct ImageLoadJob {
+    File file;
+    uint8_t* blob;          // Pinned cache buffer, descriptor at the start
+    uint8_t* packed;        // RLE payload staging buffer (compressed images only)
+    size_t data_size;       // Decoded pixel bytes
+    size_t read_size;       // Bytes to read from the file (packed size if compressed)
+    size_t loaded;
+    uint32_t start_us;
+    char path[96];
+};
+
+/**
+ * Start loading path into the cache
+ * @return true if the job has work to do or the image is already cached
+ *         (job.blob set and job.loaded == job.data_size), false if unloadable
+ */
+bool image_loader_job_begin(ImageLoadJob& job, const char* path);
+
+/**
+ * Read up to max_bytes of the image
+ * @return 1 when complete, 0 while in progress, -1 on failure (job released)
+ */
+int image_loader_job_step(ImageLoadJob& job, size_t max_bytes);
+
+/**
+ * Abandon a job, dropping any partially loaded buffer
+ */
+void image_loader_job_cancel(ImageLoadJob& job);
+
+/**
+ * Get a displayable descriptor for an SD card image, loading it on a cache miss
+ * @param path Image path (e.g. "/lvgl_images/breakfast.bin" or "/sdcard/...")
+ * @return Pinned descriptor, or NULL if the file is not a loadable LVGL binary
+ */
+const lv_image_dsc_t* image_loader_acquire(const char* path);
+
+/**
+ * Unpin a descriptor returned by image_loader_acquire() once it is no longer shown
+ */
+void image_loader_release(const lv_image_dsc_t* dsc);
+
+/**
+ * File generation used as the cache key (changes whenever the file is rewritten)
+ * @return 0 if the file does not exist
+ */
+uint32_t image_loader_file_generation(const char* path);
+
+/**
+ * Print cache hit/miss/eviction counters to Serial
+ */
+void image_loader_log_stats();
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef IMAGE_PREFETCH_H
+#define IMAGE_PREFETCH_H
+
+#include <Arduino.h>
+
+// Set to 0 (-DIMAGE_PREFETCH_ENABLED=0) to measure event-boundary latency without prefetch
+#ifndef IMAGE_PREFETCH_ENABLED
+#define IMAGE_PREFETCH_ENABLED 1
+#endif
+
+// How long before the next event starts its image is loaded into the cache
+#ifndef IMAGE_PREFETCH_LEAD_TIME_S
+#define IMAGE_PREFETCH_LEAD_TIME_S 30
+#endif
+
+// Bytes read from the SD card per loop iteration while prefetching
+#define IMAGE_PREFETCH_STEP_BYTES (16 * 1024)
+
+/**
+ * Initialize the prefetcher (call after LVGL and the image cache are up)
+ */
+void image_prefetch_init();
+
+/**
+ * Advance the prefetcher - call from the main loop
+ * Loads the upcoming event's image in small steps so the loop never stalls,
+ * and keeps it pinned in the cache until the event starts.
+ */
+void image_prefetch_tick();
+
+void image_prefetch_set_enabled(bool enabled);
+void image_prefetch_set_lead_time(uint32_t seconds);
+
+/**
+ * Check whether path has been fully prefetched
+ */
+bool image_prefetch_is_ready(const char* path);
+
+/**
+ * Record an event-boundary image switch (call from the FSM when an event
+ * starts, with the event's schedule path); the latency until the next frame
+ * is rendered is logged together with whether the image was prefetched
+ */
+void image_prefetch_mark_boundary(const char* path);
+
+#endif
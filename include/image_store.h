@@ -0,0 +1,65 @@
+#ifndef IMAGE_STORE_H
+#define IMAGE_STORE_H
+
+#include <Arduino.h>
+
+/**
+ * Content-addressed image store. Images the phone uploads under their SHA-256
+ * (64 lowercase hex digits as the transfer name) are kept once, as
+ * IMAGE_STORE_BLOB_DIR/<hex>, and the index maps the names the schedule uses
+ * ("breakfast.png") to them. The phone syncs by sending its manifest of
+ * name -> hash; the device reports which blobs it lacks, the phone uploads
+ * only those, and committing the manifest replaces the index and deletes
+ * blobs nothing refers to any more.
+ */
+
+#define IMAGE_STORE_BLOB_DIR "/lvgl_images/blobs"
+#define IMAGE_STORE_INDEX "/lvgl_images/index.txt"   // "<hex> <name>" per line
+#define IMAGE_STORE_MAX_ENTRIES 32
+#define IMAGE_STORE_NAME_MAX 31        // Names are file names, as in readConfig.path
+#define IMAGE_STORE_HASH_LEN 32
+#define IMAGE_STORE_HEX_LEN (IMAGE_STORE_HASH_LEN * 2)
+
+typedef struct {
+    uint8_t missing;         // Manifest entries without a stored blob (index unchanged)
+    uint8_t removed;         // Blobs deleted as unreferenced
+    bool changed;            // Some name now refers to a different image
+} ImageStoreSyncResult;
+
+/**
+ * True for a transfer name that is a blob hash (64 lowercase hex digits)
+ */
+bool image_store_is_blob_name(const char* name);
+
+/**
+ * Check a received blob's SHA-256 against the hash it was sent under
+ */
+bool image_store_verify_blob(const char* path, const char* hex);
+
+/**
+ * Map an image path ("/sdcard/breakfast.png") to the blob its file name is
+ * bound to
+ * @return false if the name is not in the index (use the path as before)
+ */
+bool image_store_resolve(const char* path, char* out, size_t out_len);
+
+/**
+ * Drop the binding of a name (a plain upload of that name replaces it)
+ */
+void image_store_forget(const char* name);
+
+/**
+ * Record one manifest entry; seq 0 starts a new manifest
+ * @param present Set when the blob is already stored
+ * @return false for an out-of-sequence or invalid entry
+ */
+bool image_store_sync_entry(uint8_t seq, const uint8_t* hash, const char* name, bool* present);
+
+/**
+ * Install the manifest of `count` entries as the index and collect garbage,
+ * if every blob it names is stored
+ * @return false if the manifest is incomplete or blobs are missing
+ */
+bool image_store_sync_commit(uint8_t count, ImageStoreSyncResult* result);
+
+#endif
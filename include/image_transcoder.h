@@ -0,0 +1,99 @@
+#ifndef IMAGE_TRANSCODER_H
+#define IMAGE_TRANSCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Converts PNG/BMP images into LVGL v9 RGB565 binaries (.bin) scaled to the
+ * display size, optionally RLE compressed. Pure C++ (no Arduino/LVGL
+ * dependencies) so it can be built and timed on host; the inflate step for
+ * PNG is supplied by the caller.
+ */
+
+// Largest .bin header (image header + compression header)
+#define TRANSCODE_BIN_HEADER_MAX 24
+
+// Values from LVGL's lv_image_header_t / lv_image_compress_t
+#define TRANSCODE_LV_MAGIC          0x19
+#define TRANSCODE_LV_CF_RGB565      0x12
+#define TRANSCODE_LV_FLAG_COMPRESSED 0x0008
+#define TRANSCODE_LV_COMPRESS_RLE   1
+
+typedef enum {
+    TRANSCODE_FMT_GRAY8,
+    TRANSCODE_FMT_GRAYA8,
+    TRANSCODE_FMT_RGB888,
+    TRANSCODE_FMT_RGBA8888,
+    TRANSCODE_FMT_PALETTE8,
+    TRANSCODE_FMT_BGR888,    // BMP 24-bit
+    TRANSCODE_FMT_BGRA8888,  // BMP 32-bit
+} TranscodeFormat;
+
+/* Decoded pixels, read in place from the source buffer */
+typedef struct {
+    const uint8_t* data;     // First (top) row
+    int32_t stride;          // Bytes between rows (negative for bottom-up BMPs)
+    uint32_t w;
+    uint32_t h;
+    TranscodeFormat format;
+    uint8_t palette[256 * 4]; // RGBA, PALETTE8 only
+} TranscodeSource;
+
+/**
+ * Decompress a zlib stream
+ * @return Bytes written to out (must equal out_len on success)
+ */
+typedef size_t (*transcoder_inflate_fn)(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_len);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parse an uncompressed 24/32-bit BMP; pixels are read directly from file
+ */
+bool transcoder_parse_bmp(const uint8_t* file, size_t len, TranscodeSource* src);
+
+/**
+ * Size of the raw buffer transcoder_decode_png() needs
+ * @return 0 if the file is not a supported PNG (8-bit depth, non-interlaced)
+ */
+size_t transcoder_png_raw_size(const uint8_t* file, size_t len, uint32_t* w, uint32_t* h);
+
+/**
+ * Decode a PNG into raw (raw_size bytes from transcoder_png_raw_size)
+ * file is modified: the image data chunks are compacted to its start.
+ */
+bool transcoder_decode_png(uint8_t* file, size_t len, uint8_t* raw, size_t raw_size,
+                           transcoder_inflate_fn inflate, TranscodeSource* src);
+
+/**
+ * Scale to dst_w x dst_h RGB565, covering the target and cropping the centre
+ * Downscaling averages each source box; alpha is composited over black.
+ */
+bool transcoder_scale_to_rgb565(const TranscodeSource* src, uint16_t* dst, uint32_t dst_w, uint32_t dst_h);
+
+/**
+ * LVGL RLE: control byte with bit 7 set = N literal blocks, clear = 1 block repeated N times
+ * @return Encoded size, or 0 if it does not fit in out_cap
+ */
+size_t transcoder_rle_encode(const uint8_t* in, size_t len, uint8_t blk, uint8_t* out, size_t out_cap);
+
+/**
+ * @return Decoded size, or 0 on malformed input
+ */
+size_t transcoder_rle_decode(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_cap, uint8_t blk);
+
+/**
+ * Write the .bin header for a w x h RGB565 image
+ * @param rle_size Compressed payload size, or 0 for uncompressed
+ * @return Header size in bytes
+ */
+size_t transcoder_write_bin_header(uint8_t* out, uint32_t w, uint32_t h, size_t rle_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* IMAGE_TRANSCODER_H */
@@ -0,0 +1,56 @@
+#ifndef JSON_EVENT_STREAM_H
+#define JSON_EVENT_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Incremental splitter for the schedule JSON: finds the "events" array and
+ * hands each of its objects, as text, to a callback. Input may arrive in
+ * pieces of any size, so a config of any length is parsed with one object's
+ * worth of memory. Objects longer than JSON_EVENT_OBJECT_MAX - 1 are truncated.
+ * tools/schedule_bench and tools/lz4_check run it on host.
+ */
+
+#define JSON_EVENT_OBJECT_MAX 256
+
+/**
+ * Receives one "{...}" object (NUL-terminated); return false to stop
+ */
+typedef bool (*JsonEventFn)(void* ctx, const char* object, size_t len);
+
+typedef struct {
+    JsonEventFn fn;
+    void* ctx;
+    uint8_t state;
+    uint8_t key_pos;         // Characters of "\"events\"" matched so far
+    uint16_t depth;
+    bool in_string;
+    bool escape;
+    size_t obj_len;
+    uint32_t objects;        // Objects handed to fn
+    char obj[JSON_EVENT_OBJECT_MAX];
+} JsonEventStream;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void json_event_stream_init(JsonEventStream* s, JsonEventFn fn, void* ctx);
+
+/**
+ * @return false once the callback has stopped the stream
+ */
+bool json_event_stream_feed(JsonEventStream* s, const char* data, size_t len);
+
+/**
+ * True once the closing ']' of the events array has been seen
+ */
+bool json_event_stream_done(const JsonEventStream* s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JSON_EVENT_STREAM_H */
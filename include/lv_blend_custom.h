@@ -0,0 +1,37 @@
+#ifndef LV_BLEND_CUSTOM_H
+#define LV_BLEND_CUSTOM_H
+
+/**
+ * LV_DRAW_SW_ASM_CUSTOM_INCLUDE: route LVGL's RGB565 colour fills and
+ * RGB565 image blends (normal blend mode) to blend_kernels. Included by
+ * LVGL's blend sources; every other format keeps the stock loops.
+ */
+
+#include "blend_kernels.h"
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc) \
+    (blend_rgb565_fill((uint16_t*)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                       lv_color_to_u16((dsc)->color)), LV_RESULT_OK)
+
+#define LV_BLEND_CUSTOM_FILL_MIX(dsc, opa, mask) \
+    (blend_rgb565_fill_mix((uint16_t*)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                           lv_color_to_u16((dsc)->color), (opa), (mask), (dsc)->mask_stride), LV_RESULT_OK)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc)     LV_BLEND_CUSTOM_FILL_MIX(dsc, (dsc)->opa, NULL)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc)    LV_BLEND_CUSTOM_FILL_MIX(dsc, 255, (dsc)->mask_buf)
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc) LV_BLEND_CUSTOM_FILL_MIX(dsc, (dsc)->opa, (dsc)->mask_buf)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc) \
+    (blend_rgb565_copy((uint16_t*)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                       (const uint16_t*)(dsc)->src_buf, (dsc)->src_stride), LV_RESULT_OK)
+
+#define LV_BLEND_CUSTOM_COPY_MIX(dsc, opa, mask) \
+    (blend_rgb565_copy_mix((uint16_t*)(dsc)->dest_buf, (dsc)->dest_w, (dsc)->dest_h, (dsc)->dest_stride, \
+                           (const uint16_t*)(dsc)->src_buf, (dsc)->src_stride, \
+                           (opa), (mask), (dsc)->mask_stride), LV_RESULT_OK)
+
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc)     LV_BLEND_CUSTOM_COPY_MIX(dsc, (dsc)->opa, NULL)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc)    LV_BLEND_CUSTOM_COPY_MIX(dsc, 255, (dsc)->mask_buf)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc) LV_BLEND_CUSTOM_COPY_MIX(dsc, (dsc)->opa, (dsc)->mask_buf)
+
+#endif
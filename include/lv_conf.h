@@ -182,10 +182,13 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    /* Overridable so the host benches can build the stock loops (-DLV_USE_DRAW_SW_ASM=LV_DRAW_SW_ASM_NONE) */
+    #ifndef LV_USE_DRAW_SW_ASM
+        #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_CUSTOM
+    #endif
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
-        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
+        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE "lv_blend_custom.h"
     #endif
 
     /* Enable drawing complex gradients in software: linear at an angle, radial or conical */
@@ -708,7 +711,7 @@
 /*File system interfaces for common APIs */
 
 /*Setting a default driver letter allows skipping the driver prefix in filepaths*/
-#define LV_FS_DEFAULT_DRIVER_LETTER '\0'
+#define LV_FS_DEFAULT_DRIVER_LETTER 'S'   /*SD card drive registered by lv_fs_sd_init()*/
 
 /*API for fopen, fread, etc*/
 #define LV_USE_FS_STDIO 0
@@ -794,7 +797,7 @@
 #define LV_BIN_DECODER_RAM_LOAD 0
 
 /*RLE decompress library*/
-#define LV_USE_RLE 0
+#define LV_USE_RLE 1
 
 /*QR code library*/
 #define LV_USE_QRCODE 0
@@ -853,7 +856,7 @@
  *==================*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable system monitor component*/
 #define LV_USE_SYSMON   0
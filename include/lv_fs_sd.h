@@ -0,0 +1,32 @@
+#ifndef LV_FS_SD_H
+#define LV_FS_SD_H
+
+#include <lvgl.h>
+#include "block_reader.h"
+
+// Drive letter; also set as LV_FS_DEFAULT_DRIVER_LETTER so "/sdcard/x.png" works unprefixed
+#define LV_FS_SD_LETTER 'S'
+
+// Files LVGL may hold open at once (image decoder + font/bin loaders)
+#define LV_FS_SD_MAX_HANDLES 4
+
+// Read-ahead window per handle (multiple of 512-byte sectors)
+#ifndef LV_FS_SD_WINDOW_SIZE
+#define LV_FS_SD_WINDOW_SIZE (32 * 1024)
+#endif
+
+// Host builds read from this directory in place of the SD card mount
+#ifndef LV_FS_SD_HOST_ROOT
+#define LV_FS_SD_HOST_ROOT "./sdcard"
+#endif
+
+/**
+ * Register the SD card drive with LVGL (call after lv_init and the SD mount)
+ * On device files come from SD_MMC; on host builds from POSIX files under LV_FS_SD_HOST_ROOT.
+ */
+void lv_fs_sd_init();
+
+void lv_fs_sd_get_stats(BlockReaderStats* out);
+void lv_fs_sd_log_stats();
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef LZ4_STREAM_H
+#define LZ4_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Streaming decoder for a sequence of independent LZ4 blocks:
+ *   [comp_len u16][raw_len u16][comp_len bytes] ...
+ * Each block is a raw LZ4 block (LZ4_compress_default() on at most
+ * LZ4_STREAM_BLOCK_MAX input bytes); comp_len with LZ4_STREAM_STORED set
+ * holds the raw bytes as they are. Blocks never reference earlier ones, so
+ * the decoder needs one block of input and one of output however long the
+ * stream is. Input may be fed in pieces of any size.
+ * tools/lz4_check feeds it split and corrupted streams on host.
+ */
+
+#define LZ4_STREAM_BLOCK_MAX 4096
+#define LZ4_STREAM_STORED 0x8000u
+
+/**
+ * Receives each decoded block; return false to stop
+ */
+typedef bool (*Lz4StreamOutputFn)(void* ctx, const uint8_t* data, size_t len);
+
+typedef struct {
+    Lz4StreamOutputFn out;
+    void* ctx;
+    uint8_t header[4];
+    uint8_t header_len;
+    uint16_t comp_len;       // Bytes of the current block (without the stored flag)
+    uint16_t raw_len;
+    bool stored;
+    uint16_t have;           // Bytes of the current block received
+    bool failed;
+    uint8_t in[LZ4_STREAM_BLOCK_MAX];
+    uint8_t raw[LZ4_STREAM_BLOCK_MAX];
+} Lz4Stream;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void lz4_stream_init(Lz4Stream* s, Lz4StreamOutputFn out, void* ctx);
+
+/**
+ * @return false on corrupt input or when the output callback stopped
+ */
+bool lz4_stream_feed(Lz4Stream* s, const uint8_t* data, size_t len);
+
+/**
+ * True when the input ended exactly on a block boundary
+ */
+bool lz4_stream_complete(const Lz4Stream* s);
+
+/**
+ * Decode one raw LZ4 block
+ * @return decoded length, or -1 if the block is corrupt or does not fit
+ */
+int lz4_decode_block(const uint8_t* src, size_t src_len, uint8_t* dst, size_t dst_cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LZ4_STREAM_H */
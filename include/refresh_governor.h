@@ -0,0 +1,59 @@
+#ifndef REFRESH_GOVERNOR_H
+#define REFRESH_GOVERNOR_H
+
+#include <lvgl.h>
+
+// Refresh period while only periodic labels change (clock, countdown)
+#ifndef REFRESH_GOVERNOR_IDLE_MS
+#define REFRESH_GOVERNOR_IDLE_MS 200
+#endif
+
+// Refresh period during touch, scrolling and animations
+#ifndef REFRESH_GOVERNOR_ACTIVE_MS
+#define REFRESH_GOVERNOR_ACTIVE_MS LV_DEF_REFR_PERIOD
+#endif
+
+// Activity-free time before dropping back to the idle period
+#ifndef REFRESH_GOVERNOR_QUIET_MS
+#define REFRESH_GOVERNOR_QUIET_MS 1500
+#endif
+
+// How often touch, scroll and animation state is polled
+#define REFRESH_GOVERNOR_POLL_MS 50
+
+typedef enum {
+    REFRESH_MODE_IDLE = 0,
+    REFRESH_MODE_ACTIVE,
+    REFRESH_MODE_COUNT
+} RefreshMode;
+
+/**
+ * Take over the display's refresh timer period. Starts idle; boosts while
+ * the pointer is pressed, an object scrolls or an animation runs.
+ */
+void refresh_governor_init(lv_display_t* disp, lv_indev_t* indev);
+
+/**
+ * Activity the governor cannot see (e.g. a fast-moving timer arc):
+ * switch to the active period now and restart the quiet period
+ */
+void refresh_governor_boost();
+
+/**
+ * Change the activity-free time before returning to idle
+ */
+void refresh_governor_set_quiet_ms(uint32_t ms);
+
+RefreshMode refresh_governor_get_mode();
+
+/**
+ * Current refresh period of the display in ms
+ */
+uint32_t refresh_governor_get_period();
+
+/**
+ * Log time spent in each mode and mode switches since the last call, then reset
+ */
+void refresh_governor_log_stats();
+
+#endif
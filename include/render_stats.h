@@ -0,0 +1,28 @@
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <lvgl.h>
+
+/**
+ * Time each refresh of the display (render + flush) via its
+ * LV_EVENT_REFR_START / LV_EVENT_REFR_READY events
+ */
+void render_stats_attach(lv_display_t* disp);
+
+/**
+ * Count an area sent to the panel (call from the display flush callback)
+ */
+void render_stats_add_flush(lv_display_t* disp, const lv_area_t* area);
+
+/**
+ * Count rendered pixels the flush did not copy (outside the round panel)
+ */
+void render_stats_add_skipped(uint32_t px);
+
+/**
+ * Log refreshes, their time and flushed pixels since the last call, then reset
+ * (called once a minute from the main loop)
+ */
+void render_stats_log();
+
+#endif
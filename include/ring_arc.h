@@ -0,0 +1,28 @@
+#ifndef RING_ARC_H
+#define RING_ARC_H
+
+#include <lvgl.h>
+
+// Distinct (radius, width) ring masks kept in PSRAM (~370 KB each at r=240)
+#ifndef RING_ARC_MAX_MASKS
+#define RING_ARC_MAX_MASKS 2
+#endif
+
+/**
+ * Draw the arc's indicator from a precomputed ring mask (ring_mask) instead of
+ * LVGL's generic arc renderer. The indicator's draw task is intercepted on
+ * LV_EVENT_DRAW_TASK_ADDED: its colour, opacity, angles and rounded ends are
+ * reused, the stock task is made transparent and an A8 image draw of the mask
+ * takes its place. Styles and themes are left untouched.
+ * Safe to call with NULL (screen not built yet).
+ */
+void ring_arc_attach(lv_obj_t* arc);
+
+/**
+ * lv_arc_set_value() with sub-degree precision. lv_arc keeps whole-degree
+ * angles and only invalidates when those change; attached arcs are drawn at
+ * the exact value, so this also invalidates the small sector each end moved.
+ */
+void ring_arc_set_value(lv_obj_t* arc, int32_t value);
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef RING_MASK_H
+#define RING_MASK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Angles are in hundredths of a degree, clockwise from +x (screen y points down)
+#define RING_MASK_FULL_TURN 36000
+
+/**
+ * Pixels of one mask row that belong to the ring: [x0, hole0) and [hole1, x1).
+ * Rows that do not reach the inner circle have hole0 == hole1 == x1.
+ */
+typedef struct {
+    int16_t x0, hole0, hole1, x1;
+    uint32_t offset;         // Index of the row's first ring pixel in coverage/angle
+} RingMaskRow;
+
+/**
+ * Anti-aliased ring of outer radius `radius` and thickness `width`, precomputed
+ * once: per-pixel coverage and angle for the pixels inside the ring band.
+ * Rendering a progress arc is then an integer angle threshold per pixel,
+ * written into an A8 alpha buffer of size x size pixels (size = 2 * radius,
+ * centre on the pixel corner at (radius, radius), LVGL's arc geometry).
+ * Checked only against an analytic reference arc so far; tools/arc_bench
+ * diffs it against LVGL's own arc renderer, which has not been run yet.
+ */
+typedef struct {
+    uint16_t radius;
+    uint16_t width;
+    uint16_t size;
+    uint32_t pixel_count;    // Pixels in the ring band
+    RingMaskRow* rows;       // size entries
+    uint16_t* angle;         // pixel_count entries, 0..RING_MASK_FULL_TURN-1
+    uint8_t* coverage;       // pixel_count entries, 0..255
+    uint8_t* alpha;          // size * size, the rendered arc (A8)
+
+    // Arc currently in alpha
+    bool drawn_valid;
+    int32_t drawn_start;
+    int32_t drawn_end;
+    bool drawn_rounded;
+} RingMask;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bytes of storage ring_mask_init() needs for this geometry
+ */
+size_t ring_mask_buffer_size(uint16_t radius, uint16_t width);
+
+/**
+ * Precompute the ring into buf (ring_mask_buffer_size() bytes, 4-byte aligned)
+ */
+void ring_mask_init(RingMask* m, uint16_t radius, uint16_t width, void* buf);
+
+/**
+ * Render the arc from start to end (hundredths of a degree, clockwise, any range)
+ * into m->alpha. Flat ends are anti-aliased; rounded ends add LVGL-style caps.
+ * @return true if alpha changed, false if it already held this arc
+ */
+bool ring_mask_render(RingMask* m, int32_t start, int32_t end, bool rounded);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RING_MASK_H */
@@ -0,0 +1,67 @@
+#ifndef ROUND_CLIP_H
+#define ROUND_CLIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * Visible pixels of one row: [x0, x1). Empty when x0 >= x1.
+ */
+typedef struct {
+    int16_t x0, x1;
+} RoundClipSpan;
+
+/**
+ * Inclusive pixel rectangle (same convention as lv_area_t)
+ */
+typedef struct {
+    int32_t x1, y1, x2, y2;
+} RoundClipArea;
+
+/**
+ * Per-row span table of the circle inscribed in a width x height panel.
+ * A pixel counts as visible if any part of it lies inside the circle.
+ * tools/round_clip_check checks it against the exact circle on host.
+ */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    RoundClipSpan* rows;     // height entries
+    uint32_t visible_px;     // Visible pixels of the whole panel
+} RoundClip;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Fill the span table; rows must hold `height` entries
+ */
+void round_clip_init(RoundClip* c, uint16_t width, uint16_t height, RoundClipSpan* rows);
+
+/**
+ * Shrink a to the bounding box of its visible pixels
+ * @return false if none of a is visible (a is left unchanged)
+ */
+bool round_clip_area(const RoundClip* c, RoundClipArea* a);
+
+/**
+ * Cut a into bands of band_rows rows (aligned to multiples of band_rows) and
+ * shrink each to its visible bounding box, dropping invisible bands. Smaller
+ * bands follow the circle more tightly at the cost of more areas. With max
+ * areas written, the last one covers the rest of a, so nothing is lost.
+ * @return Number of areas written to out (at most max)
+ */
+int round_clip_split(const RoundClip* c, const RoundClipArea* a, uint16_t band_rows,
+                     RoundClipArea* out, int max);
+
+/**
+ * Visible pixels inside a
+ */
+uint32_t round_clip_visible_px(const RoundClip* c, const RoundClipArea* a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ROUND_CLIP_H */
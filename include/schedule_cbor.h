@@ -0,0 +1,46 @@
+#ifndef SCHEDULE_CBOR_H
+#define SCHEDULE_CBOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "JSON_reader.h"
+
+/**
+ * Decoder for the schedule in CBOR (RFC 8949), the compact alternative to
+ * duration.json. The document is a map with an "events" array; each event is
+ * either a map with the JSON's keys or, more compactly, a positional array:
+ *   {"events": [{"start": 360, "duration": 1800, "label": "..", "path": ".."}, ...]}
+ *   {"events": [[360, 1800, "..", ".."], ...]}
+ * Events go straight into readConfig records, reading the input through a
+ * small buffer. Events with missing or oversized fields are skipped, as in
+ * the JSON reader; unknown keys and trailing array elements are ignored.
+ * tools/schedule_bench checks it against the JSON path on host.
+ */
+
+#define SCHEDULE_CBOR_PATH "/schedule.cbor"   // Replaces /duration.json when present
+#define SCHEDULE_CBOR_READ_CHUNK 256
+#define SCHEDULE_CBOR_MAX_DEPTH 8            // Nesting allowed in skipped values
+
+/**
+ * Fill buf with up to len bytes; 0 at the end of the input
+ */
+typedef size_t (*ScheduleCborReadFn)(void* ctx, uint8_t* buf, size_t len);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @param out_events NULL to only check the document and count its events
+ * @param out_count Events decoded (stops at max_events when out_events is set)
+ * @return false if the input is not a well-formed schedule
+ */
+bool schedule_cbor_decode(ScheduleCborReadFn read, void* ctx,
+                          struct readConfig* out_events, size_t max_events, size_t* out_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHEDULE_CBOR_H */
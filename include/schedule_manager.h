@@ -30,6 +30,16 @@ bool isEventActive(void);
 uint16_t getCurrentMinutesSinceMidnight(void);
 const char* getTimeDisplayFormat(uint16_t minutes, char* out_buffer, size_t buffer_size);
 
+/**
+ * Where today's schedule stands, without the logging of the getters above
+ * (sampled often for the BLE device state)
+ * @param current_index Index into the events sorted by start, -1 if none is on
+ * @param next_index Next event to start, -1 if none
+ * @param seconds_remaining Until the current event ends, else until the next starts, else 0
+ * @return Generation of the loaded schedule: changes whenever its events do
+ */
+uint32_t getSchedulePosition(int* current_index, int* next_index, uint32_t* seconds_remaining);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,74 @@
+#ifndef SD_WRITER_H
+#define SD_WRITER_H
+
+#include <Arduino.h>
+#include "FS.h"
+
+/**
+ * Write-behind buffer for streaming a file to the SD card. Small writes are
+ * collected in PSRAM blocks that end on SD_WRITER_BLOCK_SIZE file offsets and
+ * are written by a background task, so the main loop only copies memory and
+ * the card sees whole, sector-aligned multi-KB writes instead of
+ * read-modify-write cycles. One file at a time.
+ */
+
+#define SD_WRITER_BLOCK_SIZE (16 * 1024)   // Multiple of the 512-byte sector
+#define SD_WRITER_BLOCKS 4                 // 64 KB of PSRAM in total
+#define SD_WRITER_TASK_STACK 4096
+#define SD_WRITER_TASK_PRIORITY 1
+#define SD_WRITER_TASK_CORE 0              // The Arduino loop runs on core 1
+
+// 1: no buffer or task; each write goes to the card from the caller and
+// checkpoints run there too, as before the write-behind buffer. For
+// before/after runs: the stats line reports the same fields either way.
+#ifndef SD_WRITER_DIRECT
+#define SD_WRITER_DIRECT 0
+#endif
+
+/**
+ * Called from the writer task after data up to at least `bytes` has been
+ * synced to the card; crc is the CRC-32 of the file's first `bytes` bytes
+ */
+typedef void (*SdWriterCheckpointFn)(void* ctx, uint32_t bytes, uint32_t crc);
+
+typedef struct {
+    uint32_t bytes;            // Written by the task
+    uint32_t blocks;
+    uint32_t write_us;         // Task time inside File::write/flush
+    uint32_t syncs;
+    uint32_t sync_us;          // Part of write_us spent in checkpoint and final syncs
+    uint32_t stall_us;         // Loop time spent waiting for a free block or a drain
+    uint32_t max_stall_us;
+    bool error;
+} SdWriterStats;
+
+/**
+ * Hand a file, positioned at offset, to the writer
+ * @param crc CRC-32 of the file's first offset bytes (0 when offset is 0)
+ * @param checkpoint_bytes Sync and call checkpoint every this many bytes (0: never)
+ * @param align Checkpoints report offsets that are multiples of this (0: any);
+ *              must not exceed SD_WRITER_BLOCK_SIZE
+ * @return false if the task or buffers could not be created
+ */
+bool sd_writer_begin(File file, uint32_t offset, uint32_t crc, uint32_t checkpoint_bytes,
+                     uint32_t align, SdWriterCheckpointFn checkpoint, void* ctx);
+
+/**
+ * Queue data; waits only when every block is still being written
+ * @return false once a write has failed
+ */
+bool sd_writer_write(const uint8_t* data, size_t len);
+
+/**
+ * Write everything queued, optionally sync, and close the file
+ * @param bytes,crc Size and CRC-32 of what reached the file (may be NULL)
+ * @return false if any write failed
+ */
+bool sd_writer_finish(bool sync, uint32_t* bytes, uint32_t* crc);
+
+bool sd_writer_active();
+
+void sd_writer_get_stats(SdWriterStats* out);
+void sd_writer_log_stats();
+
+#endif
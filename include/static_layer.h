@@ -0,0 +1,38 @@
+#ifndef STATIC_LAYER_H
+#define STATIC_LAYER_H
+
+#include <lvgl.h>
+
+// 0 draws Screen1's background layers live (for A/B timing with render_stats)
+#ifndef STATIC_LAYER_CACHE
+#define STATIC_LAYER_CACHE 1
+#endif
+
+#define STATIC_LAYER_MAX_OBJS 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Composite the screen's background and the given static children once into
+ * an RGB565 snapshot in PSRAM, shown by one image at the bottom of the screen.
+ * The static children are then hidden, so redraws blit the snapshot and draw
+ * only the dynamic widgets on top of it. Static objects end up underneath
+ * every dynamic one, so none may overlap a dynamic widget it was drawn over;
+ * they must be direct children of the screen.
+ * @return false (leaving the screen as it was) if PSRAM is short
+ */
+bool static_layer_init(lv_obj_t* screen, lv_obj_t* const* objs, int count);
+
+/**
+ * A static object changed (image source, theme): rebuild the snapshot from
+ * the next LVGL timer pass. Cheap to call repeatedly.
+ */
+void static_layer_invalidate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef STRIP_DECODER_H
+#define STRIP_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Compressed input is pulled from the file in chunks of this size
+#define STRIP_DECODER_IN_BUF 512
+
+/**
+ * Sequential read from the image payload
+ * @return Bytes read, or negative on error
+ */
+typedef int32_t (*strip_read_fn)(void* ctx, uint8_t* buf, uint32_t len);
+
+/**
+ * Streaming decoder for LVGL .bin pixel payloads (raw or RLE).
+ * Produces the image a strip at a time; the RLE run state is carried
+ * between calls, so only one strip plus a small input buffer is resident.
+ * tools/strip_check compares it with a full decode on host.
+ */
+typedef struct {
+    strip_read_fn read;
+    void* ctx;
+    bool compressed;
+    uint8_t blk;            // Bytes per pixel (RLE block size)
+
+    // RLE run in progress
+    bool literal;
+    uint32_t run_left;      // Blocks remaining in the current run
+    uint8_t rep[4];         // Repeated block
+
+    uint32_t in_left;       // Compressed bytes not yet pulled from the file
+    uint32_t in_pos;
+    uint32_t in_len;
+    uint8_t in[STRIP_DECODER_IN_BUF];
+} StripDecoder;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @param payload_size Compressed size for RLE payloads (ignored when raw)
+ */
+void strip_decoder_init(StripDecoder* d, strip_read_fn read, void* ctx, uint8_t blk,
+                        bool compressed, uint32_t payload_size);
+
+/**
+ * Decode exactly len bytes of pixels into out
+ * @return false on a read error or truncated/malformed data
+ */
+bool strip_decoder_read(StripDecoder* d, uint8_t* out, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STRIP_DECODER_H */
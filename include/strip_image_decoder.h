@@ -0,0 +1,20 @@
+#ifndef STRIP_IMAGE_DECODER_H
+#define STRIP_IMAGE_DECODER_H
+
+#include <lvgl.h>
+
+// Rows decoded per strip (480 px RGB565: 15 KB per strip)
+#ifndef STRIP_IMAGE_ROWS
+#define STRIP_IMAGE_ROWS 16
+#endif
+
+/**
+ * Register an LVGL image decoder that streams RGB565 .bin files (raw or RLE)
+ * from the file into a strip buffer, so images drawn by path never need a
+ * full-size decode buffer. Images served from the PSRAM cache (image_loader)
+ * bypass it; this covers path-based fallbacks when the cache cannot fit one.
+ * Call after lv_init().
+ */
+void strip_image_decoder_init();
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef UI_VIEW_MODEL_H
+#define UI_VIEW_MODEL_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+// ============ TOPICS ============
+// Data a screen can subscribe to; publishers pass a mask of what changed
+#define VM_TOPIC_TIMER     (1u << 0)   // Timer arc progress
+#define VM_TOPIC_CLOCK     (1u << 1)   // Wall clock and event countdown (every second)
+#define VM_TOPIC_BATTERY   (1u << 2)   // Battery voltage / percentage
+#define VM_TOPIC_SCHEDULE  (1u << 3)   // Day schedule contents
+#define VM_TOPIC_SETTINGS  (1u << 4)   // Brightness and alarm enable
+#define VM_TOPIC_ALL       0x1Fu
+
+#define VM_MAX_SUBSCRIBERS 4
+
+/**
+ * Refresh the widgets of one screen for the given topics
+ */
+typedef void (*vm_refresh_fn)(uint32_t topics);
+
+/**
+ * Subscribe a screen to topics. screen points at the generated ui_ScreenN
+ * variable, so screens that are built and destroyed lazily stay covered.
+ */
+void view_model_subscribe(lv_obj_t** screen, uint32_t topics, vm_refresh_fn refresh);
+
+/**
+ * Report changed data. Subscribers on the active screen refresh now;
+ * hidden ones only record the topics as stale.
+ */
+void view_model_publish(uint32_t topics);
+
+/**
+ * Hook a (newly built) screen: everything it shows is marked stale and
+ * caught up in one pass on LV_EVENT_SCREEN_LOAD_START. A screen that is
+ * already active is refreshed immediately.
+ */
+void view_model_attach(lv_obj_t* screen);
+
+/**
+ * Register the subscriptions of Screen1-3 and attach the screens built so far.
+ * Call after ui_init() and display_state_init().
+ */
+void view_model_init();
+
+#endif
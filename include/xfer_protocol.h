@@ -0,0 +1,171 @@
+#ifndef XFER_PROTOCOL_H
+#define XFER_PROTOCOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * Windowed file transfer with selective acknowledgement, independent of the
+ * transport (BLE on the device, a lossy loopback on host).
+ *
+ * Frames, little-endian. Phone -> device on the file characteristic
+ * (write without response):
+ *   START  01 | ver u8 | id u32 | size u32 | crc u32 | chunk u16 | window u16 | name_len u8 | name
+ *   DATA   02 | seq u32 | payload (chunk bytes, the last one shorter)
+ *   CANCEL 03 | id u32
+ * Device -> phone, notified on the status characteristic (first byte >= 0x80,
+ * so they never look like the "code:message" text statuses):
+ *   READY  80 | id u32 | chunk u16 | window u16 | resume u32
+ *          chunk/window the device accepted and the first chunk it still needs
+ *   SACK   81 | id u32 | base u32 | bits_len u8 | bits
+ *          every chunk < base is received; bit i set = chunk base + 1 + i received
+ *
+ * The sender keeps at most `window` chunks past base in flight and resends a
+ * chunk when a SACK shows a later one arrived without it, or when no SACK
+ * has covered it for XFER_RETRANSMIT_MS.
+ *
+ * Sending START again with the same id after a disconnect or reboot is how
+ * the phone asks where to resume; crc (CRC-32 of the whole file) lets the
+ * device verify what it stored.
+ */
+
+#define XFER_VERSION 2
+
+#define XFER_OP_START 0x01
+#define XFER_OP_DATA 0x02
+#define XFER_OP_CANCEL 0x03
+#define XFER_OP_READY 0x80
+#define XFER_OP_SACK 0x81
+
+#define XFER_DATA_HEADER 5       // op + seq
+#define XFER_NAME_MAX 64
+#define XFER_WINDOW_MAX 32       // Chunks the receiver can hold out of order
+
+#define XFER_ACK_EVERY 8         // Chunks between SACKs while data flows
+#define XFER_ACK_IDLE_MS 40      // SACK when data pauses with something unacknowledged
+#define XFER_RETRANSMIT_MS 250   // Sender resends chunks no SACK covered for this long
+
+// Largest START/SACK frame
+#define XFER_FRAME_MAX (20 + XFER_NAME_MAX)
+
+typedef struct {
+    uint32_t id;
+    uint32_t size;
+    uint32_t crc;            // CRC-32 of the whole file
+    uint16_t chunk;          // Payload bytes per DATA frame
+    uint16_t window;
+    uint32_t resume;         // First chunk the receiver needs (set by on_start)
+    char name[XFER_NAME_MAX + 1];
+} XferHeader;
+
+typedef enum {
+    XFER_END_COMPLETE,
+    XFER_END_CANCELLED,      // The sender gave up; stored data can go
+    XFER_END_SUSPENDED       // Link lost, replaced or sink failed; a later START can resume
+} XferEnd;
+
+/**
+ * Callbacks of a receiver. Data is delivered in order, exactly once.
+ */
+typedef struct {
+    void* ctx;
+    void (*send)(void* ctx, const uint8_t* frame, size_t len);
+    bool (*on_start)(void* ctx, XferHeader* header);            // May lower chunk/window, set resume; false rejects
+    bool (*on_data)(void* ctx, const uint8_t* data, size_t len); // false suspends
+    bool (*on_end)(void* ctx, XferEnd how);                     // COMPLETE: false if the file failed to verify
+} XferReceiverOps;
+
+typedef struct {
+    XferReceiverOps ops;
+    uint16_t max_chunk;      // Largest payload the transport carries
+    uint8_t* slots;          // XFER_WINDOW_MAX * max_chunk bytes for out-of-order chunks
+    uint16_t slot_len[XFER_WINDOW_MAX];
+
+    bool active;
+    bool completed;          // Last transfer finished and verified; its final SACK is repeated on demand
+    XferHeader header;
+    uint32_t total_chunks;
+    uint32_t base;           // Next chunk to deliver
+    uint32_t present;        // Bit i: chunk base + 1 + i is buffered
+    uint32_t since_ack;      // Chunks received since the last SACK
+    uint32_t last_rx_ms;
+    bool ack_pending;
+
+    // Stats for the current transfer
+    uint32_t duplicates;
+    uint32_t out_of_window;
+    uint32_t sacks_sent;
+} XferReceiver;
+
+/**
+ * Callbacks of a sender (used by the host harness; the phone app mirrors it)
+ */
+typedef struct {
+    void* ctx;
+    bool (*send)(void* ctx, const uint8_t* frame, size_t len);  // false: link busy, try later
+    size_t (*read)(void* ctx, uint32_t offset, uint8_t* out, size_t len);
+} XferSenderOps;
+
+typedef struct {
+    XferSenderOps ops;
+    XferHeader header;
+    uint32_t total_chunks;
+    bool ready;              // READY received
+    bool done;
+    uint32_t base;           // Receiver's cumulative ack
+    uint32_t next;           // Next never-sent chunk
+    uint32_t acked;          // Bit i: chunk base + 1 + i acknowledged
+    uint32_t sent_ms[XFER_WINDOW_MAX];     // Last send time, indexed by seq % XFER_WINDOW_MAX
+    uint32_t sent_order[XFER_WINDOW_MAX];  // frames_sent when it was last sent
+    uint32_t resend;         // Bit i: chunk base + i is due for retransmission
+    uint32_t start_sent_ms;
+
+    // Stats
+    uint32_t frames_sent;
+    uint32_t retransmits;
+} XferSender;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @param slots XFER_WINDOW_MAX * max_chunk bytes, owned by the caller
+ */
+void xfer_receiver_init(XferReceiver* r, const XferReceiverOps* ops, uint16_t max_chunk, uint8_t* slots);
+
+/**
+ * Handle one frame from the phone
+ */
+void xfer_receiver_input(XferReceiver* r, const uint8_t* frame, size_t len, uint32_t now_ms);
+
+/**
+ * Send the idle SACK when due; call regularly while a transfer is active
+ */
+void xfer_receiver_poll(XferReceiver* r, uint32_t now_ms);
+
+/**
+ * Suspend the transfer without notifying the peer (link lost)
+ */
+void xfer_receiver_abort(XferReceiver* r);
+
+uint32_t xfer_receiver_bytes(const XferReceiver* r);
+
+void xfer_sender_start(XferSender* s, const XferSenderOps* ops, const XferHeader* header, uint32_t now_ms);
+
+/**
+ * Handle a notification from the device
+ */
+void xfer_sender_input(XferSender* s, const uint8_t* frame, size_t len, uint32_t now_ms);
+
+/**
+ * Send what the window and link allow
+ */
+void xfer_sender_poll(XferSender* s, uint32_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* XFER_PROTOCOL_H */
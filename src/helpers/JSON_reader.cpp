@@ -1,11 +1,13 @@
 #include "JSON_reader.h"
+#include "json_event_stream.h"
+#include "schedule_cbor.h"
 #include <Arduino.h>
 #include "FS.h"
 #include "SD_MMC.h"
 #include <cctype>
 #include <cstring>
 
-//static bool parseEvents(const char* buf, readConfig* out_events, size_t max_events, size_t& out_count);
+#define JSON_READ_CHUNK 512  // File read size; the parser keeps only one event object
 
 static void skip_separators(const char*& p)
 {
@@ -86,51 +88,68 @@ static bool parseConfig(const char* buf, readConfig& cfg)
     return ok1 && ok2 && ok3 && ok4;
 }
 
-static bool parseEvents(const char* buf, readConfig* out_events, size_t max_events, size_t& out_count)
-{
-    out_count = 0;
-    const char* p = strstr(buf, "\"events\"");
-    if (!p) return false;
+struct EventSink {
+    readConfig* out_events;
+    size_t max_events;
+    size_t count;
+};
 
-    p = strchr(p, '[');
-    if (!p) return false;
-    p++;
+static bool collectEvent(void* ctx, const char* object, size_t len)
+{
+    EventSink* sink = (EventSink*)ctx;
+    readConfig cfg;
+    if (parseConfig(object, cfg)) {
+        sink->out_events[sink->count++] = cfg;
+    }
+    return sink->count < sink->max_events;
+}
 
-    while (*p && out_count < max_events) {
-        while (*p && *p != '{' && *p != ']') p++;
-        if (*p == ']') break;
-        if (*p != '{') break;
-
-        const char* obj_start = p;
-        int depth = 0;
-        while (*p) {
-            if (*p == '{') depth++;
-            else if (*p == '}') {
-                depth--;
-                if (depth == 0) {
-                    const char* obj_end = p;
-                    char tmp[256];
-                    size_t len = (size_t)(obj_end - obj_start + 1);
-                    if (len >= sizeof(tmp)) len = sizeof(tmp) - 1;
-                    memcpy(tmp, obj_start, len);
-                    tmp[len] = '\0';
-
-                    readConfig cfg;
-                    if (parseConfig(tmp, cfg)) {
-                        out_events[out_count++] = cfg;
-                    }
-                    p++;
-                    break;
-                }
-            }
-            p++;
-        }
-        if (depth != 0) break;
+/**
+ * Stream the file through the event parser, so its length is not limited by a buffer
+ */
+static bool parseEventsFromFile(File& f, readConfig* out_events, size_t max_events, size_t& out_count)
+{
+    EventSink sink = {out_events, max_events, 0};
+    JsonEventStream stream;
+    json_event_stream_init(&stream, collectEvent, &sink);
+
+    char buf[JSON_READ_CHUNK];
+    size_t n;
+    while (max_events > 0 && (n = f.readBytes(buf, sizeof(buf))) > 0) {
+        if (!json_event_stream_feed(&stream, buf, n) || json_event_stream_done(&stream)) break;
     }
 
+    out_count = sink.count;
     return out_count > 0;
 }
 
+static size_t readFromFile(void* ctx, uint8_t* buf, size_t len)
+{
+    return ((File*)ctx)->read(buf, len);
+}
+
+/**
+ * A config commit sets the live file aside as <path>.old before renaming the
+ * new one into place; power lost in between leaves only the .old. Put it
+ * back, once per boot (before a BLE commit can be in that window).
+ */
+static void recoverConfigFiles()
+{
+    static bool recovered = false;
+    if (recovered) return;
+    recovered = true;
+
+    const char* paths[] = {"/duration.json", SCHEDULE_CBOR_PATH};
+    for (const char* path : paths) {
+        char oldPath[48];
+        snprintf(oldPath, sizeof(oldPath), "%s.old", path);
+        if (!SD_MMC.exists(path) && SD_MMC.exists(oldPath)) {
+            Serial.printf("Restoring %s from an interrupted config save\n", path);
+            SD_MMC.rename(oldPath, path);
+        }
+    }
+}
+
 // Add this helper function to initialize the JSON file
 static bool initializeJSONFile()
 {
@@ -139,6 +158,9 @@ static bool initializeJSONFile()
         return false;
     }
 
+    // Before a missing duration.json is replaced by an empty one
+    recoverConfigFiles();
+
     // Check if file exists
     if (!SD_MMC.exists("/duration.json")) {
         Serial.println("duration.json not found, creating default file...");
@@ -181,17 +203,32 @@ bool readJSON(readConfig& cfg)
         return false;
     }
 
-    char buf[2048];
-    size_t n = f.readBytes(buf, sizeof(buf) - 1);
-    buf[n] = '\0';
-    f.close();
-
     size_t count = 0;
-    return parseEvents(buf, &cfg, 1, count);
+    bool ok = parseEventsFromFile(f, &cfg, 1, count);
+    f.close();
+    return ok;
 }
 
 bool readJSONQueue(readConfig* out_events, size_t max_events, size_t* out_count)
 {
+    *out_count = 0;
+
+    if (SD_MMC.cardType() != CARD_NONE) {
+        recoverConfigFiles();
+    }
+
+    // A schedule uploaded as CBOR takes the place of the JSON one
+    if (SD_MMC.cardType() != CARD_NONE && SD_MMC.exists(SCHEDULE_CBOR_PATH)) {
+        File f = SD_MMC.open(SCHEDULE_CBOR_PATH, FILE_READ);
+        if (!f) {
+            Serial.println("Failed to open " SCHEDULE_CBOR_PATH);
+            return false;
+        }
+        bool ok = schedule_cbor_decode(readFromFile, &f, out_events, max_events, out_count);
+        f.close();
+        return ok && *out_count > 0;
+    }
+
     // Initialize file if needed
     if (!initializeJSONFile()) {
         *out_count = 0;
@@ -210,10 +247,7 @@ bool readJSONQueue(readConfig* out_events, size_t max_events, size_t* out_count)
         return false;
     }
 
-    char buf[4096];
-    size_t n = f.readBytes(buf, sizeof(buf) - 1);
-    buf[n] = '\0';
+    bool ok = parseEventsFromFile(f, out_events, max_events, *out_count);
     f.close();
-
-    return parseEvents(buf, out_events, max_events, *out_count);
+    return ok;
 }
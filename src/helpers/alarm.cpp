@@ -1,5 +1,6 @@
 #include "alarm.h"
 #include "TCA9554PWR.h"
+#include "ui_view_model.h"
 
 // ============ ALARM STATE ============
 AlarmState alarm_state = {
@@ -33,6 +34,7 @@ void set_alarm_enabled(bool enabled) {
     if (!enabled) {
         stop_alarm();
     }
+    view_model_publish(VM_TOPIC_SETTINGS);
     Serial.print("Alarm ");
     Serial.println(enabled ? "enabled" : "disabled");
 }
@@ -0,0 +1,123 @@
+#include "asset_bundle.h"
+#include "crc32.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "FS.h"
+#include "SD_MMC.h"
+#endif
+
+static_assert(sizeof(AssetBundleHeader) == 16, "bundle header layout");
+static_assert(sizeof(AssetBundleEntry) == 44, "bundle index layout");
+
+static AssetBundleEntry entries[ASSET_BUNDLE_MAX_ENTRIES];
+static uint16_t entryCount = 0;
+static char bundlePath[64];
+static bool mounted = false;
+
+static bool read_fully(block_read_at_fn read_at, void* ctx, uint32_t offset, void* buf, uint32_t len) {
+    return read_at(ctx, offset, (uint8_t*)buf, len) == (int32_t)len;
+}
+
+static bool overlaps(const AssetBundleEntry& a, const AssetBundleEntry& b) {
+    return a.offset < b.offset + b.size && b.offset < a.offset + a.size;
+}
+
+/**
+ * CRC-32 of an asset's bytes, read in ASSET_BUNDLE_VERIFY_CHUNK pieces
+ */
+static bool asset_crc_matches(block_read_at_fn read_at, void* ctx, const AssetBundleEntry& e) {
+    uint8_t buf[ASSET_BUNDLE_VERIFY_CHUNK];
+    uint32_t crc = 0;
+    for (uint32_t done = 0; done < e.size;) {
+        uint32_t n = e.size - done < sizeof(buf) ? e.size - done : sizeof(buf);
+        if (!read_fully(read_at, ctx, e.offset + done, buf, n)) return false;
+        crc = crc32_update(crc, buf, n);
+        done += n;
+    }
+    return crc == e.crc;
+}
+
+bool asset_bundle_mount(block_read_at_fn read_at, void* ctx, uint32_t file_size, const char* path,
+                        bool verify_assets) {
+    asset_bundle_unmount();
+    if (strlen(path) >= sizeof(bundlePath)) return false;
+
+    AssetBundleHeader header;
+    if (file_size < sizeof(header) || !read_fully(read_at, ctx, 0, &header, sizeof(header))) return false;
+    if (header.magic != ASSET_BUNDLE_MAGIC || header.version != ASSET_BUNDLE_VERSION ||
+        header.count > ASSET_BUNDLE_MAX_ENTRIES) {
+        return false;
+    }
+
+    uint32_t indexLen = header.count * (uint32_t)sizeof(AssetBundleEntry);
+    uint32_t indexEnd = sizeof(header) + indexLen;
+    if (indexEnd > file_size || !read_fully(read_at, ctx, sizeof(header), entries, indexLen)) return false;
+    if (crc32_update(0, entries, indexLen) != header.index_crc) return false;
+
+    // Every asset must be a uniquely named, aligned range of the file past the index,
+    // sharing no bytes with another asset
+    for (uint16_t i = 0; i < header.count; i++) {
+        const AssetBundleEntry& e = entries[i];
+        if (memchr(e.name, '\0', sizeof(e.name)) == NULL || e.name[0] == '\0') return false;
+        if (e.offset % ASSET_BUNDLE_ALIGN != 0 || e.offset < indexEnd) return false;
+        if (e.offset > file_size || e.size > file_size - e.offset) return false;
+        for (uint16_t j = 0; j < i; j++) {
+            if (overlaps(e, entries[j]) || strcmp(e.name, entries[j].name) == 0) return false;
+        }
+    }
+
+    for (uint16_t i = 0; verify_assets && i < header.count; i++) {
+        if (!asset_crc_matches(read_at, ctx, entries[i])) return false;
+    }
+
+    entryCount = header.count;
+    strcpy(bundlePath, path);
+    mounted = true;
+    return true;
+}
+
+void asset_bundle_unmount() {
+    mounted = false;
+    entryCount = 0;
+}
+
+const char* asset_bundle_path() {
+    return mounted ? bundlePath : NULL;
+}
+
+const AssetBundleEntry* asset_bundle_find(const char* name) {
+    for (uint16_t i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].name, name) == 0) return &entries[i];
+    }
+    return NULL;
+}
+
+const AssetBundleEntry* asset_bundle_lookup(const char* path) {
+    size_t prefixLen = strlen(ASSET_BUNDLE_PREFIX);
+    if (!mounted || !path || strncmp(path, ASSET_BUNDLE_PREFIX, prefixLen) != 0) return NULL;
+    return asset_bundle_find(path + prefixLen);
+}
+
+#ifdef ARDUINO
+static int32_t file_read_at(void* ctx, uint32_t offset, uint8_t* buf, uint32_t len) {
+    File* f = (File*)ctx;
+    if (f->position() != offset && !f->seek(offset)) return -1;
+    return (int32_t)f->read(buf, len);
+}
+
+bool asset_bundle_mount_file(const char* path, bool verify_assets) {
+    File f = SD_MMC.open(path, FILE_READ);
+    if (!f) return false;
+    bool ok = asset_bundle_mount(file_read_at, &f, f.size(), path, verify_assets);
+    f.close();
+
+    if (ok) {
+        Serial.printf("[BUNDLE] Mounted %s: %u assets\n", path, entryCount);
+    } else {
+        Serial.printf("[BUNDLE] ✗ Invalid bundle: %s\n", path);
+    }
+    return ok;
+}
+#endif
@@ -1,7 +1,14 @@
 #include "battery_management.h"
 #include "squarelineUI/ui.h"
+#include "ui_view_model.h"
 #include <Arduino.h>
 
+// Last sample, rendered by battery_refresh_ui() when Screen 3 is shown
+static bool sampled = false;
+static uint32_t last_sample_ms = 0;
+static float sampled_voltage = 0;
+static uint8_t sampled_percent = 0;
+
 void battery_init() {
     analogSetPinAttenuation(BATTERY_ADC_PIN, ADC_11db);  // For 0-3.3V range
     pinMode(BATTERY_ADC_PIN, INPUT);
@@ -14,9 +21,7 @@ float get_battery_voltage() {
     return voltage;
 }
 
-uint8_t get_battery_percentage() {
-    float voltage = get_battery_voltage();
-    
+static uint8_t percentage_from_voltage(float voltage) {
     // Clamp to battery range
     if (voltage >= MAX_BATTERY_VOLTAGE) return 100;
     if (voltage <= MIN_BATTERY_VOLTAGE) return 0;
@@ -27,17 +32,41 @@ uint8_t get_battery_percentage() {
     return percentage;
 }
 
+uint8_t get_battery_percentage() {
+    return percentage_from_voltage(get_battery_voltage());
+}
+
 void update_battery_display() {
-    uint8_t percent = get_battery_percentage();
+    if (sampled && millis() - last_sample_ms < BATTERY_SAMPLE_INTERVAL_MS) return;
+    last_sample_ms = millis();
+    
     float voltage = get_battery_voltage();
+    uint8_t percent = percentage_from_voltage(voltage);
+    
+    // Only wake subscribers when the displayed text would change
+    if (sampled && percent == sampled_percent && fabsf(voltage - sampled_voltage) < 0.005f) return;
+    sampled = true;
+    sampled_voltage = voltage;
+    sampled_percent = percent;
+    view_model_publish(VM_TOPIC_BATTERY);
+}
+
+bool get_sampled_battery_percentage(uint8_t* percent) {
+    if (!sampled) return false;
+    *percent = sampled_percent;
+    return true;
+}
+
+void battery_refresh_ui() {
+    if (!sampled) return;
     
     if (ui_batteryBar2) {
-        lv_bar_set_value(ui_batteryBar2, percent, LV_ANIM_OFF);
+        lv_bar_set_value(ui_batteryBar2, sampled_percent, LV_ANIM_OFF);
     }
     
     if (ui_batteryPercent2) {
         char buffer[32];
-        snprintf(buffer, sizeof(buffer), "%.2fV\n%d%%", voltage, percent);
+        snprintf(buffer, sizeof(buffer), "%.2fV\n%d%%", sampled_voltage, sampled_percent);
         lv_label_set_text(ui_batteryPercent2, buffer);
     }
 }
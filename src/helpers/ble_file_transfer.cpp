@@ -1,54 +1,186 @@
 #include "ble_file_transfer.h"
 #include "SD_MMC.h"
+#include "image_ingest.h"
+#include "image_store.h"
+#include "asset_bundle.h"
+#include "sd_writer.h"
 #include <Arduino.h>
+#include "crc32.h"
 
-// File transfer state
+#define MANIFEST_MAGIC 0x5846524Du  // "MRFX"
+#define VERIFY_BUFFER_SIZE 4096
+
+/**
+ * Persisted state of the transfer in progress. Data arrives in order, so what
+ * is stored is always the single range [0, received).
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t id;
+    uint32_t size;
+    uint32_t expectedCrc;
+    uint32_t received;
+    uint32_t crc;           // CRC-32 of [0, received)
+    uint16_t chunk;
+    char filename[128];
+    uint32_t selfCrc;       // Over everything above; a torn write reads as no manifest
+} TransferManifest;
+
+// File transfer state; the open file belongs to sd_writer while transferring
 static FileTransferState transferState = {0};
-static File currentFile;
+
+// Fixed fields of the current transfer's manifest (read by the writer task)
+static TransferManifest activeManifest;
+
+// Files named by their SHA-256 are blobs of the content-addressed store
+static const char* directoryFor(const char* filename) {
+    return image_store_is_blob_name(filename) ? IMAGE_STORE_BLOB_DIR : "/lvgl_images";
+}
+
+static void finalPath(char* out, size_t size, const char* filename) {
+    snprintf(out, size, "%s/%s", directoryFor(filename), filename);
+}
+
+static void partPath(char* out, size_t size, const char* filename) {
+    snprintf(out, size, "%s/%s.part", directoryFor(filename), filename);
+}
+
+static uint32_t manifestCrc(const TransferManifest* m) {
+    return crc32_update(0, (const uint8_t*)m, offsetof(TransferManifest, selfCrc));
+}
+
+static bool loadManifest(TransferManifest* m) {
+    File f = SD_MMC.open(FILE_TRANSFER_MANIFEST);
+    if (!f) return false;
+    size_t n = f.read((uint8_t*)m, sizeof(*m));
+    f.close();
+    return n == sizeof(*m) && m->magic == MANIFEST_MAGIC && m->selfCrc == manifestCrc(m);
+}
+
+/**
+ * Record that the first `received` bytes (with CRC `crc`) are synced to the card
+ */
+static void saveManifest(uint32_t received, uint32_t crc) {
+    TransferManifest m = activeManifest;
+    m.received = received;
+    m.crc = crc;
+    m.selfCrc = manifestCrc(&m);
+
+    File f = SD_MMC.open(FILE_TRANSFER_MANIFEST, FILE_WRITE);
+    if (!f) {
+        Serial.println("[FILE TRANSFER] WARNING: Failed to save manifest");
+        return;
+    }
+    f.write((const uint8_t*)&m, sizeof(m));
+    f.close();
+}
 
 /**
- * Initialize a new file transfer
- * Call this when receiving START: control message
+ * sd_writer checkpoint, on the writer task: the data before it is already synced
  */
-void initFileTransfer(const char* filename, uint32_t fileSize) {
+static void onWriterCheckpoint(void* ctx, uint32_t bytes, uint32_t crc) {
+    saveManifest(bytes, crc);
+}
+
+/**
+ * Drop the manifest and the partial file it describes
+ */
+static void discardManifest() {
+    TransferManifest m;
+    if (loadManifest(&m)) {
+        char path[256];
+        partPath(path, sizeof(path), m.filename);
+        SD_MMC.remove(path);
+    }
+    SD_MMC.remove(FILE_TRANSFER_MANIFEST);
+}
+
+/**
+ * Start a new file transfer or pick up an interrupted one
+ * Call this when receiving a START frame
+ */
+uint32_t openFileTransfer(const char* filename, uint32_t fileSize, uint32_t transferId,
+                          uint32_t expectedChecksum, uint16_t* chunkSize) {
     // Close any existing file
-    if (currentFile) {
-        currentFile.close();
+    if (sd_writer_active()) {
+        suspendFileTransfer();
     }
     
+    memset(&transferState, 0, sizeof(transferState));
     strncpy(transferState.filename, filename, sizeof(transferState.filename) - 1);
     transferState.fileSize = fileSize;
-    transferState.bytesReceived = 0;
-    transferState.checksum = 0;
-    transferState.isTransferring = true;
+    transferState.expectedChecksum = expectedChecksum;
+    transferState.transferId = transferId;
+    transferState.chunkSize = *chunkSize;
     
     // Ensure SD card is mounted
     if (SD_MMC.cardType() == CARD_NONE) {
         Serial.println("[FILE TRANSFER] ERROR: SD card not mounted");
-        transferState.isTransferring = false;
-        return;
+        return 0;
     }
     
-    // Create file path - store in /lvgl_images directory
-    char filepath[256];
-    snprintf(filepath, sizeof(filepath), "/lvgl_images/%s", filename);
-    
     // Create directory if it doesn't exist
     if (!SD_MMC.exists("/lvgl_images")) {
         Serial.println("[FILE TRANSFER] Creating /lvgl_images directory");
-        // Note: ESP32 SD_MMC doesn't have mkdir, so we just try to open
+        SD_MMC.mkdir("/lvgl_images");
+    }
+    if (image_store_is_blob_name(filename) && !SD_MMC.exists(IMAGE_STORE_BLOB_DIR)) {
+        SD_MMC.mkdir(IMAGE_STORE_BLOB_DIR);
     }
     
-    // Open file for writing
-    currentFile = SD_MMC.open(filepath, FILE_WRITE);
-    if (!currentFile) {
-        Serial.printf("[FILE TRANSFER] ERROR: Failed to open %s for writing\n", filepath);
-        transferState.isTransferring = false;
-        return;
+    char filepath[256];
+    partPath(filepath, sizeof(filepath), filename);
+    
+    // Resume only the same file, cut at the same chunk boundaries
+    TransferManifest m;
+    File file;
+    bool resume = loadManifest(&m) && m.id == transferId && m.size == fileSize &&
+                  m.expectedCrc == expectedChecksum && strcmp(m.filename, filename) == 0 &&
+                  m.chunk && m.chunk <= *chunkSize && m.received <= fileSize &&
+                  (m.received % m.chunk == 0 || m.received == fileSize);
+    if (resume) {
+        // Bytes past the manifest may be torn; they are overwritten from there
+        file = SD_MMC.open(filepath, "r+");
+        resume = file && file.size() >= m.received && file.seek(m.received);
+    }
+    
+    if (resume) {
+        transferState.bytesReceived = m.received;
+        transferState.checksum = m.crc;
+        transferState.chunkSize = m.chunk;
+        *chunkSize = m.chunk;
+        Serial.printf("[FILE TRANSFER] Resuming: %s at %lu of %lu bytes\n", filepath, m.received, fileSize);
+    } else {
+        if (file) file.close();
+        discardManifest();
+        file = SD_MMC.open(filepath, FILE_WRITE);
+        if (!file) {
+            Serial.printf("[FILE TRANSFER] ERROR: Failed to open %s for writing\n", filepath);
+            return 0;
+        }
+        Serial.printf("[FILE TRANSFER] Started: %s (%lu bytes)\n", filepath, fileSize);
+    }
+    
+    memset(&activeManifest, 0, sizeof(activeManifest));
+    activeManifest.magic = MANIFEST_MAGIC;
+    activeManifest.id = transferId;
+    activeManifest.size = fileSize;
+    activeManifest.expectedCrc = expectedChecksum;
+    activeManifest.chunk = transferState.chunkSize;
+    strncpy(activeManifest.filename, filename, sizeof(activeManifest.filename) - 1);
+    saveManifest(transferState.bytesReceived, transferState.checksum);
+    
+    // Chunks are written to the card by the background writer. A resume restarts
+    // at a whole chunk, so checkpoints are taken on chunk boundaries only.
+    if (!sd_writer_begin(file, transferState.bytesReceived, transferState.checksum,
+                         FILE_TRANSFER_CHECKPOINT_BYTES, transferState.chunkSize,
+                         onWriterCheckpoint, nullptr)) {
+        file.close();
+        return 0;
     }
     
-    Serial.printf("[FILE TRANSFER] Started: %s (%lu bytes)\n", filepath, fileSize);
-    Serial.printf("[FILE TRANSFER] Waiting for %lu bytes...\n", fileSize);
+    transferState.isTransferring = true;
+    return transferState.bytesReceived;
 }
 
 /**
@@ -56,23 +188,20 @@ void initFileTransfer(const char* filename, uint32_t fileSize) {
  * Call this for each data packet from BLE
  */
 void receiveFileChunk(const uint8_t* data, size_t length) {
-    if (!transferState.isTransferring || !currentFile) {
+    if (!transferState.isTransferring) {
         Serial.println("[FILE TRANSFER] ERROR: Transfer not active or file not open");
         return;
     }
     
-    // Write data to file
-    size_t written = currentFile.write(data, length);
-    if (written != length) {
-        Serial.printf("[FILE TRANSFER] WARNING: Only wrote %lu of %lu bytes\n", written, length);
+    // Buffered in PSRAM; the writer task puts it on the card in aligned blocks
+    if (!sd_writer_write(data, length)) {
+        // Keep what reached the card; the phone resumes from there
+        Serial.println("[FILE TRANSFER] ERROR: SD write failed");
+        suspendFileTransfer();
+        return;
     }
     
-    transferState.bytesReceived += written;
-    
-    // Simple checksum (XOR of all bytes)
-    for (size_t i = 0; i < length; i++) {
-        transferState.checksum ^= data[i];
-    }
+    transferState.bytesReceived += length;
     
     // Log progress every 5KB or at the end
     if (transferState.bytesReceived % 5120 == 0 || transferState.bytesReceived >= transferState.fileSize) {
@@ -84,8 +213,33 @@ void receiveFileChunk(const uint8_t* data, size_t length) {
     }
 }
 
+/**
+ * CRC-32 of the file as stored on the card
+ */
+static bool checksumStoredFile(const char* path, uint32_t* crc, uint32_t* size) {
+    File f = SD_MMC.open(path);
+    if (!f) return false;
+    
+    uint8_t* buf = (uint8_t*)malloc(VERIFY_BUFFER_SIZE);
+    if (!buf) {
+        f.close();
+        return false;
+    }
+    *crc = 0;
+    *size = 0;
+    size_t n;
+    while ((n = f.read(buf, VERIFY_BUFFER_SIZE)) > 0) {
+        *crc = crc32_update(*crc, buf, n);
+        *size += n;
+    }
+    free(buf);
+    f.close();
+    return true;
+}
+
 /**
  * Check if file transfer is complete
+ * A complete file is verified against the phone's CRC before it replaces the old one
  */
 bool isFileTransferComplete() {
     if (!transferState.isTransferring) {
@@ -93,31 +247,80 @@ bool isFileTransferComplete() {
     }
     
     if (transferState.bytesReceived >= transferState.fileSize) {
-        // Close the file
-        if (currentFile) {
-            currentFile.close();
-        }
+        // Drain the write-behind buffer, sync once and close the file
+        uint32_t storedBytes = 0;
+        bool written = sd_writer_finish(true, &storedBytes, &transferState.checksum);
+        sd_writer_log_stats();
         
         transferState.isTransferring = false;
+        if (!written) {
+            // Keep what reached the card; the phone resumes from there
+            saveManifest(storedBytes, transferState.checksum);
+            Serial.println("[FILE TRANSFER] ✗ ERROR: SD write failed");
+            return false;
+        }
         
-        // Verify file was written
+        char partpath[256];
         char filepath[256];
-        snprintf(filepath, sizeof(filepath), "/lvgl_images/%s", transferState.filename);
+        partPath(partpath, sizeof(partpath), transferState.filename);
+        finalPath(filepath, sizeof(filepath), transferState.filename);
         
-        File verifyFile = SD_MMC.open(filepath);
-        if (verifyFile) {
-            uint32_t fileSize = verifyFile.size();
-            verifyFile.close();
-            Serial.printf("[FILE TRANSFER] ✓ File verified on SD card: %s (%lu bytes)\n", 
-                transferState.filename, fileSize);
-        } else {
-            Serial.printf("[FILE TRANSFER] ✗ ERROR: Could not verify file on SD card: %s\n", 
-                transferState.filename);
+        // Verify what reached the card, not what was received
+        uint32_t storedCrc = 0;
+        uint32_t storedSize = 0;
+        if (!checksumStoredFile(partpath, &storedCrc, &storedSize) ||
+            storedSize != transferState.fileSize || storedCrc != transferState.expectedChecksum) {
+            Serial.printf("[FILE TRANSFER] ✗ ERROR: Verification failed: %s (%lu bytes, CRC 0x%08lx, expected 0x%08lx)\n",
+                transferState.filename, storedSize, storedCrc, transferState.expectedChecksum);
+            discardManifest();
+            return false;
         }
         
+        // A blob must also be what its name says it is
+        bool blob = image_store_is_blob_name(transferState.filename);
+        if (blob && !image_store_verify_blob(partpath, transferState.filename)) {
+            discardManifest();
+            return false;
+        }
+        
+        // The mounted bundle is read in place; let go of it before it is replaced
+        bool bundle = strcmp(transferState.filename, ASSET_BUNDLE_FILE) == 0;
+        if (bundle) {
+            asset_bundle_unmount();
+        }
+        
+        // Only a verified file replaces the previous one
+        if (SD_MMC.exists(filepath)) {
+            SD_MMC.remove(filepath);
+        }
+        if (!SD_MMC.rename(partpath, filepath)) {
+            Serial.printf("[FILE TRANSFER] ✗ ERROR: Could not rename %s into place\n", partpath);
+            discardManifest();
+            return false;
+        }
+        SD_MMC.remove(FILE_TRANSFER_MANIFEST);
+        
+        Serial.printf("[FILE TRANSFER] ✓ File verified on SD card: %s (%lu bytes)\n", 
+            transferState.filename, storedSize);
         Serial.printf("[FILE TRANSFER] Complete: %s\n", transferState.filename);
         Serial.printf("[FILE TRANSFER] Total bytes: %lu\n", transferState.bytesReceived);
-        Serial.printf("[FILE TRANSFER] Checksum: 0x%08lx\n", transferState.checksum);
+        Serial.printf("[FILE TRANSFER] CRC-32: 0x%08lx\n", storedCrc);
+        
+        if (bundle) {
+            if (!asset_bundle_mount_file(filepath, true)) {
+                SD_MMC.remove(filepath);
+                return false;
+            }
+            return true;
+        }
+        
+        // A plain upload of a name takes over from the store's image for it
+        if (!blob) {
+            image_store_forget(transferState.filename);
+        }
+        
+        // Convert images to display-native binaries once, on the ingest task, instead of on every display
+        image_ingest_request(filepath);
         
         return true;
     }
@@ -146,13 +349,34 @@ const char* getCurrentFilename() {
     return transferState.filename;
 }
 
+/**
+ * Stop the current transfer but keep it resumable
+ */
+void suspendFileTransfer() {
+    if (!transferState.isTransferring) {
+        return;
+    }
+    
+    // Record only what is synced to the card
+    uint32_t storedBytes = 0;
+    sd_writer_finish(true, &storedBytes, &transferState.checksum);
+    sd_writer_log_stats();
+    saveManifest(storedBytes, transferState.checksum);
+    transferState.bytesReceived = storedBytes;
+    transferState.isTransferring = false;
+    
+    Serial.printf("[FILE TRANSFER] Suspended: %s at %lu of %lu bytes\n",
+        transferState.filename, transferState.bytesReceived, transferState.fileSize);
+}
+
 /**
  * Cancel the current file transfer
  */
 void cancelFileTransfer() {
-    if (currentFile) {
-        currentFile.close();
+    if (sd_writer_active()) {
+        sd_writer_finish(false, nullptr, nullptr);
     }
+    discardManifest();
     
     transferState.isTransferring = false;
     transferState.bytesReceived = 0;
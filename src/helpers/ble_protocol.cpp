@@ -0,0 +1,694 @@
+#include "ble_protocol.h"
+#include "crc32.h"
+#include "lz4_stream.h"
+#include "json_event_stream.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#define BLE_LOG(...) Serial.printf(__VA_ARGS__)
+#define PSRAM_ALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#else
+#ifdef BLE_PROTOCOL_QUIET
+#define BLE_LOG(...) do { if (0) printf(__VA_ARGS__); } while (0)   // Benchmarks on host
+#else
+#define BLE_LOG(...) printf(__VA_ARGS__)
+#endif
+#define PSRAM_ALLOC(size) malloc(size)
+#endif
+
+// Queues for BLE writes, filled by the transport's task and drained by the main loop
+#define FILE_QUEUE_SIZE (XFER_WINDOW_MAX + 8)   // A full transfer window plus control frames
+#define CONFIG_QUEUE_SIZE 8
+
+struct BLEDataPacket {
+    uint8_t data[BLE_PROTOCOL_FRAME_MAX];
+    size_t length;
+};
+
+struct BLEPacketQueue {
+    BLEDataPacket* packets;
+    uint8_t size;
+    volatile uint8_t head;
+    volatile uint8_t tail;
+    uint32_t drops;          // Frames lost to a full queue
+};
+
+static BLEPacketQueue fileQueue = {nullptr, FILE_QUEUE_SIZE, 0, 0, 0};
+static BLEPacketQueue configQueue = {nullptr, CONFIG_QUEUE_SIZE, 0, 0, 0};
+
+static BleTransport transport;
+static BleProtocolOps ops;
+static volatile bool connected = false;
+
+// Single-write JSON config, deferred to the main loop
+static char* jsonConfigBuffer = nullptr;
+static size_t jsonConfigLength = 0;
+static volatile bool jsonConfigReady = false;
+
+// Framed config upload, assembled in the main loop
+struct ConfigUpload {
+    bool active;
+    bool compressed;
+    bool cbor;
+    uint32_t size;           // Document bytes (after decompression)
+    uint32_t crc;            // Expected CRC-32 of the document
+    uint32_t received;       // Payload bytes as sent
+    uint32_t written;        // Document bytes written
+    uint32_t runningCrc;
+    const char* error;       // Set by the output sink when it refuses data
+    JsonEventStream events;
+};
+
+static ConfigUpload configUpload;
+static Lz4Stream* configLz4 = nullptr;   // Allocated on the first compressed upload
+static volatile bool configLinkLost = false;
+
+// File transfer protocol (xfer_protocol.h)
+#define XFER_MAX_CHUNK (BLE_PROTOCOL_FRAME_MAX - XFER_DATA_HEADER)
+static XferReceiver fileReceiver;
+static uint8_t* fileSlots = nullptr;
+static volatile bool fileLinkLost = false;
+
+// Device state record, notified on change
+static DeviceStatePublisher deviceState;
+static uint8_t deviceStateValue[DEVICE_STATE_LEN];   // Value last set on the characteristic
+static bool deviceStateValueSet = false;
+static volatile bool deviceStateLinkUp = false;     // New connection: notify the next sample
+
+static uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool queueAlloc(BLEPacketQueue& q) {
+    if (!q.packets) {
+        q.packets = (BLEDataPacket*)PSRAM_ALLOC(sizeof(BLEDataPacket) * q.size);
+    }
+    q.head = q.tail = 0;
+    q.drops = 0;
+    return q.packets != nullptr;
+}
+
+/**
+ * Copy a write into the queue (transport's task); false if it was dropped
+ */
+static bool queuePush(BLEPacketQueue& q, const uint8_t* data, size_t len) {
+    if (!q.packets) return false;
+    uint8_t next = (q.tail + 1) % q.size;
+    if (next == q.head || len > BLE_PROTOCOL_FRAME_MAX) {
+        q.drops++;
+        return false;
+    }
+    BLEDataPacket* pkt = &q.packets[q.tail];
+    memcpy(pkt->data, data, len);
+    pkt->length = len;
+    q.tail = next;
+    return true;
+}
+
+/**
+ * Oldest queued packet (main loop), or nullptr; release with queuePop()
+ */
+static BLEDataPacket* queuePeek(BLEPacketQueue& q) {
+    return q.head != q.tail ? &q.packets[q.head] : nullptr;
+}
+
+static void queuePop(BLEPacketQueue& q) {
+    q.head = (q.head + 1) % q.size;
+}
+
+void ble_protocol_status(BLEStatus status, const char* message) {
+    if (!transport.notify) {
+        return;
+    }
+
+    char statusMsg[128];
+    if (message) {
+        snprintf(statusMsg, sizeof(statusMsg), "%d:%s", status, message);
+    } else {
+        snprintf(statusMsg, sizeof(statusMsg), "%d", status);
+    }
+
+    transport.notify(transport.ctx, BLE_CHANNEL_STATUS, (const uint8_t*)statusMsg, strlen(statusMsg));
+    BLE_LOG("[BLE Status] %s\n", statusMsg);
+}
+
+bool ble_protocol_send(BleChannel channel, const uint8_t* data, size_t len) {
+    return transport.notify && transport.notify(transport.ctx, channel, data, len);
+}
+
+bool ble_protocol_connected() {
+    return connected;
+}
+
+void ble_protocol_link(bool up) {
+    connected = up;
+    if (up) {
+        deviceStateLinkUp = true;
+    }
+    if (!up) {
+        fileLinkLost = true;  // Transfer is dropped in the main loop
+        configLinkLost = true;
+    }
+}
+
+// ============ CONFIG ============
+
+/**
+ * Buffer a whole-JSON write for the main loop (transport's task)
+ */
+static void configWrite(const uint8_t* data, size_t len) {
+    // Framed uploads are assembled in the main loop; a lost frame fails the upload there
+    uint8_t op = data[0];
+    if (op >= CONFIG_FRAME_BEGIN && op <= CONFIG_FRAME_ABORT) {
+        queuePush(configQueue, data, len);
+        return;
+    }
+
+    BLE_LOG("[BLE CONFIG] Received %u bytes of JSON\n", (unsigned int)len);
+
+    // Allocate buffer on first use (from heap/PSRAM, not static DRAM)
+    if (jsonConfigBuffer == nullptr) {
+        jsonConfigBuffer = (char*)malloc(BLE_PROTOCOL_JSON_MAX);
+        if (jsonConfigBuffer == nullptr) {
+            ble_protocol_status(STATUS_ERROR, "Memory allocation failed");
+            BLE_LOG("[BLE CONFIG] ERROR: Failed to allocate JSON buffer!\n");
+            return;
+        }
+    }
+
+    // Buffer JSON for processing in main loop (NOT in callback - avoids stack overflow)
+    if (len < BLE_PROTOCOL_JSON_MAX) {
+        memcpy(jsonConfigBuffer, data, len);
+        jsonConfigLength = len;
+        jsonConfigReady = true;
+        ble_protocol_status(STATUS_PROCESSING_CONFIG, "Config queued");
+    } else {
+        ble_protocol_status(STATUS_ERROR, "JSON too large");
+        BLE_LOG("[BLE CONFIG] ERROR: JSON too large!\n");
+    }
+}
+
+/**
+ * Replace the live config with the closed part file, reporting the outcome
+ */
+static bool commitConfig(bool cbor, uint32_t length, uint32_t crc) {
+    if (!ops.config_commit(ops.ctx, cbor, length, crc)) {
+        ble_protocol_status(STATUS_ERROR, "Write failed");
+        return false;
+    }
+    ble_protocol_status(STATUS_SUCCESS, "Config saved");
+    return true;
+}
+
+/**
+ * Drop the framed upload in progress, reporting why
+ */
+static void failConfigUpload(const char* reason) {
+    if (configUpload.active) {
+        ops.config_close(ops.ctx, false);
+        configUpload.active = false;
+    }
+    ble_protocol_status(STATUS_ERROR, reason);
+    BLE_LOG("[BLE CONFIG] ✗ Upload failed: %s\n", reason);
+}
+
+// The schedule only has to be well formed here; it is parsed when loaded
+static bool countConfigEvent(void* ctx, const char* object, size_t len) {
+    (void)ctx;
+    (void)object;
+    (void)len;
+    return true;
+}
+
+/**
+ * Decoded document bytes: checked against the announced size, written to the
+ * part file and, for JSON, split into events as they arrive
+ */
+static bool configOutput(void* ctx, const uint8_t* data, size_t len) {
+    (void)ctx;
+    if (configUpload.written + len > configUpload.size) {
+        configUpload.error = "Config larger than announced";
+        return false;
+    }
+    configUpload.runningCrc = crc32_update(configUpload.runningCrc, data, len);
+    configUpload.written += len;
+    if (!configUpload.cbor) json_event_stream_feed(&configUpload.events, (const char*)data, len);
+    if (!ops.config_write(ops.ctx, data, len)) {
+        configUpload.error = "Write failed";
+        return false;
+    }
+    return true;
+}
+
+static void configBegin(const uint8_t* frame, size_t len) {
+    if (configUpload.active) {
+        ops.config_close(ops.ctx, false);
+        configUpload.active = false;
+    }
+    if (len < 10) {
+        failConfigUpload("Bad config BEGIN");
+        return;
+    }
+
+    uint8_t flags = frame[1];
+    uint32_t size = readLE32(frame + 2);
+    if (size > BLE_PROTOCOL_CONFIG_MAX) {
+        failConfigUpload("Config too large");
+        return;
+    }
+    if ((flags & CONFIG_FLAG_LZ4) && !configLz4) {
+        configLz4 = (Lz4Stream*)PSRAM_ALLOC(sizeof(Lz4Stream));
+        if (!configLz4) {
+            failConfigUpload("Memory allocation failed");
+            return;
+        }
+    }
+
+    configUpload.cbor = (flags & CONFIG_FLAG_CBOR) != 0;
+    if (!ops.config_open(ops.ctx, configUpload.cbor)) {
+        failConfigUpload("Failed to open config file");
+        return;
+    }
+    configUpload.active = true;
+    configUpload.compressed = (flags & CONFIG_FLAG_LZ4) != 0;
+    configUpload.size = size;
+    configUpload.crc = readLE32(frame + 6);
+    configUpload.received = 0;
+    configUpload.written = 0;
+    configUpload.runningCrc = 0;
+    configUpload.error = nullptr;
+    json_event_stream_init(&configUpload.events, countConfigEvent, nullptr);
+    if (configUpload.compressed) lz4_stream_init(configLz4, configOutput, nullptr);
+
+    ble_protocol_status(STATUS_RECEIVING_JSON, "Config upload started");
+    BLE_LOG("[BLE CONFIG] Upload started: %lu bytes of %s%s\n", (unsigned long)size,
+            configUpload.cbor ? "CBOR" : "JSON", configUpload.compressed ? " (LZ4)" : "");
+}
+
+static void configData(const uint8_t* frame, size_t len) {
+    if (!configUpload.active) return;   // Already failed and reported
+    if (len < 5 || readLE32(frame + 1) != configUpload.received) {
+        failConfigUpload("Config fragment missing");
+        return;
+    }
+
+    const uint8_t* data = frame + 5;
+    size_t n = len - 5;
+    configUpload.received += n;
+    bool ok = configUpload.compressed ? lz4_stream_feed(configLz4, data, n)
+                                      : configOutput(nullptr, data, n);
+    if (!ok) {
+        failConfigUpload(configUpload.error ? configUpload.error : "Config data corrupt");
+    }
+}
+
+static void configCommit() {
+    if (!configUpload.active) return;
+    configUpload.active = false;
+
+    bool ended = !configUpload.compressed || lz4_stream_complete(configLz4);
+    if (!ended || configUpload.written != configUpload.size) {
+        ops.config_close(ops.ctx, false);
+        ble_protocol_status(STATUS_ERROR, "Config incomplete");
+        BLE_LOG("[BLE CONFIG] ✗ Incomplete: %lu of %lu bytes\n",
+                (unsigned long)configUpload.written, (unsigned long)configUpload.size);
+        return;
+    }
+    if (configUpload.runningCrc != configUpload.crc) {
+        ops.config_close(ops.ctx, false);
+        ble_protocol_status(STATUS_ERROR, "Config CRC mismatch");
+        BLE_LOG("[BLE CONFIG] ✗ CRC mismatch: received 0x%08lx, expected 0x%08lx\n",
+                (unsigned long)configUpload.runningCrc, (unsigned long)configUpload.crc);
+        return;
+    }
+    ops.config_close(ops.ctx, true);
+
+    // JSON was checked as it arrived; CBOR is decoded from storage in one pass
+    size_t events = configUpload.events.objects;
+    bool wellFormed = configUpload.cbor ? ops.config_count_cbor(ops.ctx, &events)
+                                        : json_event_stream_done(&configUpload.events);
+    if (!wellFormed) {
+        ops.config_close(ops.ctx, false);
+        ble_protocol_status(STATUS_ERROR, "Config has no events");
+        BLE_LOG("[BLE CONFIG] ✗ No complete \"events\" array\n");
+        return;
+    }
+
+    BLE_LOG("[BLE CONFIG] Upload received: %lu bytes sent, %lu bytes of %s, %u events\n",
+            (unsigned long)configUpload.received, (unsigned long)configUpload.written,
+            configUpload.cbor ? "CBOR" : "JSON", (unsigned int)events);
+    commitConfig(configUpload.cbor, configUpload.written, configUpload.crc);
+}
+
+/**
+ * Assemble framed config uploads queued by the transport's task
+ */
+static void processConfigFrames() {
+    if (!configQueue.packets) {
+        return;
+    }
+
+    // Uploads do not survive a disconnect; the phone starts again with BEGIN
+    if (configLinkLost) {
+        configLinkLost = false;
+        configQueue.head = configQueue.tail;
+        if (configUpload.active) {
+            ops.config_close(ops.ctx, false);
+            configUpload.active = false;
+        }
+    }
+
+    // A dropped frame would leave a gap; fail now rather than on its successor
+    if (configQueue.drops) {
+        configQueue.drops = 0;
+        if (configUpload.active) failConfigUpload("Config queue overflow");
+    }
+
+    BLEDataPacket* pkt;
+    while ((pkt = queuePeek(configQueue)) != nullptr) {
+        switch (pkt->data[0]) {
+            case CONFIG_FRAME_BEGIN:  configBegin(pkt->data, pkt->length); break;
+            case CONFIG_FRAME_DATA:   configData(pkt->data, pkt->length); break;
+            case CONFIG_FRAME_COMMIT: configCommit(); break;
+            case CONFIG_FRAME_ABORT:
+                if (configUpload.active) failConfigUpload("Config upload aborted");
+                break;
+        }
+        queuePop(configQueue);
+    }
+}
+
+void ble_protocol_process_config() {
+    processConfigFrames();
+
+    if (!jsonConfigReady) {
+        return;
+    }
+
+    jsonConfigReady = false;  // Clear flag immediately
+
+    // Check the app's CRC trailer, if sent, before touching storage
+    size_t jsonLength = jsonConfigLength;
+    uint32_t expectedCrc = 0;
+    bool haveCrc = false;
+    size_t trailerLen = strlen(CONFIG_CRC_TRAILER);
+    if (jsonLength >= trailerLen + 8) {
+        size_t at = jsonLength - trailerLen - 8;
+        char hex[9];
+        memcpy(hex, jsonConfigBuffer + at + trailerLen, 8);
+        hex[8] = '\0';
+        char* end = nullptr;
+        uint32_t value = strtoul(hex, &end, 16);
+        if (memcmp(jsonConfigBuffer + at, CONFIG_CRC_TRAILER, trailerLen) == 0 && end == hex + 8) {
+            expectedCrc = value;
+            haveCrc = true;
+            jsonLength = at;
+        }
+    }
+    uint32_t crc = crc32_update(0, jsonConfigBuffer, jsonLength);
+    if (haveCrc && crc != expectedCrc) {
+        ble_protocol_status(STATUS_ERROR, "Config CRC mismatch");
+        BLE_LOG("[BLE CONFIG] ✗ CRC mismatch: received 0x%08lx, expected 0x%08lx\n",
+                (unsigned long)crc, (unsigned long)expectedCrc);
+        return;
+    }
+    if (!haveCrc) {
+        BLE_LOG("[BLE CONFIG] WARNING: No CRC trailer, saving unverified\n");
+    }
+
+    // Save next to the live file (full stack available here)
+    if (!ops.config_open(ops.ctx, false)) {
+        ble_protocol_status(STATUS_ERROR, "Failed to open config file");
+        return;
+    }
+    bool written = ops.config_write(ops.ctx, (const uint8_t*)jsonConfigBuffer, jsonLength);
+    ops.config_close(ops.ctx, written);
+    if (!written) {
+        ble_protocol_status(STATUS_ERROR, "Write failed");
+        return;
+    }
+    commitConfig(false, jsonLength, crc);
+}
+
+// ============ TIME SYNC ============
+
+static void timeSyncWrite(const uint8_t* data, size_t len) {
+    char text[32];
+    if (len < 8 || len >= sizeof(text)) {
+        BLE_LOG("[BLE TIME] ERROR: Invalid time format\n");
+        ble_protocol_status(STATUS_ERROR, "Invalid time format");
+        return;
+    }
+    memcpy(text, data, len);
+    text[len] = '\0';
+
+    // "TIME:<seconds>" or the plain number
+    unsigned long long unixTimestamp = 0;
+    if (sscanf(text, "TIME:%llu", &unixTimestamp) == 1 || sscanf(text, "%llu", &unixTimestamp) == 1) {
+        ops.time_sync(ops.ctx, unixTimestamp);
+        BLE_LOG("[BLE TIME] ✓ Time synced: %llu\n", unixTimestamp);
+        ble_protocol_status(STATUS_SUCCESS, "Time synced");
+    } else {
+        BLE_LOG("[BLE TIME] ERROR: Failed to parse timestamp from: %s\n", text);
+        ble_protocol_status(STATUS_ERROR, "Parse failed");
+    }
+}
+
+// ============ FILE TRANSFER ============
+
+static void fileSendFrame(void* ctx, const uint8_t* frame, size_t len) {
+    (void)ctx;
+    if (!connected) return;
+    ble_protocol_send(BLE_CHANNEL_STATUS, frame, len);
+}
+
+static bool fileStart(void* ctx, XferHeader* header) {
+    (void)ctx;
+    // Chunks must fit one write at the negotiated MTU (3 bytes of ATT header)
+    uint16_t mtu = transport.mtu ? transport.mtu(transport.ctx) : 0;
+    if (mtu > 3 + XFER_DATA_HEADER && header->chunk > mtu - 3 - XFER_DATA_HEADER) {
+        header->chunk = mtu - 3 - XFER_DATA_HEADER;
+    }
+    if (header->name[0] == '\0' || strchr(header->name, '/')) {
+        ble_protocol_status(STATUS_ERROR, "Invalid filename");
+        return false;
+    }
+
+    // READY tells the phone where to resume (chunk 0 for a fresh start)
+    uint32_t stored = 0;
+    if (!ops.file_open(ops.ctx, header, &stored)) {
+        ble_protocol_status(STATUS_ERROR, "Cannot open file");
+        return false;
+    }
+    // Stored data always ends on a chunk boundary, or at the end of the file
+    header->resume = stored >= header->size ? (header->size + header->chunk - 1) / header->chunk
+                                            : stored / header->chunk;
+    BLE_LOG("[BLE FILE] Transfer %lu: %s, %lu bytes, %u byte chunks, window %u, resume at chunk %lu\n",
+            (unsigned long)header->id, header->name, (unsigned long)header->size, header->chunk,
+            header->window, (unsigned long)header->resume);
+    ble_protocol_status(STATUS_RECEIVING_FILE, header->name);
+    return true;
+}
+
+static bool fileData(void* ctx, const uint8_t* data, size_t len) {
+    (void)ctx;
+    return ops.file_write(ops.ctx, data, len);
+}
+
+static bool fileEnd(void* ctx, XferEnd how) {
+    (void)ctx;
+    static const char* const names[] = {"Complete", "Cancelled", "Suspended"};
+    BLE_LOG("[BLE FILE] %s: %lu duplicates, %lu out of window, %lu SACKs, %lu queue drops\n",
+            names[how], (unsigned long)fileReceiver.duplicates, (unsigned long)fileReceiver.out_of_window,
+            (unsigned long)fileReceiver.sacks_sent, (unsigned long)fileQueue.drops);
+    fileQueue.drops = 0;
+
+    if (how != XFER_END_COMPLETE) {
+        ops.file_close(ops.ctx, how);
+        if (how == XFER_END_CANCELLED) ble_protocol_status(STATUS_ERROR, "Transfer cancelled");
+        return true;
+    }
+    if (!ops.file_finish(ops.ctx)) {
+        ble_protocol_status(STATUS_ERROR, "Verification failed");
+        return false;
+    }
+    char statusMsg[96];
+    snprintf(statusMsg, sizeof(statusMsg), "Complete: %s", fileReceiver.header.name);
+    ble_protocol_status(STATUS_TRANSFER_COMPLETE, statusMsg);
+    return true;
+}
+
+/**
+ * Image manifest frames; the reply goes where the transfer's frames do
+ */
+static void processImageSync(const uint8_t* frame, size_t len) {
+    if (frame[0] == IMAGE_SYNC_OP_ENTRY) {
+        const size_t fixed = 3 + IMAGE_SYNC_HASH_LEN;   // op, seq, hash, name_len
+        size_t nameLen = len >= fixed ? frame[fixed - 1] : 0;
+        if (len < fixed || len < fixed + nameLen || nameLen > IMAGE_SYNC_NAME_MAX) {
+            return;
+        }
+        char name[IMAGE_SYNC_NAME_MAX + 1];
+        memcpy(name, frame + fixed, nameLen);
+        name[nameLen] = '\0';
+
+        bool present = false;
+        if (!ops.image_entry(ops.ctx, frame[1], frame + 2, name, &present)) {
+            BLE_LOG("[IMAGE SYNC] Rejected entry %u: %s\n", frame[1], name);
+            return;
+        }
+        uint8_t reply[3] = {IMAGE_SYNC_OP_HAVE, frame[1], present};
+        fileSendFrame(nullptr, reply, sizeof(reply));
+    } else if (len >= 2) {
+        uint8_t missing = 0;
+        uint8_t removed = 0;
+        bool ok = ops.image_commit(ops.ctx, frame[1], &missing, &removed);
+        uint8_t reply[4] = {IMAGE_SYNC_OP_SYNCED, ok, missing, removed};
+        fileSendFrame(nullptr, reply, sizeof(reply));
+    }
+}
+
+void ble_protocol_process_file(uint32_t now_ms) {
+    if (!fileQueue.packets) {
+        return;
+    }
+
+    // A dropped link suspends the transfer; the phone resumes it with the same START
+    if (fileLinkLost) {
+        fileLinkLost = false;
+        fileQueue.head = fileQueue.tail;
+        xfer_receiver_abort(&fileReceiver);
+    }
+
+    BLEDataPacket* pkt;
+    while ((pkt = queuePeek(fileQueue)) != nullptr) {
+        if (pkt->data[0] == IMAGE_SYNC_OP_ENTRY || pkt->data[0] == IMAGE_SYNC_OP_COMMIT) {
+            processImageSync(pkt->data, pkt->length);
+        } else {
+            xfer_receiver_input(&fileReceiver, pkt->data, pkt->length, now_ms);
+        }
+        queuePop(fileQueue);
+    }
+
+    // Acknowledge what arrived once the phone pauses
+    xfer_receiver_poll(&fileReceiver, now_ms);
+}
+
+// ============ DEVICE STATE ============
+
+void ble_protocol_device_state(DeviceState* state, uint32_t now_ms) {
+    state->flags &= ~DEVICE_STATE_FLAG_TRANSFERRING;
+    state->transfer = DEVICE_STATE_NONE;
+    if (fileReceiver.active) {
+        uint32_t size = fileReceiver.header.size;
+        uint32_t bytes = xfer_receiver_bytes(&fileReceiver);
+        state->flags |= DEVICE_STATE_FLAG_TRANSFERRING;
+        state->transfer = size ? (uint8_t)((uint64_t)bytes * 100 / size) : 0;
+    }
+
+    uint8_t value[DEVICE_STATE_LEN];
+    device_state_encode(state, value);
+    if (!deviceStateValueSet || memcmp(value, deviceStateValue, sizeof(value)) != 0) {
+        memcpy(deviceStateValue, value, sizeof(value));
+        deviceStateValueSet = true;
+        if (transport.set_value) transport.set_value(transport.ctx, BLE_CHANNEL_DEVICE_STATE, value, sizeof(value));
+    }
+
+    if (deviceStateLinkUp) {
+        deviceStateLinkUp = false;
+        device_state_reset(&deviceState);
+    }
+    if (connected && device_state_publish(&deviceState, state, now_ms)) {
+        ble_protocol_send(BLE_CHANNEL_DEVICE_STATE, value, sizeof(value));
+    }
+}
+
+// ============ TRANSPORT EVENTS ============
+
+void ble_protocol_write(BleChannel channel, const uint8_t* data, size_t len) {
+    if (len == 0) {
+        BLE_LOG("[BLE] ERROR: Empty write received\n");
+        return;
+    }
+
+    switch (channel) {
+        case BLE_CHANNEL_CONFIG:
+            configWrite(data, len);
+            break;
+
+        case BLE_CHANNEL_FILE:
+            // Full: dropping is safe, the SACK reports the gap
+            if (len > BLE_PROTOCOL_FRAME_MAX) {
+                BLE_LOG("[BLE FILE] ERROR: %u byte frame exceeds buffer\n", (unsigned int)len);
+                return;
+            }
+            queuePush(fileQueue, data, len);
+            break;
+
+        case BLE_CHANNEL_TIME_SYNC:
+            timeSyncWrite(data, len);
+            break;
+
+        case BLE_CHANNEL_STATUS: {
+            // Could be used for acknowledgements or control messages
+            char text[64];
+            size_t n = len < sizeof(text) - 1 ? len : sizeof(text) - 1;
+            memcpy(text, data, n);
+            text[n] = '\0';
+            BLE_LOG("[BLE] Status write received: %s\n", text);
+            if (strstr(text, "ACK")) {
+                BLE_LOG("[BLE] Received acknowledgement\n");
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void ble_protocol_read(BleChannel channel) {
+    if (channel == BLE_CHANNEL_STATUS && fileReceiver.active && transport.set_value) {
+        char statusMsg[96];
+        snprintf(statusMsg, sizeof(statusMsg), "%d:Transferring %lu bytes",
+                 STATUS_RECEIVING_FILE, (unsigned long)xfer_receiver_bytes(&fileReceiver));
+        transport.set_value(transport.ctx, channel, (const uint8_t*)statusMsg, strlen(statusMsg));
+    }
+}
+
+bool ble_protocol_init(const BleTransport* t, const BleProtocolOps* o) {
+    transport = *t;
+    ops = *o;
+    connected = false;
+    fileLinkLost = false;
+    configLinkLost = false;
+    jsonConfigReady = false;
+    configUpload.active = false;
+    deviceStateValueSet = false;
+    deviceStateLinkUp = false;
+    device_state_reset(&deviceState);
+
+    // File frames are queued from the transport's task; chunks arriving out of order wait in the receiver
+    if (!fileSlots) fileSlots = (uint8_t*)PSRAM_ALLOC(XFER_WINDOW_MAX * XFER_MAX_CHUNK);
+    bool ok = true;
+    if (!queueAlloc(fileQueue) || !fileSlots) {
+        BLE_LOG("[BLE FILE] ERROR: Failed to allocate transfer buffers, file transfer disabled\n");
+        free(fileQueue.packets);
+        free(fileSlots);
+        fileQueue.packets = nullptr;
+        fileSlots = nullptr;
+        ok = false;
+    } else {
+        XferReceiverOps receiverOps = {nullptr, fileSendFrame, fileStart, fileData, fileEnd};
+        xfer_receiver_init(&fileReceiver, &receiverOps, XFER_MAX_CHUNK, fileSlots);
+    }
+    if (!queueAlloc(configQueue)) {
+        BLE_LOG("[BLE CONFIG] ERROR: Failed to allocate config queue, framed uploads disabled\n");
+        ok = false;
+    }
+    return ok;
+}
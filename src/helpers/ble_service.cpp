@@ -1,22 +1,28 @@
 #include "ble_service.h"
+#include "ble_protocol.h"
 #include "ble_file_transfer.h"
+#include "crc32.h"
+#include "schedule_cbor.h"
+#include "image_store.h"
+#include "asset_bundle.h"
 #include "JSON_reader.h"
 #include "JSON_writer.h"
 #include "schedule_manager.h"
+#include "battery_management.h"
 #include <Arduino.h>
 #include "SD_MMC.h"
 #include <nvs_flash.h>
 #include <nvs.h>
 #include <time.h>
 #include "squarelineUI/ui.h"
+#include "ui_view_model.h"
+
+static_assert(IMAGE_SYNC_NAME_MAX == IMAGE_STORE_NAME_MAX && IMAGE_SYNC_HASH_LEN == IMAGE_STORE_HASH_LEN,
+              "image sync frames carry image store names and hashes");
 
 // Global pointers
 static BLEServer* pServer = nullptr;
-static BLECharacteristic* pConfigChar = nullptr;
-static BLECharacteristic* pFileChar = nullptr;
-static BLECharacteristic* pStatusChar = nullptr;
-static BLECharacteristic* pTimeSyncChar = nullptr;
-static bool deviceConnected = false;
+static BLECharacteristic* channelChars[BLE_CHANNEL_COUNT] = {nullptr};
 
 // Time sync management
 #define TIME_SYNC_NVS_NAMESPACE "time_sync"
@@ -28,37 +34,43 @@ static bool firstSyncSinceConnection = true;  // Track if we've had first sync
 static uint32_t lastNVSUpdateMillis = 0;  // Last time we updated NVS with current time
 static bool updateScreen2AfterTimeSync = false;  // Flag to update Screen 2 after time changes
 
-// Buffer for JSON config - deferred to main loop to avoid stack overflow
-// Dynamically allocated from heap/PSRAM to avoid DRAM limits
-#define JSON_BUFFER_SIZE 4096  // Large buffer in heap/PSRAM, not static DRAM
-static char* jsonConfigBuffer = nullptr;
-static size_t jsonConfigLength = 0;
-static volatile bool jsonConfigReady = false;
+// Configs are written next to the live file and renamed into place once verified
+#define CONFIG_PATH "/duration.json"
+#define CONFIG_PART_PATH "/duration.json.part"
+#define SCHEDULE_CBOR_PART_PATH SCHEDULE_CBOR_PATH ".part"
+static File configFile;
+static bool configCbor = false;
 
-// Queue for BLE data chunks - more robust than single buffer
-#define BLE_DATA_BUFFER_SIZE 512
-#define BLE_QUEUE_SIZE 8
+// ============ BLUEDROID TRANSPORT ============
 
-struct BLEDataPacket {
-    uint8_t data[BLE_DATA_BUFFER_SIZE];
-    size_t length;
-};
+static bool bluedroidNotify(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    BLECharacteristic* c = channelChars[channel];
+    if (!c) return false;
+    c->setValue((uint8_t*)data, len);
+    c->notify();
+    return true;
+}
+
+static void bluedroidSetValue(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    BLECharacteristic* c = channelChars[channel];
+    if (c) c->setValue((uint8_t*)data, len);
+}
 
-static BLEDataPacket bleQueue[BLE_QUEUE_SIZE];
-static volatile uint8_t bleQueueHead = 0;
-static volatile uint8_t bleQueueTail = 0;
+static uint16_t bluedroidMtu(void* ctx) {
+    return pServer ? pServer->getPeerMTU(pServer->getConnId()) : 0;
+}
 
 // Server callbacks to track connection state
 class MyServerCallbacks : public BLEServerCallbacks {
     void onConnect(BLEServer* pServer) {
-        deviceConnected = true;
+        ble_protocol_link(true);
         firstSyncSinceConnection = true;  // Reset first sync flag on new connection
         Serial.println("BLE Client Connected");
         updateBLEStatus(STATUS_IDLE, "Connected");
     }
 
     void onDisconnect(BLEServer* pServer) {
-        deviceConnected = false;
+        ble_protocol_link(false);
         Serial.println("BLE Client Disconnected");
         
         // Restart advertising so clients can reconnect
@@ -67,118 +79,179 @@ class MyServerCallbacks : public BLEServerCallbacks {
     }
 };
 
-// Config characteristic callbacks - receives JSON configuration
-class ConfigCharacteristicCallbacks : public BLECharacteristicCallbacks {
+// Every characteristic hands its writes and reads to the protocol handlers (ble_protocol.h)
+class ChannelCallbacks : public BLECharacteristicCallbacks {
+public:
+    explicit ChannelCallbacks(BleChannel channel) : channel(channel) {}
+
     void onWrite(BLECharacteristic *pCharacteristic) {
         std::string rxValue = pCharacteristic->getValue();
-        
-        if (rxValue.length() == 0) {
-            Serial.println("[BLE CONFIG] ERROR: Empty write received");
-            return;
-        }
-        
-        Serial.println("\n======================================");
-        Serial.println("[BLE CONFIG] Received JSON data:");
-        Serial.println("======================================");
-        Serial.println((const char*)rxValue.c_str());
-        Serial.println("======================================\n");
-        
-        // Allocate buffer on first use (from heap/PSRAM, not static DRAM)
-        if (jsonConfigBuffer == nullptr) {
-            jsonConfigBuffer = (char*)malloc(JSON_BUFFER_SIZE);
-            if (jsonConfigBuffer == nullptr) {
-                updateBLEStatus(STATUS_ERROR, "Memory allocation failed");
-                Serial.println("[BLE CONFIG] ERROR: Failed to allocate JSON buffer!");
-                return;
-            }
-        }
-        
-        // Buffer JSON for processing in main loop (NOT in callback - avoids stack overflow)
-        if (rxValue.length() < JSON_BUFFER_SIZE) {
-            memcpy(jsonConfigBuffer, rxValue.c_str(), rxValue.length());
-            jsonConfigLength = rxValue.length();
-            jsonConfigReady = true;
-            updateBLEStatus(STATUS_PROCESSING_CONFIG, "Config queued");
-        } else {
-            updateBLEStatus(STATUS_ERROR, "JSON too large");
-            Serial.println("[BLE CONFIG] ERROR: JSON too large!");
-        }
+        ble_protocol_write(channel, (const uint8_t*)rxValue.data(), rxValue.length());
     }
 
     void onRead(BLECharacteristic *pCharacteristic) {
-        Serial.println("[BLE CONFIG] Config characteristic read");
+        ble_protocol_read(channel);
     }
+
+private:
+    BleChannel channel;
 };
 
-// File transfer characteristic callbacks - receives image files
-class FileTransferCharacteristicCallbacks : public BLECharacteristicCallbacks {
-    void onWrite(BLECharacteristic *pCharacteristic) {
-        std::string rxValue = pCharacteristic->getValue();
-        
-        if (rxValue.length() == 0) {
-            return;
-        }
+// ============ STORAGE ============
+
+static const char* configPartPath(bool cbor) {
+    return cbor ? SCHEDULE_CBOR_PART_PATH : CONFIG_PART_PATH;
+}
 
-        Serial.printf("[BLE FILE] Received %d bytes (file transfer not yet implemented)\n", (int)rxValue.length());
-        // TODO: Implement file transfer with proper protocol
+static bool storageConfigOpen(void* ctx, bool cbor) {
+    configCbor = cbor;
+    configFile = SD_MMC.open(configPartPath(cbor), FILE_WRITE);
+    if (!configFile) {
+        Serial.printf("[BLE CONFIG] ERROR: Failed to open %s for writing\n", configPartPath(cbor));
+        return false;
     }
-};
+    return true;
+}
 
-// Status characteristic callbacks - reports device status
-class StatusCharacteristicCallbacks : public BLECharacteristicCallbacks {
-    void onRead(BLECharacteristic *pCharacteristic) {
-        if (isFileTransferring()) {
-            char statusMsg[96];
-            uint32_t progress = getTransferProgress();
-            snprintf(statusMsg, sizeof(statusMsg), "%d:Transferring %lu bytes", 
-                     STATUS_RECEIVING_FILE, progress);
-            pCharacteristic->setValue(statusMsg);
+static bool storageConfigWrite(void* ctx, const uint8_t* data, size_t len) {
+    return configFile.write(data, len) == len;
+}
+
+static void storageConfigClose(void* ctx, bool keep) {
+    if (configFile) configFile.close();
+    if (!keep) SD_MMC.remove(configPartPath(configCbor));
+}
+
+static size_t readFromFile(void* ctx, uint8_t* buf, size_t len) {
+    return ((File*)ctx)->read(buf, len);
+}
+
+static bool storageConfigCountCbor(void* ctx, size_t* events) {
+    File f = SD_MMC.open(SCHEDULE_CBOR_PART_PATH, FILE_READ);
+    bool ok = f && schedule_cbor_decode(readFromFile, &f, nullptr, 0, events);
+    f.close();
+    return ok;
+}
+
+/**
+ * Read back the closed part file; only a file whose size and CRC match
+ * replaces the live config, and the schedule in the other format is removed
+ */
+static bool storageConfigCommit(void* ctx, bool cbor, uint32_t length, uint32_t crc) {
+    const char* partPath = configPartPath(cbor);
+    const char* path = cbor ? SCHEDULE_CBOR_PATH : CONFIG_PATH;
+    uint32_t storedCrc = 0;
+    uint32_t storedLength = 0;
+    File f = SD_MMC.open(partPath, FILE_READ);
+    if (f) {
+        uint8_t buf[256];
+        size_t n;
+        while ((n = f.read(buf, sizeof(buf))) > 0) {
+            storedCrc = crc32_update(storedCrc, buf, n);
+            storedLength += n;
         }
-        Serial.println("[BLE] Status characteristic read");
+        f.close();
+    }
+    
+    if (storedLength != length || storedCrc != crc) {
+        SD_MMC.remove(partPath);
+        Serial.printf("[BLE CONFIG] ✗ Error: Stored %lu of %lu bytes, CRC 0x%08lx\n",
+                      storedLength, length, storedCrc);
+        return false;
     }
+    
+    // Set the live schedule aside until the new one is in place, so a failed
+    // rename leaves the device with the old schedule rather than none
+    char oldPath[48];
+    snprintf(oldPath, sizeof(oldPath), "%s.old", path);
+    SD_MMC.remove(oldPath);
+    bool hadLive = SD_MMC.exists(path);
+    if (hadLive && !SD_MMC.rename(path, oldPath)) {
+        SD_MMC.remove(partPath);
+        Serial.printf("[BLE CONFIG] ✗ Error: Could not set %s aside\n", path);
+        return false;
+    }
+    if (!SD_MMC.rename(partPath, path)) {
+        if (hadLive) SD_MMC.rename(oldPath, path);
+        SD_MMC.remove(partPath);
+        Serial.printf("[BLE CONFIG] ✗ Error: Could not rename %s into place\n", partPath);
+        return false;
+    }
+    if (hadLive) SD_MMC.remove(oldPath);
+    SD_MMC.remove(cbor ? CONFIG_PATH : SCHEDULE_CBOR_PATH);
+    Serial.printf("[BLE CONFIG] ✓ Success: Saved %lu bytes to %s (CRC 0x%08lx)\n", length, path, crc);
+    
+    // Invalidate schedule cache so next call to updateScheduleDisplay reloads from SD card
+    invalidateScheduleCache();
+    
+    // Reload schedule from the newly saved file and update Screen 2 display
+    view_model_publish(VM_TOPIC_SCHEDULE);
+    Serial.println("[BLE CONFIG] ✓ Updated Screen 2 with new schedule");
+    return true;
+}
 
-    void onWrite(BLECharacteristic *pCharacteristic) {
-        std::string rxValue = pCharacteristic->getValue();
-        Serial.printf("[BLE] Status write received: %s\n", rxValue.c_str());
-        
-        // Could be used for acknowledgements or control messages
-        if (rxValue.find("ACK") != std::string::npos) {
-            Serial.println("[BLE] Received acknowledgement");
-        }
+static void storageTimeSync(void* ctx, uint64_t unixTime) {
+    syncTimeFromPhone(unixTime);
+}
+
+static bool storageFileOpen(void* ctx, XferHeader* header, uint32_t* stored) {
+    *stored = openFileTransfer(header->name, header->size, header->id, header->crc, &header->chunk);
+    return isFileTransferring();
+}
+
+static bool storageFileWrite(void* ctx, const uint8_t* data, size_t len) {
+    receiveFileChunk(data, len);
+    return isFileTransferring();
+}
+
+static bool storageFileFinish(void* ctx) {
+    if (!isFileTransferComplete()) return false;
+    if (strcmp(getCurrentFilename(), ASSET_BUNDLE_FILE) == 0) {
+        // Events now resolve to the new bundle's images
+        view_model_publish(VM_TOPIC_SCHEDULE);
     }
-};
+    Serial.println("[BLE] File transfer complete");
+    return true;
+}
 
-// Time sync characteristic callbacks - receives Unix timestamp from phone
-class TimeSyncCharacteristicCallbacks : public BLECharacteristicCallbacks {
-    void onWrite(BLECharacteristic *pCharacteristic) {
-        std::string rxValue = pCharacteristic->getValue();
-        
-        if (rxValue.length() < 8) {
-            Serial.println("[BLE TIME] ERROR: Invalid time format");
-            updateBLEStatus(STATUS_ERROR, "Invalid time format");
-            return;
-        }
-        
-        uint64_t unixTimestamp = 0;
-        
-        // Try parsing with "TIME:" prefix first
-        if (sscanf(rxValue.c_str(), "TIME:%llu", &unixTimestamp) == 1) {
-            syncTimeFromPhone(unixTimestamp);
-            Serial.printf("[BLE TIME] ✓ Time synced: %llu\n", unixTimestamp);
-            updateBLEStatus(STATUS_SUCCESS, "Time synced");
-        }
-        // Try parsing as plain number (no prefix)
-        else if (sscanf(rxValue.c_str(), "%llu", &unixTimestamp) == 1) {
-            syncTimeFromPhone(unixTimestamp);
-            Serial.printf("[BLE TIME] ✓ Time synced: %llu\n", unixTimestamp);
-            updateBLEStatus(STATUS_SUCCESS, "Time synced");
-        }
-        else {
-            Serial.printf("[BLE TIME] ERROR: Failed to parse timestamp from: %s\n", rxValue.c_str());
-            updateBLEStatus(STATUS_ERROR, "Parse failed");
-        }
+static void storageFileClose(void* ctx, XferEnd how) {
+    if (how == XFER_END_CANCELLED) {
+        cancelFileTransfer();
+    } else {
+        suspendFileTransfer();
     }
-};
+}
+
+static bool storageImageEntry(void* ctx, uint8_t seq, const uint8_t* hash, const char* name, bool* present) {
+    return image_store_sync_entry(seq, hash, name, present);
+}
+
+static bool storageImageCommit(void* ctx, uint8_t count, uint8_t* missing, uint8_t* removed) {
+    ImageStoreSyncResult result;
+    bool ok = image_store_sync_commit(count, &result);
+    *missing = result.missing;
+    *removed = result.removed;
+    
+    // Same names, new pictures: redraw the schedule's images
+    if (ok && result.changed) {
+        view_model_publish(VM_TOPIC_SCHEDULE);
+    }
+    return ok;
+}
+
+/**
+ * Create a characteristic whose writes and reads go to the protocol handlers
+ */
+static BLECharacteristic* createChannel(BLEService* service, BleChannel channel, const char* uuid,
+                                        uint32_t properties) {
+    BLECharacteristic* c = service->createCharacteristic(uuid, properties);
+    c->setCallbacks(new ChannelCallbacks(channel));
+    if (properties & BLECharacteristic::PROPERTY_NOTIFY) {
+        c->addDescriptor(new BLE2902());
+    }
+    channelChars[channel] = c;
+    return c;
+}
 
 /**
  * Initialize the BLE service with all characteristics
@@ -186,6 +259,16 @@ class TimeSyncCharacteristicCallbacks : public BLECharacteristicCallbacks {
 void initBLEService() {
     Serial.println("Initializing BLE Service...");
     
+    static const BleTransport transport = {nullptr, bluedroidNotify, bluedroidSetValue, bluedroidMtu};
+    static const BleProtocolOps ops = {
+        nullptr,
+        storageConfigOpen, storageConfigWrite, storageConfigClose, storageConfigCountCbor, storageConfigCommit,
+        storageTimeSync,
+        storageFileOpen, storageFileWrite, storageFileFinish, storageFileClose,
+        storageImageEntry, storageImageCommit
+    };
+    ble_protocol_init(&transport, &ops);
+    
     // Initialize BLE device
     BLEDevice::init("CrockerDisplay");
     BLEDevice::setMTU(512);
@@ -198,53 +281,48 @@ void initBLEService() {
     BLEService *pService = pServer->createService(SERVICE_UUID);
     
     // Create Config Characteristic (JSON configuration)
-    pConfigChar = pService->createCharacteristic(
-        CONFIG_CHAR_UUID,
+    createChannel(pService, BLE_CHANNEL_CONFIG, CONFIG_CHAR_UUID,
         BLECharacteristic::PROPERTY_READ |
         BLECharacteristic::PROPERTY_WRITE |
         BLECharacteristic::PROPERTY_NOTIFY
-    );
-    pConfigChar->setCallbacks(new ConfigCharacteristicCallbacks());
-    pConfigChar->setValue("Ready for config");
-    pConfigChar->addDescriptor(new BLE2902());
+    )->setValue("Ready for config");
     
     Serial.println("  ✓ Config Characteristic created");
     
-    // Create File Transfer Characteristic (binary image files)
-    pFileChar = pService->createCharacteristic(
-        FILE_TRANSFER_CHAR_UUID,
+    // Create File Transfer Characteristic (binary image files, streamed without responses)
+    createChannel(pService, BLE_CHANNEL_FILE, FILE_TRANSFER_CHAR_UUID,
         BLECharacteristic::PROPERTY_WRITE |
+        BLECharacteristic::PROPERTY_WRITE_NR |
         BLECharacteristic::PROPERTY_NOTIFY
     );
-    pFileChar->setCallbacks(new FileTransferCharacteristicCallbacks());
-    pFileChar->addDescriptor(new BLE2902());
     
     Serial.println("  ✓ File Transfer Characteristic created");
     
     // Create Status Characteristic (device status & handshake)
-    pStatusChar = pService->createCharacteristic(
-        STATUS_CHAR_UUID,
+    createChannel(pService, BLE_CHANNEL_STATUS, STATUS_CHAR_UUID,
         BLECharacteristic::PROPERTY_READ |
         BLECharacteristic::PROPERTY_WRITE |
         BLECharacteristic::PROPERTY_NOTIFY
-    );
-    pStatusChar->setCallbacks(new StatusCharacteristicCallbacks());
-    pStatusChar->addDescriptor(new BLE2902());
-    pStatusChar->setValue("IDLE");
+    )->setValue("IDLE");
     
     Serial.println("  ✓ Status Characteristic created");
     
     // Create Time Sync Characteristic (receive current time from phone)
-    pTimeSyncChar = pService->createCharacteristic(
-        TIME_SYNC_CHAR_UUID,
+    createChannel(pService, BLE_CHANNEL_TIME_SYNC, TIME_SYNC_CHAR_UUID,
         BLECharacteristic::PROPERTY_WRITE |
         BLECharacteristic::PROPERTY_READ
-    );
-    pTimeSyncChar->setCallbacks(new TimeSyncCharacteristicCallbacks());
-    pTimeSyncChar->setValue("TIME:0000000000");
+    )->setValue("TIME:0000000000");
     
     Serial.println("  ✓ Time Sync Characteristic created");
     
+    // Create Device State Characteristic (binary record, notified on change; device_state.h)
+    createChannel(pService, BLE_CHANNEL_DEVICE_STATE, DEVICE_STATE_CHAR_UUID,
+        BLECharacteristic::PROPERTY_READ |
+        BLECharacteristic::PROPERTY_NOTIFY
+    );
+    
+    Serial.println("  ✓ Device State Characteristic created");
+    
     // Start service
     pService->start();
     
@@ -265,35 +343,16 @@ void initBLEService() {
  * Update the status characteristic and notify connected clients
  */
 void updateBLEStatus(BLEStatus status, const char* message) {
-    if (!pStatusChar) {
-        return;
-    }
-    
-    char statusMsg[128];
-    if (message) {
-        snprintf(statusMsg, sizeof(statusMsg), "%d:%s", status, message);
-    } else {
-        snprintf(statusMsg, sizeof(statusMsg), "%d", status);
-    }
-    
-    pStatusChar->setValue(statusMsg);
-    pStatusChar->notify();
-    
-    Serial.printf("[BLE Status] %s\n", statusMsg);
+    ble_protocol_status(status, message);
 }
 
 /**
  * Send configuration JSON over BLE (for clients to read)
  */
 void sendConfigOverBLE(const char* jsonData) {
-    if (!pConfigChar) {
-        return;
+    if (ble_protocol_send(BLE_CHANNEL_CONFIG, (const uint8_t*)jsonData, strlen(jsonData))) {
+        Serial.println("[BLE] Config sent to connected clients");
     }
-    
-    pConfigChar->setValue(jsonData);
-    pConfigChar->notify();
-    
-    Serial.println("[BLE] Config sent to connected clients");
 }
 
 /**
@@ -301,25 +360,33 @@ void sendConfigOverBLE(const char* jsonData) {
  * Call this from the main loop to handle buffered data without stack overflow
  */
 void processBLEFileData() {
-    // Process all queued packets
-    while (bleQueueHead != bleQueueTail) {
-        // Get packet from queue
-        BLEDataPacket* pkt = &bleQueue[bleQueueHead];
-        
-        // Process the buffered data in main loop context with full stack
-        receiveFileChunk(pkt->data, pkt->length);
-        
-        // Move to next packet
-        bleQueueHead = (bleQueueHead + 1) % BLE_QUEUE_SIZE;
-        
-        // Check if transfer is complete
-        if (isFileTransferComplete()) {
-            char statusMsg[64];
-            snprintf(statusMsg, sizeof(statusMsg), "Complete: %s", getCurrentFilename());
-            updateBLEStatus(STATUS_TRANSFER_COMPLETE, statusMsg);
-            Serial.println("[BLE] File transfer complete");
-        }
+    ble_protocol_process_file(millis());
+}
+
+/**
+ * Sample the schedule position, battery and clock into the device state
+ * characteristic; ble_protocol notifies it when something changed
+ */
+void updateBLEDeviceState() {
+    static uint32_t lastSample = 0;
+    static bool sampled = false;
+    uint32_t now = millis();
+    if (sampled && now - lastSample < DEVICE_STATE_SAMPLE_MS) {
+        return;
     }
+    lastSample = now;
+    sampled = true;
+
+    DeviceState state = {};
+    int current, next;
+    state.schedule_generation = getSchedulePosition(&current, &next, &state.seconds_remaining);
+    state.current_event = current >= 0 ? (uint8_t)current : DEVICE_STATE_NONE;
+    state.next_event = next >= 0 ? (uint8_t)next : DEVICE_STATE_NONE;
+    if (current >= 0) state.flags |= DEVICE_STATE_FLAG_EVENT_ACTIVE;
+    if (isTimeValid()) state.flags |= DEVICE_STATE_FLAG_TIME_VALID;
+    if (!get_sampled_battery_percentage(&state.battery)) state.battery = DEVICE_STATE_NONE;
+
+    ble_protocol_device_state(&state, now);
 }
 
 /**
@@ -327,46 +394,14 @@ void processBLEFileData() {
  * Call this from the main loop, NOT from BLE callbacks
  */
 void processBLEConfig() {
-    if (!jsonConfigReady) {
-        return;
-    }
-    
-    jsonConfigReady = false;  // Clear flag immediately
-    
-    Serial.println("[BLE CONFIG] Processing buffered JSON from main loop...");
-    
-    // Save JSON to SD card (full stack available here)
-    File f = SD_MMC.open("/duration.json", FILE_WRITE);
-    if (!f) {
-        updateBLEStatus(STATUS_ERROR, "Failed to open config file");
-        Serial.println("[BLE CONFIG] ERROR: Failed to open /duration.json for writing");
-        return;
-    }
-    
-    size_t written = f.write((const uint8_t*)jsonConfigBuffer, jsonConfigLength);
-    f.close();
-    
-    if (written == jsonConfigLength) {
-        updateBLEStatus(STATUS_SUCCESS, "Config saved");
-        Serial.printf("[BLE CONFIG] ✓ Success: Saved %d bytes to /duration.json\n", (int)written);
-        
-        // Invalidate schedule cache so next call to updateScheduleDisplay reloads from SD card
-        invalidateScheduleCache();
-        
-        // Reload schedule from the newly saved file and update Screen 2 display
-        ui_Screen2_updateScheduleDisplay();
-        Serial.println("[BLE CONFIG] ✓ Updated Screen 2 with new schedule");
-    } else {
-        updateBLEStatus(STATUS_ERROR, "Write failed");
-        Serial.printf("[BLE CONFIG] ✗ Error: Only wrote %d of %d bytes\n", (int)written, (int)jsonConfigLength);
-    }
+    ble_protocol_process_config();
 }
 
 /**
  * Check if a BLE client is connected
  */
 bool isBLEConnected() {
-    return deviceConnected;
+    return ble_protocol_connected();
 }
 
 /**
@@ -626,9 +661,9 @@ void checkAndSyncScheduleIfNeeded() {
         Serial.println("[SCHEDULE] ======================================\n");
         
         // Send request via Status characteristic (app should be listening)
-        if (pStatusChar && deviceConnected) {
-            pStatusChar->setValue("SCHEDULE_SYNC_REQUEST");
-            pStatusChar->notify();
+        static const char request[] = "SCHEDULE_SYNC_REQUEST";
+        if (ble_protocol_connected() &&
+            ble_protocol_send(BLE_CHANNEL_STATUS, (const uint8_t*)request, sizeof(request) - 1)) {
             Serial.println("[SCHEDULE] ✓ Sync request sent to app");
         }
         
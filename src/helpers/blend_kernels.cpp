@@ -0,0 +1,182 @@
+#include "blend_kernels.h"
+#include <string.h>
+
+// Green in the upper half-word, red and blue in the lower: room for a 5-bit mix per field
+#define SPREAD_MASK 0x07E0F81Fu
+
+#define ROW(ptr, stride, y) ((decltype(ptr))((const uint8_t*)(ptr) + (intptr_t)(stride) * (y)))
+
+static inline uint32_t spread(uint16_t c) {
+    return ((uint32_t)c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+static inline uint16_t unspread(uint32_t c) {
+    return (uint16_t)((c >> 16) | c);
+}
+
+/**
+ * lv_color_16_16_mix() without its early outs, which this formula already
+ * satisfies: mix 0 gives bg, 255 gives fg, and fg == bg gives fg
+ */
+static inline uint16_t mix565(uint32_t fg_spread, uint16_t bg, uint32_t mix5) {
+    uint32_t b = spread(bg);
+    return unspread(((((fg_spread - b) * mix5) >> 5) + b) & SPREAD_MASK);
+}
+
+static inline uint32_t mix_to_5bit(uint32_t mix) {
+    return (mix + 4) >> 3;
+}
+
+static inline uint32_t lane_mix(uint8_t opa, const uint8_t* mask, int32_t x) {
+    if (!mask) return opa;
+    if (opa >= 255) return mask[x];
+    return ((uint32_t)mask[x] * opa) >> 8;
+}
+
+#if BLEND_KERNELS_VECTOR
+// Four lanes: one 128-bit register (SSE2/NEON) per spread vector
+#define LANES 4
+typedef uint16_t v4u16 __attribute__((vector_size(8)));
+typedef uint32_t v4u32 __attribute__((vector_size(16)));
+typedef uint8_t v4u8 __attribute__((vector_size(4)));
+
+static inline v4u32 load_spread(const uint16_t* p) {
+    v4u16 v;
+    memcpy(&v, p, sizeof(v));
+    v4u32 w = __builtin_convertvector(v, v4u32);
+    return (w | (w << 16)) & SPREAD_MASK;
+}
+
+static inline void store_unspread(uint16_t* p, v4u32 c) {
+    v4u16 v = __builtin_convertvector((c >> 16) | c, v4u16);
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline v4u32 load_mix5(uint8_t opa, const uint8_t* mask, int32_t x) {
+    if (!mask) {
+        v4u32 m = {0};
+        return m + mix_to_5bit(opa);
+    }
+    v4u8 b;
+    memcpy(&b, mask + x, sizeof(b));
+    v4u32 m = __builtin_convertvector(b, v4u32);
+    if (opa < 255) m = (m * opa) >> 8;
+    return (m + 4) >> 3;
+}
+
+static inline v4u32 mix_v(v4u32 fg, v4u32 bg, v4u32 mix5) {
+    return ((((fg - bg) * mix5) >> 5) + bg) & SPREAD_MASK;
+}
+#endif
+
+// ============ FILL ============
+
+static void fill_row(uint16_t* d, int32_t w, uint16_t color) {
+    int32_t x = 0;
+    // Align to 4 bytes, then two pixels per 32-bit store
+    if (((uintptr_t)d & 3) && w > 0) {
+        d[0] = color;
+        x = 1;
+    }
+    uint32_t c32 = (uint32_t)color | ((uint32_t)color << 16);
+    for (; x + 8 <= w; x += 8) {
+        memcpy(d + x, &c32, 4);
+        memcpy(d + x + 2, &c32, 4);
+        memcpy(d + x + 4, &c32, 4);
+        memcpy(d + x + 6, &c32, 4);
+    }
+    for (; x + 2 <= w; x += 2) memcpy(d + x, &c32, 4);
+    if (x < w) d[x] = color;
+}
+
+void blend_rgb565_fill(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color) {
+    if (w <= 0) return;
+    // Fill the first row, then copy it
+    fill_row(dest, w, color);
+    for (int32_t y = 1; y < h; y++) {
+        memcpy(ROW(dest, dest_stride, y), dest, (size_t)w * sizeof(uint16_t));
+    }
+}
+
+void blend_rgb565_fill_mix(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride, uint16_t color,
+                           uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    uint32_t fg = spread(color);
+
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t* d = ROW(dest, dest_stride, y);
+        const uint8_t* m = mask ? mask + (intptr_t)mask_stride * y : NULL;
+        int32_t x = 0;
+
+#if BLEND_KERNELS_VECTOR
+        v4u32 fgv = {0};
+        fgv += fg;
+        for (; x + LANES <= w; x += LANES) {
+            v4u32 mix5 = load_mix5(opa, m, x);
+            store_unspread(d + x, mix_v(fgv, load_spread(d + x), mix5));
+        }
+#else
+        if (m && opa >= 255) {
+            // Masks are mostly fully in or out (glyphs, arcs): skip or fill 4 at once
+            for (; x + 4 <= w; x += 4) {
+                uint32_t m4;
+                memcpy(&m4, m + x, sizeof(m4));
+                if (m4 == 0) continue;
+                if (m4 == 0xFFFFFFFFu) {
+                    d[x] = d[x + 1] = d[x + 2] = d[x + 3] = color;
+                    continue;
+                }
+                for (int32_t i = x; i < x + 4; i++) d[i] = mix565(fg, d[i], mix_to_5bit(m[i]));
+            }
+        } else if (!m) {
+            uint32_t mix5 = mix_to_5bit(opa);
+            for (; x < w; x++) d[x] = mix565(fg, d[x], mix5);
+        }
+#endif
+        for (; x < w; x++) d[x] = mix565(fg, d[x], mix_to_5bit(lane_mix(opa, m, x)));
+    }
+}
+
+// ============ COPY ============
+
+void blend_rgb565_copy(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride,
+                       const uint16_t* src, int32_t src_stride) {
+    if (w <= 0) return;
+    for (int32_t y = 0; y < h; y++) {
+        memcpy(ROW(dest, dest_stride, y), ROW(src, src_stride, y), (size_t)w * sizeof(uint16_t));
+    }
+}
+
+void blend_rgb565_copy_mix(uint16_t* dest, int32_t w, int32_t h, int32_t dest_stride,
+                           const uint16_t* src, int32_t src_stride,
+                           uint8_t opa, const uint8_t* mask, int32_t mask_stride) {
+    for (int32_t y = 0; y < h; y++) {
+        uint16_t* d = ROW(dest, dest_stride, y);
+        const uint16_t* s = ROW(src, src_stride, y);
+        const uint8_t* m = mask ? mask + (intptr_t)mask_stride * y : NULL;
+        int32_t x = 0;
+
+#if BLEND_KERNELS_VECTOR
+        for (; x + LANES <= w; x += LANES) {
+            v4u32 mix5 = load_mix5(opa, m, x);
+            store_unspread(d + x, mix_v(load_spread(s + x), load_spread(d + x), mix5));
+        }
+#else
+        if (m && opa >= 255) {
+            for (; x + 4 <= w; x += 4) {
+                uint32_t m4;
+                memcpy(&m4, m + x, sizeof(m4));
+                if (m4 == 0) continue;
+                if (m4 == 0xFFFFFFFFu) {
+                    memcpy(d + x, s + x, 4 * sizeof(uint16_t));
+                    continue;
+                }
+                for (int32_t i = x; i < x + 4; i++) d[i] = mix565(spread(s[i]), d[i], mix_to_5bit(m[i]));
+            }
+        } else if (!m) {
+            uint32_t mix5 = mix_to_5bit(opa);
+            for (; x < w; x++) d[x] = mix565(spread(s[x]), d[x], mix5);
+        }
+#endif
+        for (; x < w; x++) d[x] = mix565(spread(s[x]), d[x], mix_to_5bit(lane_mix(opa, m, x)));
+    }
+}
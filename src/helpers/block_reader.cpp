@@ -0,0 +1,92 @@
+#include "block_reader.h"
+#include <string.h>
+
+static inline uint32_t align_down(uint32_t v) {
+    return v & ~(BLOCK_READER_SECTOR_SIZE - 1);
+}
+
+static int32_t device_read(BlockReader* r, uint32_t offset, uint8_t* buf, uint32_t len) {
+    int32_t n = r->read_at(r->ctx, offset, buf, len);
+    if (r->stats) {
+        r->stats->device_reads++;
+        if (n > 0) r->stats->device_bytes += (uint32_t)n;
+    }
+    return n;
+}
+
+/**
+ * Reload the window so that it starts at the sector containing pos
+ */
+static int32_t refill_window(BlockReader* r, uint32_t pos) {
+    uint32_t start = align_down(pos);
+    uint32_t len = r->window_size;
+    if (start + len > r->file_size) len = r->file_size - start;
+
+    int32_t n = device_read(r, start, r->window, len);
+    if (n < 0) {
+        r->window_len = 0;
+        return n;
+    }
+    r->window_offset = start;
+    r->window_len = (uint32_t)n;
+    return n;
+}
+
+void block_reader_init(BlockReader* r, block_read_at_fn read_at, void* ctx, uint32_t file_size,
+                       uint8_t* window, uint32_t window_size, BlockReaderStats* stats) {
+    r->read_at = read_at;
+    r->ctx = ctx;
+    r->file_size = file_size;
+    r->pos = 0;
+    r->window = window;
+    r->window_size = align_down(window_size);
+    r->window_offset = 0;
+    r->window_len = 0;
+    r->stats = stats;
+}
+
+int32_t block_reader_read(BlockReader* r, void* out, uint32_t len) {
+    uint8_t* dst = (uint8_t*)out;
+    uint32_t total = 0;
+
+    if (r->pos >= r->file_size) return 0;
+    if (len > r->file_size - r->pos) len = r->file_size - r->pos;
+    if (r->stats) r->stats->requested_bytes += len;
+
+    while (len > 0) {
+        // Serve from the window when the position is inside it
+        if (r->pos >= r->window_offset && r->pos < r->window_offset + r->window_len) {
+            uint32_t off = r->pos - r->window_offset;
+            uint32_t n = r->window_len - off;
+            if (n > len) n = len;
+            memcpy(dst, r->window + off, n);
+            dst += n;
+            r->pos += n;
+            len -= n;
+            total += n;
+            continue;
+        }
+
+        // Large remaining read on a sector boundary: one direct transfer of whole sectors
+        if ((r->pos % BLOCK_READER_SECTOR_SIZE) == 0 && len >= r->window_size) {
+            uint32_t direct = align_down(len);
+            int32_t n = device_read(r, r->pos, dst, direct);
+            if (n <= 0) return total > 0 ? (int32_t)total : n;
+            dst += n;
+            r->pos += (uint32_t)n;
+            len -= (uint32_t)n;
+            total += (uint32_t)n;
+            continue;
+        }
+
+        int32_t n = refill_window(r, r->pos);
+        if (n < 0) return total > 0 ? (int32_t)total : n;
+        if (n == 0 || r->pos >= r->window_offset + r->window_len) break;
+    }
+
+    return (int32_t)total;
+}
+
+void block_reader_seek(BlockReader* r, uint32_t pos) {
+    r->pos = pos > r->file_size ? r->file_size : pos;
+}
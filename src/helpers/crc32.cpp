@@ -0,0 +1,47 @@
+#include "crc32.h"
+
+#ifdef ESP_PLATFORM
+#include <esp_rom_crc.h>
+
+uint32_t crc32_update(uint32_t crc, const void* data, size_t len) {
+    return esp_rom_crc32_le(crc, (const uint8_t*)data, (uint32_t)len);
+}
+
+#else
+
+#define CRC32_POLY 0xEDB88320u  // Reflected 0x04C11DB7
+
+// table[k][b]: CRC of byte b followed by k zero bytes
+static uint32_t table[4][256];
+static bool table_ready = false;
+
+static void build_table() {
+    for (uint32_t b = 0; b < 256; b++) {
+        uint32_t c = b;
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (CRC32_POLY & (0u - (c & 1)));
+        table[0][b] = c;
+    }
+    for (uint32_t b = 0; b < 256; b++) {
+        for (int k = 1; k < 4; k++) table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+    }
+    table_ready = true;
+}
+
+uint32_t crc32_update(uint32_t crc, const void* data, size_t len) {
+    if (!table_ready) build_table();
+
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    // Four bytes per step, little-endian byte order regardless of host
+    while (len >= 4) {
+        crc ^= (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+        crc = table[3][crc & 0xFF] ^ table[2][(crc >> 8) & 0xFF] ^
+              table[1][(crc >> 16) & 0xFF] ^ table[0][crc >> 24];
+        p += 4;
+        len -= 4;
+    }
+    while (len--) crc = (crc >> 8) ^ table[0][(crc ^ *p++) & 0xFF];
+    return ~crc;
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "device_state.h"
+
+static void writeLE32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint32_t readLE32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+size_t device_state_encode(const DeviceState* state, uint8_t* out) {
+    out[0] = DEVICE_STATE_VERSION;
+    out[1] = state->flags;
+    writeLE32(out + 2, state->schedule_generation);
+    out[6] = state->current_event;
+    out[7] = state->next_event;
+    writeLE32(out + 8, state->seconds_remaining);
+    out[12] = state->battery;
+    out[13] = state->transfer;
+    return DEVICE_STATE_LEN;
+}
+
+bool device_state_decode(const uint8_t* data, size_t len, DeviceState* state) {
+    if (len < DEVICE_STATE_LEN || data[0] != DEVICE_STATE_VERSION) return false;
+    state->flags = data[1];
+    state->schedule_generation = readLE32(data + 2);
+    state->current_event = data[6];
+    state->next_event = data[7];
+    state->seconds_remaining = readLE32(data + 8);
+    state->battery = data[12];
+    state->transfer = data[13];
+    return true;
+}
+
+void device_state_reset(DeviceStatePublisher* pub) {
+    pub->has_sent = false;
+}
+
+/**
+ * Whether a sample says something the last record sent does not, given that
+ * the phone counts the seconds down itself
+ */
+static bool changed(const DeviceStatePublisher* pub, const DeviceState* s, uint32_t now_ms) {
+    const DeviceState& last = pub->sent;
+    if (s->flags != last.flags || s->schedule_generation != last.schedule_generation ||
+        s->current_event != last.current_event || s->next_event != last.next_event ||
+        s->battery != last.battery || s->transfer != last.transfer) {
+        return true;
+    }
+
+    uint32_t elapsed = (now_ms - pub->sent_ms) / 1000;
+    uint32_t expected = last.seconds_remaining > elapsed ? last.seconds_remaining - elapsed : 0;
+    uint32_t drift = s->seconds_remaining > expected ? s->seconds_remaining - expected
+                                                     : expected - s->seconds_remaining;
+    return drift > DEVICE_STATE_DRIFT_S;
+}
+
+bool device_state_publish(DeviceStatePublisher* pub, const DeviceState* state, uint32_t now_ms) {
+    if (pub->has_sent) {
+        if (now_ms - pub->sent_ms < DEVICE_STATE_MIN_INTERVAL_MS) return false;
+        if (!changed(pub, state, now_ms)) return false;
+    }
+    pub->sent = *state;
+    pub->sent_ms = now_ms;
+    pub->has_sent = true;
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "digit_atlas.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+typedef struct {
+    int16_t ofs_x, ofs_y;
+    uint16_t adv_w;               // Advance without kerning
+    lv_image_dsc_t image;         // A8 bitmap, box_w x box_h
+} AtlasGlyph;
+
+typedef struct {
+    const lv_font_t* font;
+    AtlasGlyph glyphs[DIGIT_ATLAS_CHAR_COUNT];
+    int8_t kern[DIGIT_ATLAS_CHAR_COUNT][DIGIT_ATLAS_CHAR_COUNT];  // Added to adv_w before next char
+} DigitAtlas;
+
+static DigitAtlas atlases[DIGIT_ATLAS_MAX_FONTS];
+static int atlas_count = 0;
+static uint32_t blit_count = 0;
+static uint32_t fallback_count = 0;
+
+static int char_index(char c) {
+    const char* p = strchr(DIGIT_ATLAS_CHARS, c);
+    return (p && c) ? (int)(p - DIGIT_ATLAS_CHARS) : -1;
+}
+
+static DigitAtlas* find_atlas(const lv_font_t* font) {
+    for (int i = 0; i < atlas_count; i++) {
+        if (atlases[i].font == font) return &atlases[i];
+    }
+    return NULL;
+}
+
+bool digit_atlas_build(const lv_font_t* font) {
+    if (find_atlas(font)) return true;
+    if (atlas_count >= DIGIT_ATLAS_MAX_FONTS) return false;
+
+    uint32_t start = micros();
+    DigitAtlas* atlas = &atlases[atlas_count];
+    memset(atlas, 0, sizeof(*atlas));
+    atlas->font = font;
+
+    // Metrics first, so the bitmaps can share one allocation
+    lv_font_glyph_dsc_t dsc[DIGIT_ATLAS_CHAR_COUNT];
+    size_t total = 0;
+    for (int i = 0; i < DIGIT_ATLAS_CHAR_COUNT; i++) {
+        if (!lv_font_get_glyph_dsc(font, &dsc[i], (uint32_t)DIGIT_ATLAS_CHARS[i], 0)) return false;
+        total += (size_t)lv_draw_buf_width_to_stride(dsc[i].box_w, LV_COLOR_FORMAT_A8) * dsc[i].box_h;
+
+        for (int j = 0; j < DIGIT_ATLAS_CHAR_COUNT; j++) {
+            int32_t kerned = lv_font_get_glyph_width(font, (uint32_t)DIGIT_ATLAS_CHARS[i], (uint32_t)DIGIT_ATLAS_CHARS[j]);
+            atlas->kern[i][j] = (int8_t)(kerned - dsc[i].adv_w);
+        }
+    }
+
+    // Internal RAM: glyphs are blitted every second
+    uint8_t* data = (uint8_t*)heap_caps_malloc(total ? total : 1, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!data) return false;
+
+    for (int i = 0; i < DIGIT_ATLAS_CHAR_COUNT; i++) {
+        AtlasGlyph* g = &atlas->glyphs[i];
+        uint32_t stride = lv_draw_buf_width_to_stride(dsc[i].box_w, LV_COLOR_FORMAT_A8);
+        uint32_t size = stride * dsc[i].box_h;
+
+        g->ofs_x = dsc[i].ofs_x;
+        g->ofs_y = dsc[i].ofs_y;
+        g->adv_w = dsc[i].adv_w;
+        g->image.header.magic = LV_IMAGE_HEADER_MAGIC;
+        g->image.header.cf = LV_COLOR_FORMAT_A8;
+        g->image.header.w = dsc[i].box_w;
+        g->image.header.h = dsc[i].box_h;
+        g->image.header.stride = stride;
+        g->image.data = data;
+        g->image.data_size = size;
+
+        if (size > 0) {
+            // Let the font unpack its bitmap into our buffer as A8
+            lv_draw_buf_t buf;
+            lv_draw_buf_init(&buf, dsc[i].box_w, dsc[i].box_h, LV_COLOR_FORMAT_A8, stride, data, size);
+            const void* bitmap = lv_font_get_glyph_bitmap(&dsc[i], &buf);
+            if (bitmap && bitmap != data) memcpy(data, bitmap, size);
+        }
+        data += size;
+    }
+
+    atlas_count++;
+    Serial.printf("[ATLAS] %d px font: %u bytes in %lu us\n", (int)lv_font_get_line_height(font),
+                  (unsigned)total, (unsigned long)(micros() - start));
+    return true;
+}
+
+/**
+ * Width of a single line as lv_text_get_width() computes it
+ */
+static int32_t line_width(const DigitAtlas* atlas, const int* idx, int n, int32_t letter_space) {
+    int32_t w = 0;
+    for (int i = 0; i < n; i++) {
+        w += atlas->glyphs[idx[i]].adv_w + (i + 1 < n ? atlas->kern[idx[i]][idx[i + 1]] : 0) + letter_space;
+    }
+    return n > 0 ? w - letter_space : 0;
+}
+
+static void draw_task_cb(lv_event_t* e) {
+    lv_draw_task_t* task = lv_event_get_draw_task(e);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_LABEL) return;
+
+    lv_draw_label_dsc_t* label = (lv_draw_label_dsc_t*)lv_draw_task_get_draw_dsc(task);
+    if (label->base.part != LV_PART_MAIN || label->opa <= LV_OPA_MIN || !label->text) return;
+
+    DigitAtlas* atlas = find_atlas(label->font);
+    if (!atlas || label->decor != LV_TEXT_DECOR_NONE || (label->flag & LV_TEXT_FLAG_RECOLOR) ||
+        label->sel_start != LV_DRAW_LABEL_NO_TXT_SEL) {
+        fallback_count++;
+        return;
+    }
+
+    int idx[16];
+    int n = 0;
+    for (const char* p = label->text; *p; p++) {
+        int k = char_index(*p);
+        if (k < 0 || n >= (int)(sizeof(idx) / sizeof(idx[0]))) {
+            fallback_count++;
+            return;
+        }
+        idx[n++] = k;
+    }
+
+    lv_area_t coords;
+    lv_draw_task_get_area(task, &coords);
+
+    // Same origin and alignment as lv_draw_label
+    int32_t x = coords.x1 + label->ofs_x;
+    int32_t y = coords.y1 + label->ofs_y;
+    int32_t w = line_width(atlas, idx, n, label->letter_space);
+    if (label->align == LV_TEXT_ALIGN_CENTER) {
+        x += (lv_area_get_width(&coords) - w) / 2;
+    } else if (label->align == LV_TEXT_ALIGN_RIGHT) {
+        x += lv_area_get_width(&coords) - w;
+    }
+    int32_t baseline = lv_font_get_line_height(atlas->font) - atlas->font->base_line;
+
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.recolor = label->color;
+    img.recolor_opa = LV_OPA_COVER;
+    img.opa = label->opa;
+
+    for (int i = 0; i < n; i++) {
+        const AtlasGlyph* g = &atlas->glyphs[idx[i]];
+        if (g->image.header.w > 0 && g->image.header.h > 0) {
+            lv_area_t area;
+            area.x1 = x + g->ofs_x;
+            area.y1 = y + baseline - g->image.header.h - g->ofs_y;
+            area.x2 = area.x1 + g->image.header.w - 1;
+            area.y2 = area.y1 + g->image.header.h - 1;
+            img.src = &g->image;
+            lv_draw_image(label->base.layer, &img, &area);
+        }
+        x += g->adv_w + (i + 1 < n ? atlas->kern[idx[i]][idx[i + 1]] : 0) + label->letter_space;
+    }
+
+    // The stock task stays queued but draws nothing
+    label->opa = LV_OPA_TRANSP;
+    blit_count++;
+}
+
+void digit_atlas_attach(lv_obj_t* label) {
+    if (!label) return;
+    if (!digit_atlas_build(lv_obj_get_style_text_font(label, LV_PART_MAIN))) {
+        Serial.println("[ATLAS] Could not build atlas, label uses the font engine");
+        return;
+    }
+    lv_obj_add_flag(label, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(label, draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+}
+
+void digit_atlas_log_stats() {
+    Serial.printf("[ATLAS] %lu label draws from atlas, %lu via font engine\n",
+                  (unsigned long)blit_count, (unsigned long)fallback_count);
+    blit_count = 0;
+    fallback_count = 0;
+}
@@ -1,6 +1,12 @@
 #include "display_helpers.h"
 #include "squarelineUI/ui.h"
 #include "board_pins.h"
+#include "image_loader.h"
+#include "image_ingest.h"
+#include "ui_view_model.h"
+#include "ring_arc.h"
+#include "static_layer.h"
+#include "refresh_governor.h"
 #include <Arduino.h>
 
 // ============ GLOBAL STATE INSTANCE ============
@@ -14,8 +20,27 @@ DisplayState display_state = {
     .bg_image_changed = false
 };
 
+// ui_Image1 zoom for untranscoded source images (matches ui_Screen1); transcoded
+// images are already screen-sized and drawn 1:1
+#define BG_IMAGE_SOURCE_SCALE 125
+
+// Cached background image currently shown in ui_Image1 (pinned in the image cache)
+static const lv_image_dsc_t* shown_bg_image = NULL;
+
+// ui_Image1 shows an untranscoded source while its .bin is converted
+static bool shown_bg_source = false;
+static uint32_t shown_ingest_generation = 0;
+
+// Timer arc animation: progress is derived from the end time, not from call rate
+static lv_timer_t* arc_timer = NULL;
+static uint32_t arc_end_ms = 0;          // millis() when the countdown reaches zero
+static uint32_t arc_duration_ms = 0;
+static bool arc_running = false;
+static int32_t published_arc_value = -1;
+
 // ============ FORWARD DECLARATIONS ============
 static void update_timer_ui();
+static void arc_timer_cb(lv_timer_t* t);
 static void update_brightness_ui();
 static void update_text_ui();
 static void update_image_ui();
@@ -26,6 +51,9 @@ void display_state_init() {
     strcpy(display_state.time_text, "00:00");
     strcpy(display_state.bg_image_path, "");
     
+    arc_timer = lv_timer_create(arc_timer_cb, 1000 / TIMER_ARC_FPS, NULL);
+    lv_timer_pause(arc_timer);
+    
     render_display_state();
 }
 
@@ -34,7 +62,24 @@ void display_state_init() {
 void update_timer(uint32_t milliseconds, uint32_t max_milliseconds) {
     display_state.timer_ms = milliseconds;
     display_state.timer_max_ms = max_milliseconds;
-    update_timer_ui();
+    
+    // Called every loop while running; only a new event, a finish or drift resyncs
+    uint32_t end = millis() + (max_milliseconds > milliseconds ? max_milliseconds - milliseconds : 0);
+    bool running = milliseconds < max_milliseconds;
+    int32_t drift = (int32_t)(end - arc_end_ms);
+    if (running != arc_running || max_milliseconds != arc_duration_ms ||
+        drift > TIMER_ARC_RESYNC_MS || drift < -TIMER_ARC_RESYNC_MS) {
+        arc_end_ms = end;
+        arc_duration_ms = max_milliseconds;
+        arc_running = running;
+        update_timer_ui();
+    }
+}
+
+uint8_t brightness_from_slider(int32_t slider_value) {
+    uint8_t value = (slider_value * 255) / 100;
+    // Enforce minimum brightness of 10 to prevent completely dark display
+    return value < 10 ? 10 : value;
 }
 
 void update_brightness(uint8_t value) {
@@ -44,6 +89,7 @@ void update_brightness(uint8_t value) {
     }
     display_state.brightness = value;
     update_brightness_ui();
+    view_model_publish(VM_TOPIC_SETTINGS);
 }
 
 void update_event_text(const char* text) {
@@ -73,19 +119,64 @@ void update_background_image(const char* image_path) {
 
 // ============ UI UPDATE FUNCTIONS ============
 
-static void update_timer_ui() {
-    if (!ui_timer_arc) return;
+uint16_t get_timer_arc_value() {
+    // Arc shows the time REMAINING: full at the start, empty at the end
+    if (display_state.timer_max_ms == 0) return 0;
     
-    // Calculate arc value as percentage of time REMAINING (countdown)
-    // Start at 100% and count down to 0%
-    uint16_t arc_value = ((display_state.timer_max_ms - display_state.timer_ms) * 100) / display_state.timer_max_ms;
-    arc_value = (arc_value > 100) ? 100 : arc_value;
+    uint32_t remaining;
+    if (arc_running) {
+        int32_t left = (int32_t)(arc_end_ms - millis());
+        remaining = left > 0 ? (uint32_t)left : 0;
+    } else {
+        remaining = display_state.timer_max_ms > display_state.timer_ms ?
+                    display_state.timer_max_ms - display_state.timer_ms : 0;
+    }
+    if (remaining > display_state.timer_max_ms) remaining = display_state.timer_max_ms;
+    return (uint16_t)(((uint64_t)remaining * TIMER_ARC_RANGE) / display_state.timer_max_ms);
+}
+
+void apply_timer_arc(lv_obj_t* arc) {
+    if (!arc) return;
+    if (lv_arc_get_max_value(arc) != TIMER_ARC_RANGE) {
+        lv_arc_set_range(arc, 0, TIMER_ARC_RANGE);
+    }
+    ring_arc_set_value(arc, get_timer_arc_value());
+}
+
+/**
+ * Publish the arc if it moved, then schedule the next step: TIMER_ARC_FPS while
+ * it moves faster than that, otherwise once per pixel of travel, and not at
+ * all when stopped. Nothing runs in the loop between steps.
+ */
+static void update_timer_ui() {
+    // Screens showing a timer arc subscribe to VM_TOPIC_TIMER
+    int32_t arc_value = get_timer_arc_value();
+    if (arc_value != published_arc_value) {
+        published_arc_value = arc_value;
+        view_model_publish(VM_TOPIC_TIMER);
+    }
     
-    if (lv_scr_act() == ui_Screen1) {
-    lv_arc_set_value(ui_timer_arc, arc_value);
-    } else if (lv_scr_act() == ui_Screen2) {
-    lv_arc_set_value(ui_timer_arc3, arc_value);
+    if (!arc_timer) return;
+    if (!arc_running || arc_value == 0) {
+        lv_timer_pause(arc_timer);
+        return;
     }
+    
+    // Circumference in pixels at the arc's radius
+    uint32_t circumference = (uint32_t)(2 * 3.14159f * TIMER_ARC_RADIUS_PX);
+    uint32_t ms_per_px = arc_duration_ms / circumference;
+    uint32_t period = 1000 / TIMER_ARC_FPS;
+    if (ms_per_px > period) period = ms_per_px;
+    
+    lv_timer_set_period(arc_timer, period);
+    lv_timer_resume(arc_timer);
+    
+    // Steps faster than the idle refresh would otherwise be shown in bursts
+    if (period < REFRESH_GOVERNOR_IDLE_MS) refresh_governor_boost();
+}
+
+static void arc_timer_cb(lv_timer_t* t) {
+    update_timer_ui();
 }
 
 static void update_brightness_ui() {
@@ -96,35 +187,63 @@ static void update_brightness_ui() {
     analogWrite(BL_PIN, display_state.brightness);
 }
 
+void update_label_text(lv_obj_t* label, const char* text) {
+    if (!label || !text) return;
+    // lv_label_set_text() always re-lays out and invalidates the label
+    if (strcmp(lv_label_get_text(label), text) == 0) return;
+    lv_label_set_text(label, text);
+}
+
 static void update_text_ui() {
-    if (ui_timeLabel) {
-        lv_label_set_text(ui_timeLabel, display_state.time_text);
-    }
-    
-    if (ui_eventLabel) {
-        lv_label_set_text(ui_eventLabel, display_state.event_text);
-    }
+    update_label_text(ui_timeLabel, display_state.time_text);
+    update_label_text(ui_eventLabel, display_state.event_text);
 }
 
 static void update_image_ui() {
-    if (!ui_Image1 || !display_state.bg_image_changed) return;
+    if (!ui_Image1) return;
+    bool converted = shown_bg_source && image_ingest_generation() != shown_ingest_generation;
+    if (!display_state.bg_image_changed && !converted) return;
     
     // If path is empty, use default
     if (strlen(display_state.bg_image_path) == 0) {
         // Image moved to SD card - use BLE to transfer
         // lv_img_set_src(ui_Image1, "/lvgl_images/backpacks.bin");
+        shown_bg_source = false;
     } else {
-        // Load from SD card path
-        lv_img_set_src(ui_Image1, display_state.bg_image_path);
+        // Prefer the display-native binary produced at ingest
+        uint32_t generation = image_ingest_generation();
+        char binPath[96];
+        bool transcoded = image_ingest_resolve(display_state.bg_image_path, binPath, sizeof(binPath));
+        shown_ingest_generation = generation;
+        if (!display_state.bg_image_changed && !transcoded) return;  // Another image was converted
+        shown_bg_source = !transcoded;
+        const char* path = transcoded ? binPath : display_state.bg_image_path;
+        
+        // Serve from the PSRAM image cache when possible, otherwise let LVGL load by path
+        const lv_image_dsc_t* cached = image_loader_acquire(path);
+        if (cached) {
+            lv_image_set_src(ui_Image1, cached);
+        } else {
+            lv_img_set_src(ui_Image1, path);
+        }
+        lv_image_set_scale(ui_Image1, transcoded ? LV_SCALE_NONE : BG_IMAGE_SOURCE_SCALE);
+        
+        // Previous image is no longer referenced by LVGL, allow it to be evicted
+        if (shown_bg_image) {
+            image_loader_release(shown_bg_image);
+        }
+        shown_bg_image = cached;
     }
     
+    // ui_Image1 is hidden behind Screen1's background snapshot
+    static_layer_invalidate();
     display_state.bg_image_changed = false;
 }
 
 // ============ RENDER FUNCTION ============
 
 void render_display_state() {
-    update_timer_ui();
+    // Timer arc is stepped by arc_timer
     update_brightness_ui();
     update_text_ui();
     update_image_ui();
@@ -8,6 +8,12 @@
 #include <Arduino.h>
 #include "squarelineUI/ui.h"
 #include "SD_MMC.h"
+#include "lv_fs_sd.h"
+#include "asset_bundle.h"
+#include "render_stats.h"
+#include "round_clip.h"
+#include "lvgl_private.h"  // lv_display_t's dirty areas, for round_clip
+#include "refresh_governor.h"
 
 Arduino_ESP32SPI* bus = NULL;
 Arduino_RGB_Display* gfx = NULL;
@@ -21,18 +27,117 @@ static uint8_t buf1[480 * 480 / 10 * BYTE_PER_PIXEL];
 #define DRAW_BUF_SIZE (TFT_HOR_RES * TFT_VER_RES / 10 * (LV_COLOR_DEPTH / 8))
 uint32_t draw_buf[DRAW_BUF_SIZE / 2];
 
+// ============ ROUND PANEL CLIP ============
+
+#if BOARD_TYPE == 2
+// Rows per clip band. Smaller bands hug the circle more tightly, but LVGL
+// walks the widget tree once per area and keeps at most LV_INV_BUF_SIZE (32)
+// dirty areas, redrawing the whole screen when they run out.
+#define ROUND_CLIP_BAND_ROWS 32
+
+static RoundClipSpan round_clip_rows[TFT_VER_RES];
+static RoundClip round_clip;
+static bool round_clip_splitting = false;
+
+// Stands in for an invalidation that is all corner, until REFR_START drops it.
+// The top-left pixel is never visible, so a real area cannot look like this.
+static bool is_corner_marker(const lv_area_t *a) {
+  return a->x1 == 0 && a->y1 == 0 && a->x2 == 0 && a->y2 == 0;
+}
+
+/**
+ * Trim every invalidated area to the visible circle, split into bands so a
+ * full-screen redraw does not render the corners
+ */
+static void round_clip_invalidate_cb(lv_event_t *e) {
+  if (round_clip_splitting) return;  // Bands we queued ourselves are already clipped
+
+  lv_display_t *disp = (lv_display_t *)lv_event_get_current_target(e);
+  lv_area_t *area = lv_event_get_invalidated_area(e);
+  RoundClipArea a = {area->x1, area->y1, area->x2, area->y2};
+  RoundClipArea bands[TFT_VER_RES / ROUND_CLIP_BAND_ROWS + 1];
+
+  // Leave a slot spare, so splitting never pushes LVGL into a full-screen redraw
+  int room = LV_INV_BUF_SIZE - (int)disp->inv_p - 1;
+  int max = sizeof(bands) / sizeof(bands[0]);
+  if (room < max) max = room > 1 ? room : 1;
+  int n = round_clip_split(&round_clip, &a, ROUND_CLIP_BAND_ROWS, bands, max);
+
+  if (n == 0) {
+    // The event cannot cancel the invalidation. LVGL skips an area it already
+    // holds, so repeat a pending one; with none pending, leave the marker.
+    if (disp->inv_p > 0) *area = disp->inv_areas[0];
+    else lv_area_set(area, 0, 0, 0, 0);
+    return;
+  }
+
+  // The active screen spans the display, so this reaches the display unchanged
+  lv_obj_t *screen = lv_display_get_screen_active(disp);
+  round_clip_splitting = true;
+  for (int i = 1; i < n && screen; i++) {
+    lv_area_t band = {bands[i].x1, bands[i].y1, bands[i].x2, bands[i].y2};
+    lv_obj_invalidate_area(screen, &band);
+  }
+  round_clip_splitting = false;
+
+  area->x1 = bands[0].x1;
+  area->y1 = bands[0].y1;
+  area->x2 = bands[0].x2;
+  area->y2 = bands[0].y2;
+}
+
+/**
+ * Drop corner markers before LVGL joins and renders the dirty areas
+ */
+static void round_clip_refr_start_cb(lv_event_t *e) {
+  lv_display_t *disp = (lv_display_t *)lv_event_get_current_target(e);
+  uint32_t kept = 0;
+  for (uint32_t i = 0; i < disp->inv_p; i++) {
+    if (is_corner_marker(&disp->inv_areas[i])) continue;
+    disp->inv_areas[kept] = disp->inv_areas[i];
+    disp->inv_area_joined[kept] = disp->inv_area_joined[i];
+    kept++;
+  }
+  disp->inv_p = kept;
+}
+#endif
+
 // ============ LVGL CALLBACKS ============
 
+static void flush_rows(const lv_area_t *area, uint16_t *px, uint32_t w, uint32_t h) {
+#if (LV_COLOR_16_SWAP != 0)
+  gfx->draw16bitBeRGBBitmap(area->x1, area->y1, px, w, h);
+#else
+  gfx->draw16bitRGBBitmap(area->x1, area->y1, px, w, h);
+#endif
+}
+
 void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t * px_map) {
   uint32_t w = (area->x2 - area->x1 + 1);
   uint32_t h = (area->y2 - area->y1 + 1);
 
-#if (LV_COLOR_16_SWAP != 0)
-  gfx->draw16bitBeRGBBitmap(area->x1, area->y1, (uint16_t *)px_map, w, h);
+#if BOARD_TYPE == 2
+  RoundClipArea a = {area->x1, area->y1, area->x2, area->y2};
+  uint32_t visible = round_clip_visible_px(&round_clip, &a);
+  if (visible < w * h) {
+    // Copy only the visible span of each row
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+      const RoundClipSpan *s = &round_clip.rows[y];
+      lv_area_t row = {s->x0 > area->x1 ? s->x0 : area->x1, y,
+                       s->x1 - 1 < area->x2 ? s->x1 - 1 : area->x2, y};
+      if (row.x1 > row.x2) continue;
+      uint16_t *px = (uint16_t *)px_map + (y - area->y1) * w + (row.x1 - area->x1);
+      flush_rows(&row, px, row.x2 - row.x1 + 1, 1);
+    }
+    render_stats_add_skipped(w * h - visible);
+  } else {
+    flush_rows(area, (uint16_t *)px_map, w, h);
+  }
 #else
-  gfx->draw16bitRGBBitmap(area->x1, area->y1, (uint16_t *)px_map, w, h);
+  flush_rows(area, (uint16_t *)px_map, w, h);
 #endif
 
+  render_stats_add_flush(disp, area);
   lv_disp_flush_ready(disp);
 }
 
@@ -185,12 +290,33 @@ void hardware_init() {
   lv_display_t * disp = lv_display_create(TFT_HOR_RES, TFT_VER_RES);
   lv_display_set_flush_cb(disp, my_disp_flush);
   lv_display_set_buffers(disp, draw_buf, NULL, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+  render_stats_attach(disp);
+#if BOARD_TYPE == 2
+  round_clip_init(&round_clip, TFT_HOR_RES, TFT_VER_RES, round_clip_rows);
+  lv_display_add_event_cb(disp, round_clip_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+  lv_display_add_event_cb(disp, round_clip_refr_start_cb, LV_EVENT_REFR_START, NULL);
+  Serial.printf("[RENDER] Round clip: %lu of %lu px visible\n",
+                (unsigned long)round_clip.visible_px, (unsigned long)(TFT_HOR_RES * TFT_VER_RES));
+#endif
 
   lv_indev_t * indev = lv_indev_create();
   lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
   lv_indev_set_read_cb(indev, my_touchpad_read);
+  refresh_governor_init(disp, indev);
   
+  lv_mem_monitor_t memBefore, memAfter;
+  lv_mem_monitor(&memBefore);
+  uint32_t uiStart = micros();
   ui_init();
+  uint32_t uiTime = micros() - uiStart;
+  lv_mem_monitor(&memAfter);
+  // Bytes and blocks: a local style costs two blocks, a shared one none
+  Serial.printf("[UI] ui_init: %lu us, LVGL heap used %u bytes in %u blocks (%u -> %u)\n",
+                (unsigned long)uiTime,
+                (unsigned)((memAfter.total_size - memAfter.free_size) - (memBefore.total_size - memBefore.free_size)),
+                (unsigned)(memAfter.used_cnt - memBefore.used_cnt),
+                (unsigned)(memBefore.total_size - memBefore.free_size),
+                (unsigned)(memAfter.total_size - memAfter.free_size));
   lv_scr_load(ui_Screen1);
 
   // ===== STEP 14: Initialize SD Card =====
@@ -200,6 +326,8 @@ void hardware_init() {
     Serial.println("SD_MMC mount failed");
   } else {
     Serial.println("SD_MMC mounted");
+    lv_fs_sd_init();
+    asset_bundle_mount_file(ASSET_BUNDLE_PATH, /*verify_assets=*/false);  // Checked when it arrived
   }
 
   // ===== STEP 15: Initialize BLE Service =====
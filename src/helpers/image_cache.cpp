@@ -0,0 +1,197 @@
+#include "image_cache.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+struct ImageCacheEntry {
+    char path[IMAGE_CACHE_PATH_LEN];
+    uint32_t generation;
+    uint8_t* data;
+    size_t size;
+    uint32_t last_used;  // LRU stamp, larger = more recent
+    uint16_t pins;
+    bool stale;          // Superseded or invalidated, freed once unpinned
+};
+
+static ImageCacheEntry entries[IMAGE_CACHE_MAX_ENTRIES];
+static ImageCacheStats stats = {0};
+static uint32_t useCounter = 0;
+
+// Decoded images live in PSRAM on the device, plain heap on host
+static uint8_t* cache_alloc(size_t size) {
+#ifdef ESP_PLATFORM
+    uint8_t* p = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (p) return p;
+#endif
+    return (uint8_t*)malloc(size);
+}
+
+static void cache_free(uint8_t* p) {
+#ifdef ESP_PLATFORM
+    heap_caps_free(p);
+#else
+    free(p);
+#endif
+}
+
+static void free_entry(ImageCacheEntry& e) {
+    cache_free(e.data);
+    stats.bytes_used -= e.size;
+    stats.entries--;
+    memset(&e, 0, sizeof(e));
+}
+
+static ImageCacheEntry* find_by_data(const void* data) {
+    if (!data) return nullptr;
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i].data == data) return &entries[i];
+    }
+    return nullptr;
+}
+
+// Evict the least recently used unpinned entry; false if nothing can be evicted
+static bool evict_one() {
+    ImageCacheEntry* victim = nullptr;
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        ImageCacheEntry& e = entries[i];
+        if (!e.data || e.pins > 0) continue;
+        if (!victim || e.last_used < victim->last_used) victim = &e;
+    }
+    if (!victim) return false;
+    free_entry(*victim);
+    stats.evictions++;
+    return true;
+}
+
+static void evict_to_fit(size_t incoming) {
+    while (stats.bytes_used + incoming > stats.budget_bytes) {
+        if (!evict_one()) break;
+    }
+}
+
+void image_cache_init(size_t budget_bytes) {
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i].data) cache_free(entries[i].data);
+    }
+    memset(entries, 0, sizeof(entries));
+    memset(&stats, 0, sizeof(stats));
+    stats.budget_bytes = budget_bytes;
+    useCounter = 0;
+}
+
+void image_cache_set_budget(size_t budget_bytes) {
+    stats.budget_bytes = budget_bytes;
+    evict_to_fit(0);
+}
+
+void* image_cache_lookup(const char* path, uint32_t generation, size_t* out_size) {
+    if (!path) return nullptr;
+
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        ImageCacheEntry& e = entries[i];
+        if (!e.data || e.stale || e.generation != generation) continue;
+        if (strncmp(e.path, path, sizeof(e.path)) != 0) continue;
+
+        e.pins++;
+        e.last_used = ++useCounter;
+        stats.hits++;
+        if (out_size) *out_size = e.size;
+        return e.data;
+    }
+
+    stats.misses++;
+    return nullptr;
+}
+
+void* image_cache_insert(const char* path, uint32_t generation, size_t size) {
+    if (!path || size == 0 || strlen(path) >= IMAGE_CACHE_PATH_LEN || size > stats.budget_bytes) {
+        stats.insert_failures++;
+        return nullptr;
+    }
+
+    // Older generations of this path can never be hit again
+    image_cache_invalidate(path);
+    evict_to_fit(size);
+
+    ImageCacheEntry* slot = nullptr;
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES && !slot; i++) {
+        if (!entries[i].data) slot = &entries[i];
+    }
+    if (!slot && evict_one()) {
+        for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES && !slot; i++) {
+            if (!entries[i].data) slot = &entries[i];
+        }
+    }
+    if (!slot || stats.bytes_used + size > stats.budget_bytes) {
+        stats.insert_failures++;
+        return nullptr;
+    }
+
+    uint8_t* data = cache_alloc(size);
+    if (!data) {
+        stats.insert_failures++;
+        return nullptr;
+    }
+
+    strncpy(slot->path, path, sizeof(slot->path) - 1);
+    slot->generation = generation;
+    slot->data = data;
+    slot->size = size;
+    slot->last_used = ++useCounter;
+    slot->pins = 1;
+    slot->stale = false;
+
+    stats.bytes_used += size;
+    stats.entries++;
+    return data;
+}
+
+void image_cache_release(const void* data) {
+    ImageCacheEntry* e = find_by_data(data);
+    if (!e || e->pins == 0) return;
+
+    e->pins--;
+    if (e->pins == 0 && e->stale) {
+        free_entry(*e);
+    }
+}
+
+void image_cache_discard(const void* data) {
+    ImageCacheEntry* e = find_by_data(data);
+    if (!e) return;
+
+    e->stale = true;
+    image_cache_release(data);
+}
+
+void image_cache_invalidate(const char* path) {
+    if (!path) return;
+
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        ImageCacheEntry& e = entries[i];
+        if (!e.data || strncmp(e.path, path, sizeof(e.path)) != 0) continue;
+
+        if (e.pins == 0) {
+            free_entry(e);
+        } else {
+            e.stale = true;
+        }
+    }
+}
+
+void image_cache_clear(void) {
+    for (size_t i = 0; i < IMAGE_CACHE_MAX_ENTRIES; i++) {
+        if (entries[i].data && entries[i].pins == 0) {
+            free_entry(entries[i]);
+        }
+    }
+}
+
+void image_cache_get_stats(ImageCacheStats* out_stats) {
+    if (out_stats) {
+        *out_stats = stats;
+    }
+}
@@ -0,0 +1,341 @@
+#include "image_ingest.h"
+#include "image_transcoder.h"
+#include "image_store.h"
+#include "asset_bundle.h"
+#include "FS.h"
+#include "SD_MMC.h"
+#include "esp_heap_caps.h"
+#include "rom/miniz.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#define SD_MOUNT_PREFIX "/sdcard"
+#define PATH_MAX_LEN 96
+
+// Guarded by lock: jobs[0] is converted while the task works on it
+static char jobs[IMAGE_INGEST_QUEUE][PATH_MAX_LEN];
+static volatile int jobCount = 0;
+static char failed[IMAGE_INGEST_FAILED_MAX][PATH_MAX_LEN];  // Not retried on every event change
+static int failedNext = 0;
+static SemaphoreHandle_t lock = NULL;
+static TaskHandle_t ingestTask = NULL;
+static volatile uint32_t generation = 0;
+
+/**
+ * SD_MMC paths are relative to the mount point; strip "/sdcard" if present
+ */
+static const char* to_sd_path(const char* path) {
+    size_t prefixLen = strlen(SD_MOUNT_PREFIX);
+    if (strncmp(path, SD_MOUNT_PREFIX, prefixLen) == 0 && path[prefixLen] == '/') {
+        return path + prefixLen;
+    }
+    return path;
+}
+
+/**
+ * "/sdcard/breakfast.png" -> "/lvgl_images/breakfast.png.bin", so breakfast.bmp
+ * gets its own; a .bin maps to itself in IMAGE_INGEST_DIR
+ */
+static bool bin_path_for(const char* path, char* out, size_t out_len) {
+    const char* name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    const char* ext = strrchr(name, '.');
+    if (name[0] == '\0') return false;
+
+    int n = ext && strcmp(ext, ".bin") == 0 ? snprintf(out, out_len, "%s/%s", IMAGE_INGEST_DIR, name)
+                                             : snprintf(out, out_len, "%s/%s.bin", IMAGE_INGEST_DIR, name);
+    return n > 0 && (size_t)n < out_len;
+}
+
+/**
+ * Whether the .bin exists and is not older than its source
+ * @param src_exists Set if the source is there to convert (may be NULL)
+ */
+static bool bin_is_fresh(const char* path, const char* binPath, bool* src_exists) {
+    time_t srcTime = 0;
+    File src = SD_MMC.open(to_sd_path(path), FILE_READ);
+    if (src_exists) *src_exists = (bool)src;
+    if (src) {
+        srcTime = src.getLastWrite();
+        src.close();
+    }
+
+    bool fresh = false;
+    File bin = SD_MMC.open(binPath, FILE_READ);
+    if (bin) {
+        fresh = bin.getLastWrite() >= srcTime;
+        bin.close();
+    }
+    return fresh;
+}
+
+/**
+ * zlib inflate using the decompressor in the ESP32 ROM
+ */
+static size_t rom_inflate(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_len) {
+    // ~11 KB of state - too large for the loop task stack
+    tinfl_decompressor* decomp = (tinfl_decompressor*)heap_caps_malloc(sizeof(tinfl_decompressor), MALLOC_CAP_8BIT);
+    if (!decomp) return 0;
+
+    tinfl_init(decomp);
+    size_t inBytes = in_len;
+    size_t outBytes = out_len;
+    tinfl_status status = tinfl_decompress(decomp, in, &inBytes, out, out, &outBytes,
+        TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+    heap_caps_free(decomp);
+
+    return status == TINFL_STATUS_DONE ? outBytes : 0;
+}
+
+static void* psram_alloc(size_t size) {
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+}
+
+static bool write_bin(const char* binPath, const uint8_t* header, size_t headerLen,
+                      const uint8_t* payload, size_t payloadLen) {
+    if (!SD_MMC.exists(IMAGE_INGEST_DIR)) {
+        SD_MMC.mkdir(IMAGE_INGEST_DIR);
+    }
+
+    // Write beside the target and rename, so a reader never sees a partial file
+    char tmpPath[104];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", binPath);
+
+    File out = SD_MMC.open(tmpPath, FILE_WRITE);
+    if (!out) {
+        Serial.printf("[INGEST] Failed to open %s for writing\n", tmpPath);
+        return false;
+    }
+    bool ok = out.write(header, headerLen) == headerLen && out.write(payload, payloadLen) == payloadLen;
+    out.close();
+
+    if (ok) {
+        SD_MMC.remove(binPath);
+        ok = SD_MMC.rename(tmpPath, binPath);
+    }
+    if (!ok) {
+        Serial.printf("[INGEST] Failed to write %s\n", binPath);
+        SD_MMC.remove(tmpPath);
+    }
+    return ok;
+}
+
+bool image_ingest_convert(const char* src_path) {
+    char binPath[96];
+    if (!src_path || !bin_path_for(src_path, binPath, sizeof(binPath))) return false;
+    if (strcmp(to_sd_path(src_path), binPath) == 0) return false;  // Already a .bin
+
+    File f = SD_MMC.open(to_sd_path(src_path), FILE_READ);
+    if (!f) {
+        Serial.printf("[INGEST] Not found: %s\n", src_path);
+        return false;
+    }
+    size_t fileLen = f.size();
+    uint8_t* file = (uint8_t*)psram_alloc(fileLen);
+    if (!file) {
+        Serial.printf("[INGEST] Cannot allocate %u bytes for %s\n", (unsigned int)fileLen, src_path);
+        f.close();
+        return false;
+    }
+    bool readOk = f.read(file, fileLen) == fileLen;
+    f.close();
+
+    uint32_t startUs = micros();
+    static TranscodeSource src;  // 1 KB palette - keep off the stack
+    uint8_t* raw = nullptr;
+    bool decoded = false;
+    size_t rawSize = 0;
+
+    if (!readOk) {
+        Serial.printf("[INGEST] Short read on %s\n", src_path);
+    } else if (transcoder_parse_bmp(file, fileLen, &src)) {
+        decoded = true;
+    } else if ((rawSize = transcoder_png_raw_size(file, fileLen, nullptr, nullptr)) > 0) {
+        raw = (uint8_t*)psram_alloc(rawSize);
+        decoded = raw && transcoder_decode_png(file, fileLen, raw, rawSize, rom_inflate, &src);
+        if (!decoded) Serial.printf("[INGEST] PNG decode failed: %s\n", src_path);
+    } else {
+        Serial.printf("[INGEST] Unsupported format (need 8-bit PNG or 24/32-bit BMP): %s\n", src_path);
+    }
+    uint32_t decodeUs = micros() - startUs;
+
+    const size_t pixelBytes = IMAGE_INGEST_TARGET_W * IMAGE_INGEST_TARGET_H * 2;
+    uint16_t* pixels = decoded ? (uint16_t*)psram_alloc(pixelBytes) : nullptr;
+    bool scaled = pixels && transcoder_scale_to_rgb565(&src, pixels, IMAGE_INGEST_TARGET_W, IMAGE_INGEST_TARGET_H);
+    uint32_t scaleUs = micros() - startUs - decodeUs;
+
+    uint32_t srcW = src.w, srcH = src.h;
+    heap_caps_free(file);
+    if (raw) heap_caps_free(raw);
+
+    if (!scaled) {
+        if (pixels) heap_caps_free(pixels);
+        return false;
+    }
+
+    // Keep RLE only when it is smaller than the raw pixels
+    uint8_t* rle = nullptr;
+    size_t rleSize = 0;
+#if IMAGE_INGEST_RLE
+    rle = (uint8_t*)psram_alloc(pixelBytes);
+    if (rle) {
+        rleSize = transcoder_rle_encode((const uint8_t*)pixels, pixelBytes, 2, rle, pixelBytes - 1);
+    }
+#endif
+
+    uint8_t header[TRANSCODE_BIN_HEADER_MAX];
+    size_t headerLen = transcoder_write_bin_header(header, IMAGE_INGEST_TARGET_W, IMAGE_INGEST_TARGET_H, rleSize);
+    bool ok = rleSize ? write_bin(binPath, header, headerLen, rle, rleSize)
+                      : write_bin(binPath, header, headerLen, (const uint8_t*)pixels, pixelBytes);
+
+    uint32_t totalUs = micros() - startUs;
+    if (ok) {
+        Serial.printf("[INGEST] %s %lux%lu -> %s %dx%d %s %u bytes: decode %lu ms, scale %lu ms, total %lu ms (%lu Kpx/s)\n",
+            src_path, (unsigned long)srcW, (unsigned long)srcH, binPath,
+            IMAGE_INGEST_TARGET_W, IMAGE_INGEST_TARGET_H, rleSize ? "RLE" : "raw",
+            (unsigned int)(headerLen + (rleSize ? rleSize : pixelBytes)),
+            (unsigned long)(decodeUs / 1000), (unsigned long)(scaleUs / 1000), (unsigned long)(totalUs / 1000),
+            (unsigned long)((uint64_t)srcW * srcH * 1000 / (totalUs ? totalUs : 1)));
+    }
+
+    if (rle) heap_caps_free(rle);
+    heap_caps_free(pixels);
+    return ok;
+}
+
+// ============ INGEST TASK ============
+
+static int find_failed(const char* path) {
+    for (int i = 0; i < IMAGE_INGEST_FAILED_MAX; i++) {
+        if (strcmp(failed[i], path) == 0) return i;
+    }
+    return -1;
+}
+
+static void ingest_task_fn(void* arg) {
+    char path[PATH_MAX_LEN];
+    char binPath[PATH_MAX_LEN];
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        for (;;) {
+            xSemaphoreTake(lock, portMAX_DELAY);
+            bool have = jobCount > 0;
+            if (have) strcpy(path, jobs[0]);
+            xSemaphoreGive(lock);
+            if (!have) break;
+
+            // Requested twice, or written since it was queued
+            bool ok = (bin_path_for(path, binPath, sizeof(binPath)) && bin_is_fresh(path, binPath, NULL)) ||
+                      image_ingest_convert(path);
+
+            xSemaphoreTake(lock, portMAX_DELAY);
+            if (!ok && find_failed(path) < 0) {
+                strcpy(failed[failedNext], path);
+                failedNext = (failedNext + 1) % IMAGE_INGEST_FAILED_MAX;
+            }
+            jobCount--;
+            memmove(jobs[0], jobs[1], (size_t)jobCount * PATH_MAX_LEN);
+            xSemaphoreGive(lock);
+            generation++;
+        }
+    }
+}
+
+static bool ensure_task() {
+    if (ingestTask) return true;
+    if (!lock) lock = xSemaphoreCreateMutex();
+    if (!lock) return false;
+    if (xTaskCreatePinnedToCore(ingest_task_fn, "ingest", IMAGE_INGEST_TASK_STACK, NULL,
+                                IMAGE_INGEST_TASK_PRIORITY, &ingestTask, IMAGE_INGEST_TASK_CORE) != pdPASS) {
+        Serial.println("[INGEST] ERROR: Failed to start task");
+        ingestTask = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @param retry Convert even a source that failed before
+ */
+static bool queue_conversion(const char* path, bool retry) {
+    if (strlen(path) >= PATH_MAX_LEN || !ensure_task()) return false;
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    int f = find_failed(path);
+    bool queued = false;
+    if (f >= 0 && retry) failed[f][0] = '\0';
+    if (f < 0 || retry) {
+        for (int i = 0; i < jobCount && !queued; i++) queued = strcmp(jobs[i], path) == 0;
+        if (!queued && jobCount < IMAGE_INGEST_QUEUE) {
+            strcpy(jobs[jobCount++], path);
+            queued = true;
+        }
+    }
+    xSemaphoreGive(lock);
+
+    if (queued) xTaskNotifyGive(ingestTask);
+    return queued;
+}
+
+bool image_ingest_request(const char* src_path) {
+    return src_path && queue_conversion(src_path, true);
+}
+
+bool image_ingest_busy() {
+    return jobCount > 0;
+}
+
+uint32_t image_ingest_generation() {
+    return generation;
+}
+
+// ============ RESOLVE ============
+
+/**
+ * Name of the mounted bundle's asset for an image, if it packs one: bundles
+ * name assets after the image's stem ("breakfast.png" -> "breakfast.bin")
+ */
+static const AssetBundleEntry* bundled_asset(const char* path) {
+    if (!asset_bundle_path()) return NULL;
+    const char* name = strrchr(path, '/');
+    name = name ? name + 1 : path;
+    const char* ext = strrchr(name, '.');
+    int stemLen = ext ? (int)(ext - name) : (int)strlen(name);
+
+    char assetName[PATH_MAX_LEN];
+    int n = snprintf(assetName, sizeof(assetName), "%.*s.bin", stemLen, name);
+    if (stemLen == 0 || n <= 0 || (size_t)n >= sizeof(assetName)) return NULL;
+    return asset_bundle_find(assetName);
+}
+
+bool image_ingest_resolve(const char* path, char* out, size_t out_len) {
+    // The bundle's assets are already display-native and read in place
+    const AssetBundleEntry* asset = path ? bundled_asset(path) : NULL;
+    if (asset) {
+        int n = snprintf(out, out_len, "%s%s", ASSET_BUNDLE_PREFIX, asset->name);
+        return n > 0 && (size_t)n < out_len;
+    }
+
+    // Names synced through the image store refer to a blob: "/lvgl_images/<hash>.bin"
+    char blobPath[96];
+    if (path && image_store_resolve(path, blobPath, sizeof(blobPath))) {
+        path = blobPath;
+    }
+
+    char binPath[PATH_MAX_LEN];
+    if (!path || !bin_path_for(path, binPath, sizeof(binPath))) return false;
+    if (strcmp(to_sd_path(path), binPath) == 0) return false;  // Already a .bin
+    if (SD_MMC.cardType() == CARD_NONE) return false;
+
+    bool srcExists = false;
+    if (!bin_is_fresh(path, binPath, &srcExists)) {
+        // The caller shows the source until the task has written the .bin
+        if (srcExists) queue_conversion(path, false);
+        return false;
+    }
+
+    strncpy(out, binPath, out_len - 1);
+    out[out_len - 1] = '\0';
+    return true;
+}
@@ -0,0 +1,217 @@
+#include "image_loader.h"
+#include "image_cache.h"
+#include "image_transcoder.h"
+#include "asset_bundle.h"
+#include "FS.h"
+#include "SD_MMC.h"
+#include "esp_heap_caps.h"
+
+#define SD_MOUNT_PREFIX "/sdcard"
+
+// Cached blob layout: [lv_image_dsc_t][pixel data]
+// The descriptor lives at the start of the cache buffer so LVGL can use it directly
+#define IMAGE_BLOB_HEADER_SIZE ((sizeof(lv_image_dsc_t) + 3U) & ~3U)
+
+/**
+ * SD_MMC paths are relative to the mount point; strip "/sdcard" if present
+ */
+static const char* to_sd_path(const char* path) {
+    size_t prefixLen = strlen(SD_MOUNT_PREFIX);
+    if (strncmp(path, SD_MOUNT_PREFIX, prefixLen) == 0 && path[prefixLen] == '/') {
+        return path + prefixLen;
+    }
+    return path;
+}
+
+uint32_t image_loader_file_generation(const char* path) {
+    if (!path || SD_MMC.cardType() == CARD_NONE) return 0;
+
+    // A bundled asset changes with its bundle and its own CRC
+    const AssetBundleEntry* asset = asset_bundle_lookup(to_sd_path(path));
+    if (asset) {
+        uint32_t gen = image_loader_file_generation(asset_bundle_path()) ^ asset->crc;
+        return gen ? gen : 1;
+    }
+
+    File f = SD_MMC.open(to_sd_path(path), FILE_READ);
+    if (!f) return 0;
+
+    uint32_t size = f.size();
+    uint32_t lastWrite = (uint32_t)f.getLastWrite();
+    f.close();
+
+    // Mix size and mtime so a rewrite with either change produces a new key
+    uint32_t gen = (lastWrite * 2654435761U) ^ size;
+    return gen ? gen : 1;
+}
+
+bool image_loader_job_begin(ImageLoadJob& job, const char* path) {
+    job.blob = nullptr;
+    job.packed = nullptr;
+    job.data_size = 0;
+    job.read_size = 0;
+    job.loaded = 0;
+    job.path[0] = '\0';
+    if (!path || path[0] == '\0') return false;
+
+    uint32_t generation = image_loader_file_generation(path);
+    if (generation == 0) {
+        Serial.printf("[IMAGE] Not found: %s\n", path);
+        return false;
+    }
+
+    strncpy(job.path, path, sizeof(job.path) - 1);
+    job.path[sizeof(job.path) - 1] = '\0';
+    job.start_us = micros();
+
+    size_t cachedSize = 0;
+    void* cached = image_cache_lookup(path, generation, &cachedSize);
+    if (cached) {
+        job.blob = (uint8_t*)cached;
+        job.data_size = cachedSize - IMAGE_BLOB_HEADER_SIZE;
+        job.read_size = job.data_size;
+        job.loaded = job.data_size;
+        return true;
+    }
+
+    // A bundled asset is a byte range of the bundle file
+    const AssetBundleEntry* asset = asset_bundle_lookup(to_sd_path(path));
+    job.file = SD_MMC.open(asset ? asset_bundle_path() : to_sd_path(path), FILE_READ);
+    if (!job.file || (asset && !job.file.seek(asset->offset))) {
+        Serial.printf("[IMAGE] Failed to open %s\n", path);
+        if (job.file) job.file.close();
+        return false;
+    }
+    size_t fileSize = asset ? asset->size : job.file.size();
+
+    lv_image_header_t header;
+    if (fileSize < sizeof(header) || job.file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != LV_IMAGE_HEADER_MAGIC) {
+        // Not an LVGL binary - let LVGL open it by path instead
+        job.file.close();
+        return false;
+    }
+
+    job.data_size = fileSize - sizeof(header);
+    job.read_size = job.data_size;
+
+    if (header.flags & LV_IMAGE_FLAGS_COMPRESSED) {
+        // Compression header: method, compressed size, decompressed size
+        uint32_t comp[3];
+        if (job.file.read((uint8_t*)comp, sizeof(comp)) != sizeof(comp) ||
+            (comp[0] & 0xF) != LV_IMAGE_COMPRESS_RLE ||
+            comp[2] != (uint32_t)header.stride * header.h || comp[1] >= comp[2] ||
+            job.data_size < sizeof(comp) || comp[1] > job.data_size - sizeof(comp)) {
+            Serial.printf("[IMAGE] Unsupported compression in %s\n", path);
+            job.file.close();
+            return false;
+        }
+        job.data_size = comp[2];
+        job.read_size = comp[1];
+        job.packed = (uint8_t*)heap_caps_malloc(job.read_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!job.packed) {
+            job.file.close();
+            return false;
+        }
+    }
+
+    job.blob = (uint8_t*)image_cache_insert(path, generation, IMAGE_BLOB_HEADER_SIZE + job.data_size);
+    if (!job.blob) {
+        Serial.printf("[IMAGE] Cache cannot fit %s (%u bytes)\n", path, (unsigned int)job.data_size);
+        image_loader_job_cancel(job);
+        return false;
+    }
+
+    lv_image_dsc_t* dsc = (lv_image_dsc_t*)job.blob;
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->header = header;
+    dsc->header.flags &= ~LV_IMAGE_FLAGS_COMPRESSED;
+    dsc->data_size = job.data_size;
+    dsc->data = job.blob + IMAGE_BLOB_HEADER_SIZE;
+    return true;
+}
+
+int image_loader_job_step(ImageLoadJob& job, size_t max_bytes) {
+    if (!job.blob) return -1;
+    if (job.loaded >= job.data_size) return 1;
+
+    size_t want = job.read_size - job.loaded;
+    if (want > max_bytes) want = max_bytes;
+
+    uint8_t* dest = job.packed ? job.packed : job.blob + IMAGE_BLOB_HEADER_SIZE;
+    size_t n = job.file.read(dest + job.loaded, want);
+    job.loaded += n;
+
+    if (n != want) {
+        Serial.printf("[IMAGE] Short read on %s (%u of %u bytes)\n", job.path,
+            (unsigned int)job.loaded, (unsigned int)job.read_size);
+        image_loader_job_cancel(job);
+        return -1;
+    }
+
+    if (job.loaded < job.read_size) return 0;
+
+    job.file.close();
+    if (job.packed) {
+        size_t decoded = transcoder_rle_decode(job.packed, job.read_size,
+            job.blob + IMAGE_BLOB_HEADER_SIZE, job.data_size, LV_COLOR_FORMAT_GET_SIZE(LV_COLOR_FORMAT_RGB565));
+        heap_caps_free(job.packed);
+        job.packed = nullptr;
+        if (decoded != job.data_size) {
+            Serial.printf("[IMAGE] Corrupt RLE data in %s\n", job.path);
+            image_loader_job_cancel(job);
+            return -1;
+        }
+        job.loaded = job.data_size;
+    }
+
+    const lv_image_dsc_t* dsc = (const lv_image_dsc_t*)job.blob;
+    Serial.printf("[IMAGE] Loaded %s (%ux%u, %u bytes from card) in %lu us\n", job.path,
+        dsc->header.w, dsc->header.h, (unsigned int)job.read_size,
+        (unsigned long)(micros() - job.start_us));
+    return 1;
+}
+
+void image_loader_job_cancel(ImageLoadJob& job) {
+    if (job.file) {
+        job.file.close();
+    }
+    if (job.blob) {
+        // A finished image may be shared with other users; only drop partial loads
+        if (job.data_size > 0 && job.loaded >= job.data_size) {
+            image_cache_release(job.blob);
+        } else {
+            image_cache_discard(job.blob);
+        }
+        job.blob = nullptr;
+    }
+    if (job.packed) {
+        heap_caps_free(job.packed);
+        job.packed = nullptr;
+    }
+    job.loaded = 0;
+    job.data_size = 0;
+}
+
+const lv_image_dsc_t* image_loader_acquire(const char* path) {
+    ImageLoadJob job;
+    if (!image_loader_job_begin(job, path)) {
+        return nullptr;
+    }
+    if (image_loader_job_step(job, job.data_size) != 1) {
+        return nullptr;
+    }
+    return (const lv_image_dsc_t*)job.blob;
+}
+
+void image_loader_release(const lv_image_dsc_t* dsc) {
+    image_cache_release(dsc);
+}
+
+void image_loader_log_stats() {
+    ImageCacheStats s;
+    image_cache_get_stats(&s);
+    Serial.printf("[IMAGE] Cache: %u hits, %u misses, %u evictions, %u entries, %u/%u bytes\n",
+        (unsigned int)s.hits, (unsigned int)s.misses, (unsigned int)s.evictions,
+        (unsigned int)s.entries, (unsigned int)s.bytes_used, (unsigned int)s.budget_bytes);
+}
@@ -0,0 +1,130 @@
+#include "image_prefetch.h"
+#include "image_loader.h"
+#include "image_ingest.h"
+#include "schedule_manager.h"
+#include <lvgl.h>
+#include <time.h>
+
+#define PREFETCH_CHECK_INTERVAL_MS 1000
+
+static bool prefetchEnabled = IMAGE_PREFETCH_ENABLED;
+static uint32_t leadTimeSeconds = IMAGE_PREFETCH_LEAD_TIME_S;
+
+// Current job: loading (active && !ready) or holding a pinned image (ready)
+static ImageLoadJob job;
+static bool jobActive = false;
+static bool jobReady = false;
+static char jobSource[96] = {0};  // Schedule path the job was started for (job.path may be its .bin)
+
+// Event-boundary latency measurement
+static volatile bool boundaryPending = false;
+static uint32_t boundaryStartUs = 0;
+static bool boundaryPrefetched = false;
+
+static void drop_job() {
+    if (jobActive) {
+        image_loader_job_cancel(job);
+    }
+    jobActive = false;
+    jobReady = false;
+}
+
+/**
+ * Log the time from the image switch to the end of the next rendered frame
+ */
+static void refr_ready_cb(lv_event_t* e) {
+    if (!boundaryPending) return;
+    boundaryPending = false;
+
+    Serial.printf("[PREFETCH] Event boundary frame latency: %lu us (prefetched: %s)\n",
+        (unsigned long)(micros() - boundaryStartUs), boundaryPrefetched ? "yes" : "no");
+}
+
+void image_prefetch_init() {
+    lv_display_t* disp = lv_display_get_default();
+    if (disp) {
+        lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+    }
+    Serial.printf("[PREFETCH] Initialized (lead time %lu s)\n", (unsigned long)leadTimeSeconds);
+}
+
+void image_prefetch_set_enabled(bool enabled) {
+    prefetchEnabled = enabled;
+    if (!enabled) {
+        drop_job();
+    }
+    Serial.printf("[PREFETCH] %s\n", enabled ? "Enabled" : "Disabled");
+}
+
+void image_prefetch_set_lead_time(uint32_t seconds) {
+    leadTimeSeconds = seconds;
+}
+
+bool image_prefetch_is_ready(const char* path) {
+    return jobActive && jobReady && path && strcmp(job.path, path) == 0;
+}
+
+void image_prefetch_mark_boundary(const char* path) {
+    if (!path || path[0] == '\0') return;
+    // The job was started for the schedule path; job.path may be its .bin
+    boundaryPrefetched = jobActive && jobReady && strcmp(jobSource, path) == 0;
+    boundaryStartUs = micros();
+    boundaryPending = true;
+}
+
+void image_prefetch_tick() {
+    if (!prefetchEnabled) return;
+
+    // Keep loading the current image in small steps
+    if (jobActive && !jobReady) {
+        int res = image_loader_job_step(job, IMAGE_PREFETCH_STEP_BYTES);
+        if (res == 1) {
+            jobReady = true;
+            Serial.printf("[PREFETCH] Ready: %s\n", job.path);
+        } else if (res < 0) {
+            jobActive = false;
+        }
+        return;
+    }
+
+    static unsigned long lastCheck = 0;
+    if (millis() - lastCheck < PREFETCH_CHECK_INTERVAL_MS) return;
+    lastCheck = millis();
+
+    ScheduleEvent* next = getNextScheduleEvent();
+    if (!next || next->path[0] == '\0') {
+        drop_job();
+        return;
+    }
+
+    time_t now = time(nullptr);
+    struct tm* timeinfo = localtime(&now);
+    uint32_t nowSeconds = timeinfo->tm_hour * 3600 + timeinfo->tm_min * 60 + timeinfo->tm_sec;
+    uint32_t startSeconds = (uint32_t)next->start * 60;
+    uint32_t secondsUntil = startSeconds > nowSeconds ? startSeconds - nowSeconds : 0;
+
+    // Already holding (or loading) this event's image
+    if (jobActive && strcmp(jobSource, next->path) == 0) return;
+
+    // The previous next-event has started; its image is now pinned by the display
+    drop_job();
+
+    if (secondsUntil > leadTimeSeconds) return;
+
+    // Wait for the ingest task to transcode it, so the event start only has to read the .bin
+    char resolvedPath[96];
+    const char* nextPath = next->path;
+    if (image_ingest_resolve(next->path, resolvedPath, sizeof(resolvedPath))) {
+        nextPath = resolvedPath;
+    } else if (image_ingest_busy()) {
+        return;
+    }
+
+    Serial.printf("[PREFETCH] Loading %s (%lu s before %s)\n", nextPath,
+        (unsigned long)secondsUntil, next->label);
+    if (image_loader_job_begin(job, nextPath)) {
+        strncpy(jobSource, next->path, sizeof(jobSource) - 1);
+        jobActive = true;
+        jobReady = (job.loaded >= job.data_size);
+    }
+}
@@ -0,0 +1,260 @@
+#include "image_store.h"
+#include "image_ingest.h"
+#include "image_cache.h"
+#include "FS.h"
+#include "SD_MMC.h"
+#include "mbedtls/sha256.h"
+
+#define HASH_BUFFER_SIZE 4096
+#define GC_BATCH 16
+
+typedef struct {
+    char hex[IMAGE_STORE_HEX_LEN + 1];
+    char name[IMAGE_STORE_NAME_MAX + 1];
+} StoreEntry;
+
+static StoreEntry entries[IMAGE_STORE_MAX_ENTRIES];
+static uint8_t entryCount = 0;
+static bool indexLoaded = false;
+
+// Manifest being received; kept after commit so a repeated COMMIT changes nothing
+static StoreEntry pending[IMAGE_STORE_MAX_ENTRIES];
+static uint8_t pendingCount = 0;
+static bool pendingStarted = false;
+
+static void to_hex(const uint8_t* hash, char* out) {
+    static const char digits[] = "0123456789abcdef";
+    for (int i = 0; i < IMAGE_STORE_HASH_LEN; i++) {
+        out[i * 2] = digits[hash[i] >> 4];
+        out[i * 2 + 1] = digits[hash[i] & 0x0f];
+    }
+    out[IMAGE_STORE_HEX_LEN] = '\0';
+}
+
+static void blob_path(const char* hex, char* out, size_t out_len) {
+    snprintf(out, out_len, "%s/%s", IMAGE_STORE_BLOB_DIR, hex);
+}
+
+static const char* base_name(const char* path) {
+    const char* name = strrchr(path, '/');
+    return name ? name + 1 : path;
+}
+
+static void load_index() {
+    indexLoaded = true;
+    entryCount = 0;
+
+    File f = SD_MMC.open(IMAGE_STORE_INDEX, FILE_READ);
+    if (!f) return;
+
+    char line[IMAGE_STORE_HEX_LEN + IMAGE_STORE_NAME_MAX + 4];
+    while (f.available() && entryCount < IMAGE_STORE_MAX_ENTRIES) {
+        size_t n = f.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[n] = '\0';
+        if (n <= IMAGE_STORE_HEX_LEN + 1 || line[IMAGE_STORE_HEX_LEN] != ' ') continue;
+
+        StoreEntry& e = entries[entryCount];
+        memcpy(e.hex, line, IMAGE_STORE_HEX_LEN);
+        e.hex[IMAGE_STORE_HEX_LEN] = '\0';
+        strncpy(e.name, line + IMAGE_STORE_HEX_LEN + 1, sizeof(e.name) - 1);
+        e.name[sizeof(e.name) - 1] = '\0';
+        if (image_store_is_blob_name(e.hex)) entryCount++;
+    }
+    f.close();
+    Serial.printf("[IMAGE STORE] Index: %u images\n", entryCount);
+}
+
+/**
+ * Write the index beside the live one and rename, so a reader never sees a partial file
+ */
+static bool save_index() {
+    static const char tmpPath[] = IMAGE_STORE_INDEX ".tmp";
+    File f = SD_MMC.open(tmpPath, FILE_WRITE);
+    if (!f) return false;
+    bool ok = true;
+    for (uint8_t i = 0; i < entryCount && ok; i++) {
+        ok = f.printf("%s %s\n", entries[i].hex, entries[i].name) > 0;
+    }
+    f.close();
+
+    if (ok) {
+        SD_MMC.remove(IMAGE_STORE_INDEX);
+        ok = SD_MMC.rename(tmpPath, IMAGE_STORE_INDEX);
+    }
+    if (!ok) {
+        SD_MMC.remove(tmpPath);
+        Serial.println("[IMAGE STORE] ERROR: Failed to write index");
+    }
+    return ok;
+}
+
+static bool blob_stored(const char* hex) {
+    char path[96];
+    blob_path(hex, path, sizeof(path));
+    return SD_MMC.exists(path);
+}
+
+static bool referenced(const char* hex) {
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].hex, hex) == 0) return true;
+    }
+    return false;
+}
+
+/**
+ * Delete complete blobs the index does not name, with their transcoded .bin
+ * (partial .part uploads belong to the transfer manifest)
+ */
+static uint8_t collect_garbage() {
+    uint8_t removed = 0;
+    for (;;) {
+        char doomed[GC_BATCH][IMAGE_STORE_HEX_LEN + 1];
+        int found = 0;
+
+        File dir = SD_MMC.open(IMAGE_STORE_BLOB_DIR);
+        if (!dir) return removed;
+        File f;
+        while (found < GC_BATCH && (f = dir.openNextFile())) {
+            const char* name = base_name(f.name());
+            if (!f.isDirectory() && image_store_is_blob_name(name) && !referenced(name)) {
+                strcpy(doomed[found++], name);
+            }
+            f.close();
+        }
+        dir.close();
+        if (found == 0) return removed;
+
+        // Delete outside the directory walk
+        int deleted = 0;
+        for (int i = 0; i < found; i++) {
+            char path[96];
+            blob_path(doomed[i], path, sizeof(path));
+            if (!SD_MMC.remove(path)) {
+                Serial.printf("[IMAGE STORE] WARNING: Could not delete %s\n", path);
+                continue;
+            }
+            snprintf(path, sizeof(path), "%s/%s.bin", IMAGE_INGEST_DIR, doomed[i]);
+            SD_MMC.remove(path);
+            image_cache_invalidate(path);
+            deleted++;
+        }
+        removed += deleted;
+        // A pass that deletes nothing would find the same blobs again
+        if (found < GC_BATCH || deleted == 0) return removed;
+    }
+}
+
+bool image_store_is_blob_name(const char* name) {
+    for (int i = 0; i < IMAGE_STORE_HEX_LEN; i++) {
+        char c = name[i];
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+    }
+    return name[IMAGE_STORE_HEX_LEN] == '\0';
+}
+
+bool image_store_verify_blob(const char* path, const char* hex) {
+    File f = SD_MMC.open(path, FILE_READ);
+    if (!f) return false;
+    uint8_t* buf = (uint8_t*)malloc(HASH_BUFFER_SIZE);
+    if (!buf) {
+        f.close();
+        return false;
+    }
+
+    // SHA-256 runs on the hardware accelerator
+    mbedtls_sha256_context sha;
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts_ret(&sha, 0);
+    size_t n;
+    while ((n = f.read(buf, HASH_BUFFER_SIZE)) > 0) {
+        mbedtls_sha256_update_ret(&sha, buf, n);
+    }
+    uint8_t hash[IMAGE_STORE_HASH_LEN];
+    mbedtls_sha256_finish_ret(&sha, hash);
+    mbedtls_sha256_free(&sha);
+    free(buf);
+    f.close();
+
+    char actual[IMAGE_STORE_HEX_LEN + 1];
+    to_hex(hash, actual);
+    if (strcmp(actual, hex) != 0) {
+        Serial.printf("[IMAGE STORE] ✗ SHA-256 mismatch: %s\n", actual);
+        return false;
+    }
+    return true;
+}
+
+bool image_store_resolve(const char* path, char* out, size_t out_len) {
+    if (!path || SD_MMC.cardType() == CARD_NONE) return false;
+    if (!indexLoaded) load_index();
+
+    const char* name = base_name(path);
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            blob_path(entries[i].hex, out, out_len);
+            return true;
+        }
+    }
+    return false;
+}
+
+void image_store_forget(const char* name) {
+    if (!indexLoaded) load_index();
+
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            entries[i] = entries[--entryCount];
+            save_index();
+            Serial.printf("[IMAGE STORE] %s replaced by a plain upload\n", name);
+            return;
+        }
+    }
+}
+
+bool image_store_sync_entry(uint8_t seq, const uint8_t* hash, const char* name, bool* present) {
+    if (seq == 0) {
+        pendingCount = 0;
+        pendingStarted = true;
+    }
+    if (seq != pendingCount || seq >= IMAGE_STORE_MAX_ENTRIES) return false;
+    if (name[0] == '\0' || strlen(name) > IMAGE_STORE_NAME_MAX || strchr(name, '/')) return false;
+
+    StoreEntry& e = pending[pendingCount++];
+    to_hex(hash, e.hex);
+    strcpy(e.name, name);
+    *present = blob_stored(e.hex);
+    return true;
+}
+
+bool image_store_sync_commit(uint8_t count, ImageStoreSyncResult* result) {
+    memset(result, 0, sizeof(*result));
+    if (!pendingStarted || count != pendingCount) return false;
+    if (!indexLoaded) load_index();
+
+    // Only a manifest whose every image is here replaces the index
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        if (!blob_stored(pending[i].hex)) result->missing++;
+    }
+    if (result->missing) return false;
+
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        bool same = false;
+        for (uint8_t j = 0; j < entryCount; j++) {
+            if (strcmp(entries[j].name, pending[i].name) == 0) {
+                same = strcmp(entries[j].hex, pending[i].hex) == 0;
+                break;
+            }
+        }
+        if (!same) result->changed = true;
+    }
+    if (pendingCount != entryCount) result->changed = true;
+
+    memcpy(entries, pending, sizeof(StoreEntry) * pendingCount);
+    entryCount = pendingCount;
+    if (result->changed && !save_index()) return false;
+
+    result->removed = collect_garbage();
+    Serial.printf("[IMAGE STORE] Synced %u images (%s), %u unreferenced blobs removed\n",
+                  entryCount, result->changed ? "changed" : "unchanged", result->removed);
+    return true;
+}
@@ -0,0 +1,334 @@
+#include "image_transcoder.h"
+#include <string.h>
+#include <stdlib.h>
+
+static inline uint32_t rd_le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static inline uint32_t rd_le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24); }
+static inline uint32_t rd_be32(const uint8_t* p) { return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3]; }
+
+static inline void wr_le32(uint8_t* p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+// ============ BMP ============
+
+bool transcoder_parse_bmp(const uint8_t* file, size_t len, TranscodeSource* src) {
+    if (len < 54 || file[0] != 'B' || file[1] != 'M') return false;
+
+    uint32_t dataOffset = rd_le32(file + 10);
+    int32_t w = (int32_t)rd_le32(file + 18);
+    int32_t h = (int32_t)rd_le32(file + 22);
+    uint32_t bpp = rd_le16(file + 28);
+    uint32_t compression = rd_le32(file + 30);
+
+    // BI_RGB, or BI_BITFIELDS with the default 32-bit layout
+    if (w <= 0 || h == 0 || (bpp != 24 && bpp != 32) || (compression != 0 && compression != 3)) return false;
+
+    bool bottomUp = h > 0;
+    uint32_t absH = bottomUp ? (uint32_t)h : (uint32_t)-h;
+    // 64-bit: size_t is 32 bits on the ESP32 and a corrupt header must not wrap
+    uint64_t stride64 = ((uint64_t)w * (bpp / 8) + 3) & ~(uint64_t)3;
+    if (dataOffset > len || stride64 * absH > len - dataOffset) return false;
+    uint32_t stride = (uint32_t)stride64;
+
+    src->w = (uint32_t)w;
+    src->h = absH;
+    src->format = bpp == 24 ? TRANSCODE_FMT_BGR888 : TRANSCODE_FMT_BGRA8888;
+    if (bottomUp) {
+        src->data = file + dataOffset + (size_t)stride * (absH - 1);
+        src->stride = -(int32_t)stride;
+    } else {
+        src->data = file + dataOffset;
+        src->stride = (int32_t)stride;
+    }
+    return true;
+}
+
+// ============ PNG ============
+
+static const uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+
+static int png_channels(uint8_t colorType) {
+    switch (colorType) {
+        case 0: return 1;  // Gray
+        case 2: return 3;  // RGB
+        case 3: return 1;  // Palette
+        case 4: return 2;  // Gray + alpha
+        case 6: return 4;  // RGBA
+        default: return 0;
+    }
+}
+
+size_t transcoder_png_raw_size(const uint8_t* file, size_t len, uint32_t* w, uint32_t* h) {
+    if (len < 33 || memcmp(file, PNG_SIGNATURE, 8) != 0 || memcmp(file + 12, "IHDR", 4) != 0) return 0;
+
+    uint32_t width = rd_be32(file + 16);
+    uint32_t height = rd_be32(file + 20);
+    uint8_t bitDepth = file[24];
+    uint8_t colorType = file[25];
+    uint8_t interlace = file[28];
+    int channels = png_channels(colorType);
+
+    if (width == 0 || height == 0 || bitDepth != 8 || channels == 0 || interlace != 0) return 0;
+
+    if (w) *w = width;
+    if (h) *h = height;
+    uint64_t size = (uint64_t)height * (1 + (uint64_t)width * channels);
+    return size > SIZE_MAX ? 0 : (size_t)size;
+}
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c) {
+    int p = (int)a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return a;
+    return pb <= pc ? b : c;
+}
+
+/**
+ * Undo PNG row filters in place; each row keeps its leading filter byte
+ */
+static bool png_unfilter(uint8_t* raw, uint32_t w, uint32_t h, int bpp) {
+    size_t rowBytes = (size_t)w * bpp;
+    size_t stride = rowBytes + 1;
+    const uint8_t* prev = NULL;
+
+    for (uint32_t y = 0; y < h; y++) {
+        uint8_t* row = raw + y * stride;
+        uint8_t filter = row[0];
+        uint8_t* cur = row + 1;
+
+        for (size_t i = 0; i < rowBytes; i++) {
+            uint8_t a = i >= (size_t)bpp ? cur[i - bpp] : 0;
+            uint8_t b = prev ? prev[i] : 0;
+            uint8_t c = (prev && i >= (size_t)bpp) ? prev[i - bpp] : 0;
+            switch (filter) {
+                case 0: break;
+                case 1: cur[i] += a; break;
+                case 2: cur[i] += b; break;
+                case 3: cur[i] += (uint8_t)(((int)a + b) >> 1); break;
+                case 4: cur[i] += paeth(a, b, c); break;
+                default: return false;
+            }
+        }
+        prev = cur;
+    }
+    return true;
+}
+
+bool transcoder_decode_png(uint8_t* file, size_t len, uint8_t* raw, size_t raw_size,
+                           transcoder_inflate_fn inflate, TranscodeSource* src) {
+    uint32_t w = 0, h = 0;
+    if (transcoder_png_raw_size(file, len, &w, &h) != raw_size || raw_size == 0) return false;
+
+    uint8_t colorType = file[25];
+    int channels = png_channels(colorType);
+
+    // Default palette alpha is opaque
+    for (int i = 0; i < 256; i++) {
+        src->palette[i * 4 + 3] = 0xFF;
+    }
+
+    // Walk the chunks, moving IDAT payloads down to the start of the buffer
+    size_t pos = 8;
+    size_t idatLen = 0;
+    while (pos + 12 <= len) {
+        uint32_t chunkLen = rd_be32(file + pos);
+        const uint8_t* type = file + pos + 4;
+        uint8_t* data = file + pos + 8;
+        if (chunkLen > len - pos - 12) return false;   // pos + 12 <= len; the sum could wrap
+
+        if (memcmp(type, "IDAT", 4) == 0) {
+            memmove(file + idatLen, data, chunkLen);
+            idatLen += chunkLen;
+        } else if (memcmp(type, "PLTE", 4) == 0) {
+            for (uint32_t i = 0; i < chunkLen / 3 && i < 256; i++) {
+                src->palette[i * 4 + 0] = data[i * 3 + 0];
+                src->palette[i * 4 + 1] = data[i * 3 + 1];
+                src->palette[i * 4 + 2] = data[i * 3 + 2];
+            }
+        } else if (memcmp(type, "tRNS", 4) == 0 && colorType == 3) {
+            for (uint32_t i = 0; i < chunkLen && i < 256; i++) {
+                src->palette[i * 4 + 3] = data[i];
+            }
+        } else if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        pos += 12 + chunkLen;
+    }
+
+    if (idatLen == 0 || inflate(file, idatLen, raw, raw_size) != raw_size) return false;
+    if (!png_unfilter(raw, w, h, channels)) return false;
+
+    static const TranscodeFormat formats[] = {
+        TRANSCODE_FMT_GRAY8, TRANSCODE_FMT_GRAY8, TRANSCODE_FMT_RGB888, TRANSCODE_FMT_PALETTE8,
+        TRANSCODE_FMT_GRAYA8, TRANSCODE_FMT_GRAY8, TRANSCODE_FMT_RGBA8888,
+    };
+    src->format = formats[colorType];
+    src->w = w;
+    src->h = h;
+    src->data = raw + 1;
+    src->stride = (int32_t)(1 + (size_t)w * channels);
+    return true;
+}
+
+// ============ SCALING ============
+
+static inline void fetch_rgb(const TranscodeSource* src, const uint8_t* row, uint32_t x,
+                             uint32_t* r, uint32_t* g, uint32_t* b) {
+    uint32_t a = 255;
+    switch (src->format) {
+        case TRANSCODE_FMT_GRAY8:    *r = *g = *b = row[x]; return;
+        case TRANSCODE_FMT_GRAYA8:   *r = *g = *b = row[x * 2]; a = row[x * 2 + 1]; break;
+        case TRANSCODE_FMT_RGB888:   *r = row[x * 3]; *g = row[x * 3 + 1]; *b = row[x * 3 + 2]; return;
+        case TRANSCODE_FMT_RGBA8888: *r = row[x * 4]; *g = row[x * 4 + 1]; *b = row[x * 4 + 2]; a = row[x * 4 + 3]; break;
+        case TRANSCODE_FMT_BGR888:   *b = row[x * 3]; *g = row[x * 3 + 1]; *r = row[x * 3 + 2]; return;
+        case TRANSCODE_FMT_BGRA8888: *b = row[x * 4]; *g = row[x * 4 + 1]; *r = row[x * 4 + 2]; return;
+        case TRANSCODE_FMT_PALETTE8: {
+            const uint8_t* p = src->palette + row[x] * 4;
+            *r = p[0]; *g = p[1]; *b = p[2]; a = p[3];
+            break;
+        }
+    }
+    // Composite over black
+    *r = *r * a / 255;
+    *g = *g * a / 255;
+    *b = *b * a / 255;
+}
+
+bool transcoder_scale_to_rgb565(const TranscodeSource* src, uint16_t* dst, uint32_t dst_w, uint32_t dst_h) {
+    // Crop the source to the target aspect ratio (cover), centred
+    uint32_t cropW = src->w, cropH = src->h;
+    if ((uint64_t)src->w * dst_h > (uint64_t)src->h * dst_w) {
+        cropW = (uint32_t)((uint64_t)src->h * dst_w / dst_h);
+    } else {
+        cropH = (uint32_t)((uint64_t)src->w * dst_h / dst_w);
+    }
+    if (cropW == 0) cropW = 1;
+    if (cropH == 0) cropH = 1;
+    uint32_t cropX = (src->w - cropW) / 2;
+    uint32_t cropY = (src->h - cropH) / 2;
+
+    uint32_t* acc = (uint32_t*)malloc((size_t)dst_w * 4 * sizeof(uint32_t));
+    if (!acc) return false;
+
+    for (uint32_t y = 0; y < dst_h; y++) {
+        uint32_t sy0 = cropY + (uint32_t)((uint64_t)y * cropH / dst_h);
+        uint32_t sy1 = cropY + (uint32_t)((uint64_t)(y + 1) * cropH / dst_h);
+        if (sy1 <= sy0) sy1 = sy0 + 1;
+
+        memset(acc, 0, (size_t)dst_w * 4 * sizeof(uint32_t));
+        for (uint32_t sy = sy0; sy < sy1; sy++) {
+            const uint8_t* row = src->data + (int64_t)sy * src->stride;
+            for (uint32_t x = 0; x < dst_w; x++) {
+                uint32_t sx0 = cropX + (uint32_t)((uint64_t)x * cropW / dst_w);
+                uint32_t sx1 = cropX + (uint32_t)((uint64_t)(x + 1) * cropW / dst_w);
+                if (sx1 <= sx0) sx1 = sx0 + 1;
+
+                uint32_t* a = acc + x * 4;
+                for (uint32_t sx = sx0; sx < sx1; sx++) {
+                    uint32_t r = 0, g = 0, b = 0;
+                    fetch_rgb(src, row, sx, &r, &g, &b);
+                    a[0] += r;
+                    a[1] += g;
+                    a[2] += b;
+                    a[3]++;
+                }
+            }
+        }
+
+        uint16_t* out = dst + (size_t)y * dst_w;
+        for (uint32_t x = 0; x < dst_w; x++) {
+            const uint32_t* a = acc + x * 4;
+            uint32_t r = a[0] / a[3], g = a[1] / a[3], b = a[2] / a[3];
+            out[x] = (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+        }
+    }
+
+    free(acc);
+    return true;
+}
+
+// ============ RLE ============
+
+size_t transcoder_rle_encode(const uint8_t* in, size_t len, uint8_t blk, uint8_t* out, size_t out_cap) {
+    size_t blocks = len / blk;
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < blocks) {
+        // Length of the run of identical blocks starting at i
+        size_t run = 1;
+        while (i + run < blocks && run < 127 &&
+               memcmp(in + (i + run) * blk, in + i * blk, blk) == 0) {
+            run++;
+        }
+
+        if (run >= 2) {
+            if (o + 1 + blk > out_cap) return 0;
+            out[o++] = (uint8_t)run;
+            memcpy(out + o, in + i * blk, blk);
+            o += blk;
+            i += run;
+            continue;
+        }
+
+        // Literal span until the next repeat
+        size_t lit = 1;
+        while (i + lit < blocks && lit < 127 &&
+               !(i + lit + 1 < blocks &&
+                 memcmp(in + (i + lit) * blk, in + (i + lit + 1) * blk, blk) == 0)) {
+            lit++;
+        }
+        if (o + 1 + lit * blk > out_cap) return 0;
+        out[o++] = (uint8_t)(0x80 | lit);
+        memcpy(out + o, in + i * blk, lit * blk);
+        o += lit * blk;
+        i += lit;
+    }
+    return o;
+}
+
+size_t transcoder_rle_decode(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_cap, uint8_t blk) {
+    size_t i = 0;
+    size_t o = 0;
+
+    while (i < in_len) {
+        uint8_t ctrl = in[i++];
+        size_t count = ctrl & 0x7F;
+
+        if (ctrl & 0x80) {
+            size_t bytes = count * blk;
+            if (i + bytes > in_len || o + bytes > out_cap) return 0;
+            memcpy(out + o, in + i, bytes);
+            i += bytes;
+            o += bytes;
+        } else {
+            if (i + blk > in_len || o + count * blk > out_cap) return 0;
+            for (size_t k = 0; k < count; k++) {
+                memcpy(out + o, in + i, blk);
+                o += blk;
+            }
+            i += blk;
+        }
+    }
+    return o;
+}
+
+// ============ LVGL BINARY ============
+
+size_t transcoder_write_bin_header(uint8_t* out, uint32_t w, uint32_t h, size_t rle_size) {
+    uint32_t flags = rle_size ? TRANSCODE_LV_FLAG_COMPRESSED : 0;
+    uint32_t stride = w * 2;
+
+    // lv_image_header_t: magic:8 cf:8 flags:16 | w:16 h:16 | stride:16 reserved:16
+    wr_le32(out + 0, TRANSCODE_LV_MAGIC | (TRANSCODE_LV_CF_RGB565 << 8) | (flags << 16));
+    wr_le32(out + 4, (w & 0xFFFF) | ((h & 0xFFFF) << 16));
+    wr_le32(out + 8, stride & 0xFFFF);
+    if (!rle_size) return 12;
+
+    // Compression header: method:4 reserved:28 | compressed_size | decompressed_size
+    wr_le32(out + 12, TRANSCODE_LV_COMPRESS_RLE);
+    wr_le32(out + 16, (uint32_t)rle_size);
+    wr_le32(out + 20, stride * h);
+    return 24;
+}
@@ -0,0 +1,93 @@
+#include "json_event_stream.h"
+
+enum {
+    SEEK_KEY,       // Looking for "events"
+    SEEK_ARRAY,     // Looking for its '['
+    IN_ARRAY,       // Between objects
+    IN_OBJECT,
+    DONE,
+    STOPPED
+};
+
+static const char EVENTS_KEY[] = "\"events\"";
+
+void json_event_stream_init(JsonEventStream* s, JsonEventFn fn, void* ctx) {
+    s->fn = fn;
+    s->ctx = ctx;
+    s->state = SEEK_KEY;
+    s->key_pos = 0;
+    s->depth = 0;
+    s->in_string = false;
+    s->escape = false;
+    s->obj_len = 0;
+    s->objects = 0;
+}
+
+static void append(JsonEventStream* s, char c) {
+    if (s->obj_len + 1 < JSON_EVENT_OBJECT_MAX) s->obj[s->obj_len++] = c;
+}
+
+bool json_event_stream_feed(JsonEventStream* s, const char* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        switch (s->state) {
+            case SEEK_KEY:
+                if (c == EVENTS_KEY[s->key_pos]) {
+                    if (++s->key_pos == sizeof(EVENTS_KEY) - 1) s->state = SEEK_ARRAY;
+                } else {
+                    // The key starts with its only quote, so a mismatch restarts at most one back
+                    s->key_pos = c == '"' ? 1 : 0;
+                }
+                break;
+
+            case SEEK_ARRAY:
+                if (c == '[') s->state = IN_ARRAY;
+                break;
+
+            case IN_ARRAY:
+                if (c == ']') {
+                    s->state = DONE;
+                } else if (c == '{') {
+                    s->state = IN_OBJECT;
+                    s->depth = 1;
+                    s->in_string = false;
+                    s->escape = false;
+                    s->obj_len = 0;
+                    append(s, c);
+                }
+                break;
+
+            case IN_OBJECT:
+                append(s, c);
+                if (s->in_string) {
+                    if (s->escape) s->escape = false;
+                    else if (c == '\\') s->escape = true;
+                    else if (c == '"') s->in_string = false;
+                } else if (c == '"') {
+                    s->in_string = true;
+                } else if (c == '{') {
+                    s->depth++;
+                } else if (c == '}' && --s->depth == 0) {
+                    s->obj[s->obj_len] = '\0';
+                    s->objects++;
+                    s->state = IN_ARRAY;
+                    if (!s->fn(s->ctx, s->obj, s->obj_len)) {
+                        s->state = STOPPED;
+                        return false;
+                    }
+                }
+                break;
+
+            case DONE:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+bool json_event_stream_done(const JsonEventStream* s) {
+    return s->state == DONE;
+}
@@ -3,6 +3,7 @@
 #include "timer_functions.h"
 #include "timer_event_handler.h"
 #include "schedule_manager.h"
+#include "image_prefetch.h"
 #include <Arduino.h>
 
 
@@ -81,6 +82,8 @@ void logic_fsm_tick()
             timer_pop_next(current_evt);
             start_timer(current_evt.duration);
             update_event_text(current_evt.label);
+            image_prefetch_mark_boundary(current_evt.path);
+            update_background_image(current_evt.path);
             break;
 
         case State::run: {
@@ -0,0 +1,199 @@
+#include "lv_fs_sd.h"
+#include "asset_bundle.h"
+#include <string.h>
+#include <stdio.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include "FS.h"
+#include "SD_MMC.h"
+#include "esp_heap_caps.h"
+#define FS_LOG(...) Serial.printf(__VA_ARGS__)
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <stdlib.h>
+#define FS_LOG(...) printf(__VA_ARGS__)
+#endif
+
+#define SD_MOUNT_PREFIX "/sdcard"
+
+typedef struct {
+    bool in_use;
+#ifdef ARDUINO
+    File file;
+#else
+    int fd;
+#endif
+    uint32_t base;           // Start of the file in the backend file (bundled assets)
+    BlockReader reader;
+} SdHandle;
+
+static SdHandle handles[LV_FS_SD_MAX_HANDLES];
+static uint8_t* windows = nullptr;
+static BlockReaderStats stats;
+static lv_fs_drv_t drv;
+
+/**
+ * Paths are relative to the SD mount; strip "/sdcard" if present
+ */
+static const char* to_sd_path(const char* path) {
+    size_t prefixLen = strlen(SD_MOUNT_PREFIX);
+    if (strncmp(path, SD_MOUNT_PREFIX, prefixLen) == 0 && path[prefixLen] == '/') {
+        return path + prefixLen;
+    }
+    return path;
+}
+
+// ============ STORAGE BACKENDS ============
+
+#ifdef ARDUINO
+static int32_t backend_read_at(void* ctx, uint32_t offset, uint8_t* buf, uint32_t len) {
+    SdHandle* h = (SdHandle*)ctx;
+    offset += h->base;
+    if (h->file.position() != offset && !h->file.seek(offset)) return -1;
+    return (int32_t)h->file.read(buf, len);
+}
+
+static bool backend_open(SdHandle* h, const char* path, uint32_t* size) {
+    h->file = SD_MMC.open(to_sd_path(path), FILE_READ);
+    if (!h->file || h->file.isDirectory()) {
+        if (h->file) h->file.close();
+        return false;
+    }
+    *size = h->file.size();
+    return true;
+}
+
+static void backend_close(SdHandle* h) {
+    h->file.close();
+}
+#else
+static int32_t backend_read_at(void* ctx, uint32_t offset, uint8_t* buf, uint32_t len) {
+    SdHandle* h = (SdHandle*)ctx;
+    return (int32_t)pread(h->fd, buf, len, (off_t)h->base + offset);
+}
+
+static bool backend_open(SdHandle* h, const char* path, uint32_t* size) {
+    char full[256];
+    snprintf(full, sizeof(full), "%s%s", LV_FS_SD_HOST_ROOT, to_sd_path(path));
+    h->fd = open(full, O_RDONLY);
+    if (h->fd < 0) return false;
+
+    struct stat st;
+    if (fstat(h->fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(h->fd);
+        return false;
+    }
+    *size = (uint32_t)st.st_size;
+    return true;
+}
+
+static void backend_close(SdHandle* h) {
+    close(h->fd);
+}
+#endif
+
+// ============ LVGL DRIVER CALLBACKS ============
+
+static void* fs_open(lv_fs_drv_t* d, const char* path, lv_fs_mode_t mode) {
+    if (mode != LV_FS_MODE_RD) return NULL;  // Read-only drive
+
+    for (int i = 0; i < LV_FS_SD_MAX_HANDLES; i++) {
+        SdHandle* h = &handles[i];
+        if (h->in_use) continue;
+
+        // A bundled asset is a byte range of the bundle file; bundle offsets are
+        // sector-aligned so the read-ahead windows stay aligned too
+        const AssetBundleEntry* asset = asset_bundle_lookup(to_sd_path(path));
+        uint32_t size = 0;
+        if (!backend_open(h, asset ? asset_bundle_path() : path, &size)) return NULL;
+        h->base = asset ? asset->offset : 0;
+        if (asset) size = asset->size;
+
+        block_reader_init(&h->reader, backend_read_at, h, size,
+                          windows + (size_t)i * LV_FS_SD_WINDOW_SIZE, LV_FS_SD_WINDOW_SIZE, &stats);
+        h->in_use = true;
+        return h;
+    }
+
+    FS_LOG("[FS] No free handle for %s\n", path);
+    return NULL;
+}
+
+static lv_fs_res_t fs_close(lv_fs_drv_t* d, void* file_p) {
+    SdHandle* h = (SdHandle*)file_p;
+    backend_close(h);
+    h->in_use = false;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read(lv_fs_drv_t* d, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
+    SdHandle* h = (SdHandle*)file_p;
+    int32_t n = block_reader_read(&h->reader, buf, btr);
+    if (n < 0) {
+        *br = 0;
+        return LV_FS_RES_HW_ERR;
+    }
+    *br = (uint32_t)n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek(lv_fs_drv_t* d, void* file_p, uint32_t pos, lv_fs_whence_t whence) {
+    SdHandle* h = (SdHandle*)file_p;
+    BlockReader* r = &h->reader;
+
+    switch (whence) {
+        case LV_FS_SEEK_SET: block_reader_seek(r, pos); break;
+        case LV_FS_SEEK_CUR: block_reader_seek(r, r->pos + pos); break;
+        case LV_FS_SEEK_END: block_reader_seek(r, r->file_size + pos); break;
+        default: return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell(lv_fs_drv_t* d, void* file_p, uint32_t* pos_p) {
+    *pos_p = ((SdHandle*)file_p)->reader.pos;
+    return LV_FS_RES_OK;
+}
+
+// ============ PUBLIC API ============
+
+void lv_fs_sd_init() {
+    size_t windowBytes = (size_t)LV_FS_SD_MAX_HANDLES * LV_FS_SD_WINDOW_SIZE;
+#ifdef ARDUINO
+    windows = (uint8_t*)heap_caps_aligned_alloc(4, windowBytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+#else
+    windows = (uint8_t*)malloc(windowBytes);
+#endif
+    if (!windows) {
+        FS_LOG("[FS] Failed to allocate %u bytes of read-ahead buffers\n", (unsigned int)windowBytes);
+        return;
+    }
+    memset(handles, 0, sizeof(handles));
+    memset(&stats, 0, sizeof(stats));
+
+    lv_fs_drv_init(&drv);
+    drv.letter = LV_FS_SD_LETTER;
+    drv.cache_size = 0;  // block_reader already buffers
+    drv.open_cb = fs_open;
+    drv.close_cb = fs_close;
+    drv.read_cb = fs_read;
+    drv.seek_cb = fs_seek;
+    drv.tell_cb = fs_tell;
+    lv_fs_drv_register(&drv);
+
+    FS_LOG("[FS] Drive %c: registered (%d handles, %u KB read-ahead each)\n",
+        LV_FS_SD_LETTER, LV_FS_SD_MAX_HANDLES, (unsigned int)(LV_FS_SD_WINDOW_SIZE / 1024));
+}
+
+void lv_fs_sd_get_stats(BlockReaderStats* out) {
+    *out = stats;
+}
+
+void lv_fs_sd_log_stats() {
+    FS_LOG("[FS] %u bytes requested, %u bytes in %u storage reads\n",
+        (unsigned int)stats.requested_bytes, (unsigned int)stats.device_bytes,
+        (unsigned int)stats.device_reads);
+}
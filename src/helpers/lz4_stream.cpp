@@ -0,0 +1,112 @@
+#include "lz4_stream.h"
+#include <string.h>
+
+#define MIN_MATCH 4
+
+/**
+ * Read an LZ4 length: the 4-bit token field, extended by bytes while they are 255
+ */
+static bool read_length(const uint8_t** ip, const uint8_t* end, size_t* len) {
+    if (*len != 15) return true;
+    uint8_t b;
+    do {
+        if (*ip >= end) return false;
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+int lz4_decode_block(const uint8_t* src, size_t src_len, uint8_t* dst, size_t dst_cap) {
+    const uint8_t* ip = src;
+    const uint8_t* end = src + src_len;
+    size_t op = 0;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+
+        size_t lit = token >> 4;
+        if (!read_length(&ip, end, &lit)) return -1;
+        if (lit > (size_t)(end - ip) || lit > dst_cap - op) return -1;
+        memcpy(dst + op, ip, lit);
+        ip += lit;
+        op += lit;
+
+        // The last sequence has literals only
+        if (ip == end) break;
+
+        if (end - ip < 2) return -1;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op) return -1;
+
+        size_t match = token & 15;
+        if (!read_length(&ip, end, &match)) return -1;
+        match += MIN_MATCH;
+        if (match > dst_cap - op) return -1;
+
+        // Byte by byte: the match may overlap its own output
+        const uint8_t* from = dst + op - offset;
+        for (size_t i = 0; i < match; i++) dst[op + i] = from[i];
+        op += match;
+    }
+    return (int)op;
+}
+
+void lz4_stream_init(Lz4Stream* s, Lz4StreamOutputFn out, void* ctx) {
+    s->out = out;
+    s->ctx = ctx;
+    s->header_len = 0;
+    s->have = 0;
+    s->failed = false;
+}
+
+static bool finish_block(Lz4Stream* s) {
+    s->header_len = 0;
+    s->have = 0;
+    if (s->stored) return s->out(s->ctx, s->in, s->comp_len);
+
+    int n = lz4_decode_block(s->in, s->comp_len, s->raw, s->raw_len);
+    if (n != s->raw_len) return false;
+    return s->out(s->ctx, s->raw, (size_t)n);
+}
+
+bool lz4_stream_feed(Lz4Stream* s, const uint8_t* data, size_t len) {
+    if (s->failed) return false;
+
+    while (len > 0) {
+        if (s->header_len < sizeof(s->header)) {
+            s->header[s->header_len++] = *data++;
+            len--;
+            if (s->header_len < sizeof(s->header)) continue;
+
+            uint16_t comp = (uint16_t)(s->header[0] | (s->header[1] << 8));
+            s->stored = (comp & LZ4_STREAM_STORED) != 0;
+            s->comp_len = comp & ~LZ4_STREAM_STORED;
+            s->raw_len = (uint16_t)(s->header[2] | (s->header[3] << 8));
+            if (s->comp_len == 0 || s->comp_len > LZ4_STREAM_BLOCK_MAX || s->raw_len > LZ4_STREAM_BLOCK_MAX ||
+                (s->stored && s->comp_len != s->raw_len)) {
+                s->failed = true;
+                return false;
+            }
+            continue;
+        }
+
+        size_t n = s->comp_len - s->have;
+        if (n > len) n = len;
+        memcpy(s->in + s->have, data, n);
+        s->have += n;
+        data += n;
+        len -= n;
+
+        if (s->have == s->comp_len && !finish_block(s)) {
+            s->failed = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool lz4_stream_complete(const Lz4Stream* s) {
+    return !s->failed && s->header_len == 0;
+}
@@ -0,0 +1,98 @@
+#include "refresh_governor.h"
+#include <Arduino.h>
+
+static const uint32_t mode_period[REFRESH_MODE_COUNT] = {
+    REFRESH_GOVERNOR_IDLE_MS,
+    REFRESH_GOVERNOR_ACTIVE_MS,
+};
+static const char* const mode_name[REFRESH_MODE_COUNT] = {"idle", "active"};
+
+static lv_timer_t* refr_timer = NULL;
+static lv_indev_t* gov_indev = NULL;
+static RefreshMode mode = REFRESH_MODE_IDLE;
+static uint32_t quiet_ms = REFRESH_GOVERNOR_QUIET_MS;
+static uint32_t last_activity_ms = 0;
+
+// Stats since the last log
+static uint32_t mode_since_ms = 0;
+static uint32_t mode_time_ms[REFRESH_MODE_COUNT] = {0};
+static uint32_t switch_count = 0;
+
+static void account_time() {
+    uint32_t now = millis();
+    mode_time_ms[mode] += now - mode_since_ms;
+    mode_since_ms = now;
+}
+
+static void set_mode(RefreshMode next) {
+    if (next == mode) return;
+    account_time();
+    mode = next;
+    switch_count++;
+
+    lv_timer_set_period(refr_timer, mode_period[mode]);
+    // Don't sit out the rest of a long idle period after a touch
+    if (mode == REFRESH_MODE_ACTIVE) lv_timer_ready(refr_timer);
+}
+
+static bool is_busy() {
+    if (lv_anim_count_running() > 0) return true;
+    if (gov_indev) {
+        if (lv_indev_get_state(gov_indev) == LV_INDEV_STATE_PRESSED) return true;
+        // Stays set through the scroll throw after release
+        if (lv_indev_get_scroll_obj(gov_indev)) return true;
+    }
+    return false;
+}
+
+static void poll_cb(lv_timer_t* t) {
+    (void)t;
+    if (is_busy()) {
+        refresh_governor_boost();
+    } else if (mode == REFRESH_MODE_ACTIVE && millis() - last_activity_ms >= quiet_ms) {
+        set_mode(REFRESH_MODE_IDLE);
+    }
+}
+
+void refresh_governor_init(lv_display_t* disp, lv_indev_t* indev) {
+    refr_timer = lv_display_get_refr_timer(disp);
+    if (!refr_timer) {
+        Serial.println("[REFR] Display has no refresh timer, governor disabled");
+        return;
+    }
+    gov_indev = indev;
+    mode = REFRESH_MODE_IDLE;
+    mode_since_ms = millis();
+    lv_timer_set_period(refr_timer, mode_period[mode]);
+    lv_timer_create(poll_cb, REFRESH_GOVERNOR_POLL_MS, NULL);
+}
+
+void refresh_governor_boost() {
+    if (!refr_timer) return;
+    last_activity_ms = millis();
+    set_mode(REFRESH_MODE_ACTIVE);
+}
+
+void refresh_governor_set_quiet_ms(uint32_t ms) {
+    quiet_ms = ms;
+}
+
+RefreshMode refresh_governor_get_mode() {
+    return mode;
+}
+
+uint32_t refresh_governor_get_period() {
+    return refr_timer ? mode_period[mode] : LV_DEF_REFR_PERIOD;
+}
+
+void refresh_governor_log_stats() {
+    if (!refr_timer) return;
+    account_time();
+    Serial.printf("[REFR] %s at %lu ms; %s %lu ms, %s %lu ms, %lu switches\n",
+                  mode_name[mode], (unsigned long)mode_period[mode],
+                  mode_name[REFRESH_MODE_IDLE], (unsigned long)mode_time_ms[REFRESH_MODE_IDLE],
+                  mode_name[REFRESH_MODE_ACTIVE], (unsigned long)mode_time_ms[REFRESH_MODE_ACTIVE],
+                  (unsigned long)switch_count);
+    for (int i = 0; i < REFRESH_MODE_COUNT; i++) mode_time_ms[i] = 0;
+    switch_count = 0;
+}
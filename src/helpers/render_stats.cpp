@@ -0,0 +1,62 @@
+#include "render_stats.h"
+#include <Arduino.h>
+
+static uint32_t flush_count = 0;
+static uint32_t frame_count = 0;
+static uint64_t flushed_px = 0;
+static uint64_t skipped_px = 0;
+static uint32_t window_start_ms = 0;
+static uint32_t refr_start_us = 0;
+static uint32_t refr_count = 0;
+static uint64_t refr_total_us = 0;
+static uint32_t refr_max_us = 0;
+
+static void refr_event_cb(lv_event_t* e) {
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        refr_start_us = micros();
+        return;
+    }
+    uint32_t us = micros() - refr_start_us;
+    refr_count++;
+    refr_total_us += us;
+    if (us > refr_max_us) refr_max_us = us;
+}
+
+void render_stats_attach(lv_display_t* disp) {
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+}
+
+void render_stats_add_flush(lv_display_t* disp, const lv_area_t* area) {
+    flush_count++;
+    flushed_px += (uint64_t)lv_area_get_width(area) * lv_area_get_height(area);
+    if (lv_display_flush_is_last(disp)) frame_count++;
+}
+
+void render_stats_add_skipped(uint32_t px) {
+    skipped_px += px;
+}
+
+void render_stats_log() {
+    uint32_t elapsed = millis() - window_start_ms;
+    uint32_t screen_px = (uint32_t)lv_display_get_horizontal_resolution(NULL) *
+                         lv_display_get_vertical_resolution(NULL);
+    Serial.printf("[RENDER] %lu ms: %lu refreshes, %lu flushes, %llu px (%.1f full screens)\n",
+                  (unsigned long)elapsed, (unsigned long)frame_count, (unsigned long)flush_count,
+                  (unsigned long long)flushed_px, screen_px ? (double)flushed_px / screen_px : 0.0);
+    if (skipped_px) {
+        Serial.printf("[RENDER] %llu px outside the round panel not copied\n",
+                      (unsigned long long)skipped_px);
+    }
+    Serial.printf("[RENDER] refresh time: %.2f ms total, %.2f ms avg, %.2f ms max over %lu refreshes\n",
+                  refr_total_us / 1000.0, refr_count ? refr_total_us / 1000.0 / refr_count : 0.0,
+                  refr_max_us / 1000.0, (unsigned long)refr_count);
+    flush_count = 0;
+    frame_count = 0;
+    flushed_px = 0;
+    skipped_px = 0;
+    refr_count = 0;
+    refr_total_us = 0;
+    refr_max_us = 0;
+    window_start_ms = millis();
+}
@@ -0,0 +1,165 @@
+#include "ring_arc.h"
+#include "ring_mask.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <math.h>
+
+typedef struct {
+    RingMask mask;
+    void* buf;
+    lv_image_dsc_t image;    // A8 view of mask.alpha
+} RingArcMask;
+
+static RingArcMask masks[RING_ARC_MAX_MASKS];
+static int mask_count = 0;
+
+static RingArcMask* get_mask(uint16_t radius, uint16_t width) {
+    for (int i = 0; i < mask_count; i++) {
+        if (masks[i].mask.radius == radius && masks[i].mask.width == width) return &masks[i];
+    }
+    if (mask_count >= RING_ARC_MAX_MASKS || width == 0 || width > radius) return NULL;
+
+    size_t bytes = ring_mask_buffer_size(radius, width);
+    void* buf = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!buf) {
+        Serial.printf("[RING] No PSRAM for %u byte ring mask, using stock arc\n", (unsigned)bytes);
+        return NULL;
+    }
+
+    RingArcMask* rm = &masks[mask_count++];
+    uint32_t start = micros();
+    ring_mask_init(&rm->mask, radius, width, buf);
+    rm->buf = buf;
+
+    uint16_t size = rm->mask.size;
+    lv_memzero(&rm->image, sizeof(rm->image));
+    rm->image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    rm->image.header.cf = LV_COLOR_FORMAT_A8;
+    rm->image.header.w = size;
+    rm->image.header.h = size;
+    rm->image.header.stride = size;
+    rm->image.data = rm->mask.alpha;
+    rm->image.data_size = (uint32_t)size * size;
+
+    Serial.printf("[RING] Mask r=%u w=%u: %u ring px, %u bytes, built in %lu us\n",
+                  radius, width, (unsigned)rm->mask.pixel_count, (unsigned)bytes,
+                  (unsigned long)(micros() - start));
+    return rm;
+}
+
+/**
+ * Indicator angles of an lv_arc from its value, in 1/100 degree, rotation included
+ * @return false for modes not handled here (symmetrical)
+ */
+static bool precise_angles(lv_obj_t* obj, int32_t* start, int32_t* end) {
+    int32_t min = lv_arc_get_min_value(obj), max = lv_arc_get_max_value(obj);
+    if (max <= min) return false;
+
+    int32_t bgStart = lv_arc_get_bg_angle_start(obj);
+    int32_t bgEnd = lv_arc_get_bg_angle_end(obj);
+    if (bgEnd < bgStart) bgEnd += 360;
+    int32_t sweep = (int32_t)((int64_t)(bgEnd - bgStart) * 100 * (lv_arc_get_value(obj) - min) / (max - min));
+    int32_t rot = lv_arc_get_rotation(obj) * 100;
+
+    switch (lv_arc_get_mode(obj)) {
+        case LV_ARC_MODE_NORMAL:
+            *start = bgStart * 100 + rot;
+            *end = bgStart * 100 + sweep + rot;
+            return true;
+        case LV_ARC_MODE_REVERSE:
+            *start = bgEnd * 100 - sweep + rot;
+            *end = bgEnd * 100 + rot;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Invalidate the part of the indicator between two angles of one end
+ */
+static void invalidate_sector(lv_obj_t* obj, int32_t a0, int32_t a1) {
+    if (a0 == a1) return;
+    int32_t delta = a1 > a0 ? a1 - a0 : a0 - a1;
+    if (delta > 1000) {
+        // Large jumps are rare (new event); lv_arc already invalidated them
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    float cx = (coords.x1 + coords.x2 + 1) / 2.0f;
+    float cy = (coords.y1 + coords.y2 + 1) / 2.0f;
+    int32_t width = lv_obj_get_style_arc_width(obj, LV_PART_INDICATOR);
+    float mid = LV_MIN(lv_area_get_width(&coords), lv_area_get_height(&coords)) / 2.0f - width / 2.0f;
+    float margin = width / 2.0f + 2;  // Cap radius plus anti-aliasing and sagitta
+
+    float r0 = a0 * 3.14159265f / 18000, r1 = a1 * 3.14159265f / 18000;
+    float x0 = cx + mid * cosf(r0), y0 = cy + mid * sinf(r0);
+    float x1 = cx + mid * cosf(r1), y1 = cy + mid * sinf(r1);
+
+    lv_area_t area;
+    area.x1 = (int32_t)floorf(LV_MIN(x0, x1) - margin);
+    area.y1 = (int32_t)floorf(LV_MIN(y0, y1) - margin);
+    area.x2 = (int32_t)ceilf(LV_MAX(x0, x1) + margin);
+    area.y2 = (int32_t)ceilf(LV_MAX(y0, y1) + margin);
+    lv_obj_invalidate_area(obj, &area);
+}
+
+void ring_arc_set_value(lv_obj_t* arc, int32_t value) {
+    if (!arc) return;
+    int32_t s0, e0, s1, e1;
+    bool had = precise_angles(arc, &s0, &e0);
+    lv_arc_set_value(arc, value);
+    if (had && precise_angles(arc, &s1, &e1)) {
+        invalidate_sector(arc, s0, s1);
+        invalidate_sector(arc, e0, e1);
+    }
+}
+
+static void draw_task_cb(lv_event_t* e) {
+    lv_draw_task_t* task = lv_event_get_draw_task(e);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_ARC) return;
+
+    lv_draw_arc_dsc_t* arc = (lv_draw_arc_dsc_t*)lv_draw_task_get_draw_dsc(task);
+    if (arc->base.part != LV_PART_INDICATOR || arc->img_src != NULL || arc->opa <= LV_OPA_MIN) return;
+
+    RingArcMask* rm = get_mask(arc->radius, (uint16_t)arc->width);
+    if (!rm) return;  // Leave it to the stock renderer
+
+    // Exact angles from the value; the descriptor only has whole degrees
+    int32_t start, end;
+    if (!precise_angles(arc->base.obj, &start, &end)) {
+        start = (int32_t)arc->start_angle * 100;
+        end = (int32_t)arc->end_angle * 100;
+    }
+    if (start == end) {
+        arc->opa = LV_OPA_TRANSP;
+        return;
+    }
+    ring_mask_render(&rm->mask, start, end, arc->rounded);
+
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = &rm->image;
+    img.recolor = arc->color;
+    img.recolor_opa = LV_OPA_COVER;
+    img.opa = arc->opa;
+
+    lv_area_t area;
+    area.x1 = arc->center.x - arc->radius;
+    area.y1 = arc->center.y - arc->radius;
+    area.x2 = area.x1 + rm->mask.size - 1;
+    area.y2 = area.y1 + rm->mask.size - 1;
+
+    // The stock task stays queued but draws nothing
+    arc->opa = LV_OPA_TRANSP;
+    lv_draw_image(arc->base.layer, &img, &area);
+}
+
+void ring_arc_attach(lv_obj_t* arc) {
+    if (!arc) return;
+    lv_obj_add_flag(arc, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_add_event_cb(arc, draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, NULL);
+}
@@ -0,0 +1,234 @@
+#include "ring_mask.h"
+#include <math.h>
+#include <string.h>
+
+// Sub-samples per axis for edge pixels of the ring
+#define RING_MASK_SUPERSAMPLE 8
+
+static const float RING_PI = 3.14159265358979f;
+
+/**
+ * Ring pixels of row y: those touching the outer disc, minus those entirely
+ * inside the inner disc
+ */
+static void row_extent(uint16_t radius, uint16_t width, int32_t y, RingMaskRow* row) {
+    float r = radius;
+    float ri = (float)radius - width;
+    float top = y - r, bottom = y + 1 - r;
+    float dyMin = top > 0 ? top : (bottom < 0 ? -bottom : 0);
+    float dyMax = fabsf(top) > fabsf(bottom) ? fabsf(top) : fabsf(bottom);
+    int32_t size = 2 * radius;
+
+    row->x0 = row->hole0 = row->hole1 = row->x1 = 0;
+    if (dyMin >= r) return;
+
+    float h = sqrtf(r * r - dyMin * dyMin);
+    int32_t x0 = (int32_t)floorf(r - h);
+    int32_t x1 = (int32_t)ceilf(r + h);
+    if (x0 < 0) x0 = 0;
+    if (x1 > size) x1 = size;
+    row->x0 = (int16_t)x0;
+    row->x1 = (int16_t)x1;
+    row->hole0 = row->hole1 = (int16_t)x1;
+
+    if (ri > 0 && dyMax < ri) {
+        float hi = sqrtf(ri * ri - dyMax * dyMax);
+        int32_t h0 = (int32_t)ceilf(r - hi);
+        int32_t h1 = (int32_t)floorf(r + hi);
+        if (h1 > h0) {
+            row->hole0 = (int16_t)h0;
+            row->hole1 = (int16_t)h1;
+        }
+    }
+}
+
+static inline uint32_t row_pixels(const RingMaskRow* row) {
+    return (uint32_t)(row->hole0 - row->x0) + (uint32_t)(row->x1 - row->hole1);
+}
+
+static uint8_t pixel_coverage(float r, float ri, int32_t x, int32_t y) {
+    // Nearest and farthest points of the pixel square from the centre
+    float dx0 = x - r, dx1 = x + 1 - r, dy0 = y - r, dy1 = y + 1 - r;
+    float nx = dx0 > 0 ? dx0 : (dx1 < 0 ? -dx1 : 0);
+    float ny = dy0 > 0 ? dy0 : (dy1 < 0 ? -dy1 : 0);
+    float fx = fabsf(dx0) > fabsf(dx1) ? fabsf(dx0) : fabsf(dx1);
+    float fy = fabsf(dy0) > fabsf(dy1) ? fabsf(dy0) : fabsf(dy1);
+    float dMin2 = nx * nx + ny * ny, dMax2 = fx * fx + fy * fy;
+    if (dMin2 >= ri * ri && dMax2 <= r * r) return 255;
+    if (dMin2 >= r * r || dMax2 <= ri * ri) return 0;
+
+    int hits = 0;
+    for (int sy = 0; sy < RING_MASK_SUPERSAMPLE; sy++) {
+        float py = dy0 + (sy + 0.5f) / RING_MASK_SUPERSAMPLE;
+        for (int sx = 0; sx < RING_MASK_SUPERSAMPLE; sx++) {
+            float px = dx0 + (sx + 0.5f) / RING_MASK_SUPERSAMPLE;
+            float d2 = px * px + py * py;
+            if (d2 >= ri * ri && d2 <= r * r) hits++;
+        }
+    }
+    return (uint8_t)((hits * 255 + RING_MASK_SUPERSAMPLE * RING_MASK_SUPERSAMPLE / 2) /
+                     (RING_MASK_SUPERSAMPLE * RING_MASK_SUPERSAMPLE));
+}
+
+size_t ring_mask_buffer_size(uint16_t radius, uint16_t width) {
+    uint32_t size = 2u * radius;
+    uint32_t pixels = 0;
+    for (uint32_t y = 0; y < size; y++) {
+        RingMaskRow row;
+        row_extent(radius, width, (int32_t)y, &row);
+        pixels += row_pixels(&row);
+    }
+    // rows, angle (2-byte), coverage, alpha; padded to keep each array aligned
+    size_t bytes = size * sizeof(RingMaskRow);
+    bytes += (size_t)pixels * sizeof(uint16_t);
+    bytes += ((size_t)pixels + 3) & ~(size_t)3;
+    bytes += (size_t)size * size;
+    return bytes;
+}
+
+void ring_mask_init(RingMask* m, uint16_t radius, uint16_t width, void* buf) {
+    uint32_t size = 2u * radius;
+    uint8_t* p = (uint8_t*)buf;
+
+    m->radius = radius;
+    m->width = width;
+    m->size = (uint16_t)size;
+    m->rows = (RingMaskRow*)p;
+    p += size * sizeof(RingMaskRow);
+
+    uint32_t pixels = 0;
+    for (uint32_t y = 0; y < size; y++) {
+        row_extent(radius, width, (int32_t)y, &m->rows[y]);
+        m->rows[y].offset = pixels;
+        pixels += row_pixels(&m->rows[y]);
+    }
+    m->pixel_count = pixels;
+
+    m->angle = (uint16_t*)p;
+    p += (size_t)pixels * sizeof(uint16_t);
+    m->coverage = p;
+    p += ((size_t)pixels + 3) & ~(size_t)3;
+    m->alpha = p;
+    memset(m->alpha, 0, (size_t)size * size);
+
+    float r = radius;
+    float ri = (float)radius - width;
+    for (uint32_t y = 0; y < size; y++) {
+        const RingMaskRow* row = &m->rows[y];
+        uint32_t idx = row->offset;
+        for (int32_t x = row->x0; x < row->x1; x++) {
+            if (x == row->hole0) x = row->hole1;
+            if (x >= row->x1) break;
+
+            float a = atan2f(y + 0.5f - r, x + 0.5f - r) * (RING_MASK_FULL_TURN / 2) / RING_PI;
+            int32_t ai = (int32_t)lroundf(a);
+            if (ai < 0) ai += RING_MASK_FULL_TURN;
+            if (ai >= RING_MASK_FULL_TURN) ai -= RING_MASK_FULL_TURN;
+
+            m->angle[idx] = (uint16_t)ai;
+            m->coverage[idx] = pixel_coverage(r, ri, x, (int32_t)y);
+            idx++;
+        }
+    }
+    m->drawn_valid = false;
+}
+
+/**
+ * Stamp an LVGL-style round cap (disc of the ring's width) at angle a,
+ * limited to ring pixels so the next render overwrites it
+ */
+static void stamp_cap(RingMask* m, int32_t a) {
+    float rad = a * RING_PI / (RING_MASK_FULL_TURN / 2);
+    float mid = m->radius - m->width / 2.0f;
+    float half = m->width / 2.0f;
+    float cx = m->radius + mid * cosf(rad);
+    float cy = m->radius + mid * sinf(rad);
+
+    int32_t y0 = (int32_t)floorf(cy - half - 1), y1 = (int32_t)ceilf(cy + half + 1);
+    int32_t x0 = (int32_t)floorf(cx - half - 1), x1 = (int32_t)ceilf(cx + half + 1);
+    if (y0 < 0) y0 = 0;
+    if (y1 > m->size) y1 = m->size;
+
+    for (int32_t y = y0; y < y1; y++) {
+        const RingMaskRow* row = &m->rows[y];
+        uint8_t* out = m->alpha + (size_t)y * m->size;
+        for (int32_t x = x0 > row->x0 ? x0 : row->x0; x < x1 && x < row->x1; x++) {
+            if (x >= row->hole0 && x < row->hole1) continue;
+            float dx = x + 0.5f - cx, dy = y + 0.5f - cy;
+            float c = half - sqrtf(dx * dx + dy * dy) + 0.5f;
+            if (c <= 0) continue;
+            uint8_t v = c >= 1 ? 255 : (uint8_t)(c * 255);
+            if (v > out[x]) out[x] = v;
+        }
+    }
+}
+
+bool ring_mask_render(RingMask* m, int32_t start, int32_t end, bool rounded) {
+    int32_t span = end - start;
+    bool full = span >= RING_MASK_FULL_TURN || span <= -RING_MASK_FULL_TURN;
+    span %= RING_MASK_FULL_TURN;
+    if (span < 0) span += RING_MASK_FULL_TURN;
+    start %= RING_MASK_FULL_TURN;
+    if (start < 0) start += RING_MASK_FULL_TURN;
+    if (full) {
+        start = 0;
+        span = RING_MASK_FULL_TURN;
+        rounded = false;
+    }
+
+    if (m->drawn_valid && m->drawn_start == start && m->drawn_end == start + span &&
+        m->drawn_rounded == rounded) {
+        return false;
+    }
+
+    // Pixels per hundredth of a degree at mid-ring, Q8, for anti-aliasing the ends
+    float mid = m->radius - m->width / 2.0f;
+    int32_t k = (int32_t)lroundf(256.0f * RING_PI * mid / (RING_MASK_FULL_TURN / 2));
+
+    for (uint32_t y = 0; y < m->size; y++) {
+        const RingMaskRow* row = &m->rows[y];
+        uint8_t* out = m->alpha + (size_t)y * m->size;
+        const uint16_t* angle = m->angle + row->offset;
+        const uint8_t* cov = m->coverage + row->offset;
+
+        for (int32_t x = row->x0; x < row->x1; x++) {
+            if (x == row->hole0) x = row->hole1;
+            if (x >= row->x1) break;
+
+            if (span == 0) {
+                out[x] = 0;
+            } else if (full) {
+                out[x] = *cov;
+            } else {
+                int32_t rel = (int32_t)*angle - start;
+                if (rel < 0) rel += RING_MASK_FULL_TURN;
+
+                // Signed angular distance to the nearest end, positive inside the arc
+                int32_t d;
+                if (rel < span) {
+                    d = rel < span - rel ? rel : span - rel;
+                } else {
+                    int32_t toEnd = rel - span, toStart = RING_MASK_FULL_TURN - rel;
+                    d = -(toEnd < toStart ? toEnd : toStart);
+                }
+                int32_t f = 128 + d * k;
+                if (f < 0) f = 0;
+                if (f > 256) f = 256;
+                out[x] = (uint8_t)((*cov * f) >> 8);
+            }
+            angle++;
+            cov++;
+        }
+    }
+
+    if (rounded && span > 0) {
+        stamp_cap(m, start);
+        stamp_cap(m, start + span);
+    }
+
+    m->drawn_valid = true;
+    m->drawn_start = start;
+    m->drawn_end = start + span;
+    m->drawn_rounded = rounded;
+    return true;
+}
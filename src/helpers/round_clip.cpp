@@ -0,0 +1,91 @@
+#include "round_clip.h"
+#include <math.h>
+
+void round_clip_init(RoundClip* c, uint16_t width, uint16_t height, RoundClipSpan* rows) {
+    float r = (width < height ? width : height) / 2.0f;
+    float cx = width / 2.0f, cy = height / 2.0f;
+
+    c->width = width;
+    c->height = height;
+    c->rows = rows;
+    c->visible_px = 0;
+
+    for (uint32_t y = 0; y < height; y++) {
+        // Distance from the centre to the nearest point of the row
+        float top = y - cy, bottom = y + 1 - cy;
+        float dy = top > 0 ? top : (bottom < 0 ? -bottom : 0);
+        RoundClipSpan* s = &rows[y];
+        s->x0 = s->x1 = 0;
+        if (dy >= r) continue;
+
+        float h = sqrtf(r * r - dy * dy);
+        int32_t x0 = (int32_t)floorf(cx - h);
+        int32_t x1 = (int32_t)ceilf(cx + h);
+        if (x0 < 0) x0 = 0;
+        if (x1 > width) x1 = width;
+        s->x0 = (int16_t)x0;
+        s->x1 = (int16_t)x1;
+        c->visible_px += (uint32_t)(x1 - x0);
+    }
+}
+
+/**
+ * Rows of a that lie on the panel, or false if none
+ */
+static bool row_range(const RoundClip* c, const RoundClipArea* a, int32_t* y0, int32_t* y1) {
+    *y0 = a->y1 < 0 ? 0 : a->y1;
+    *y1 = a->y2 >= c->height ? c->height - 1 : a->y2;
+    return *y0 <= *y1;
+}
+
+bool round_clip_area(const RoundClip* c, RoundClipArea* a) {
+    int32_t y0, y1;
+    if (!row_range(c, a, &y0, &y1)) return false;
+
+    RoundClipArea box = {INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN};
+    for (int32_t y = y0; y <= y1; y++) {
+        const RoundClipSpan* s = &c->rows[y];
+        int32_t x0 = s->x0 > a->x1 ? s->x0 : a->x1;
+        int32_t x1 = s->x1 - 1 < a->x2 ? s->x1 - 1 : a->x2;
+        if (x0 > x1) continue;
+
+        if (x0 < box.x1) box.x1 = x0;
+        if (x1 > box.x2) box.x2 = x1;
+        if (y < box.y1) box.y1 = y;
+        box.y2 = y;
+    }
+    if (box.y1 == INT32_MAX) return false;
+
+    *a = box;
+    return true;
+}
+
+int round_clip_split(const RoundClip* c, const RoundClipArea* a, uint16_t band_rows,
+                     RoundClipArea* out, int max) {
+    int32_t y0, y1;
+    if (!row_range(c, a, &y0, &y1) || band_rows == 0) return 0;
+
+    int n = 0;
+    for (int32_t y = y0; y <= y1 && n < max;) {
+        int32_t end = (y / band_rows + 1) * band_rows - 1;
+        if (end > y1 || n == max - 1) end = y1;  // The last slot takes the rest
+        RoundClipArea band = {a->x1, y, a->x2, end};
+        if (round_clip_area(c, &band)) out[n++] = band;
+        y = end + 1;
+    }
+    return n;
+}
+
+uint32_t round_clip_visible_px(const RoundClip* c, const RoundClipArea* a) {
+    int32_t y0, y1;
+    if (!row_range(c, a, &y0, &y1)) return 0;
+
+    uint32_t px = 0;
+    for (int32_t y = y0; y <= y1; y++) {
+        const RoundClipSpan* s = &c->rows[y];
+        int32_t x0 = s->x0 > a->x1 ? s->x0 : a->x1;
+        int32_t x1 = s->x1 - 1 < a->x2 ? s->x1 - 1 : a->x2;
+        if (x0 <= x1) px += (uint32_t)(x1 - x0 + 1);
+    }
+    return px;
+}
@@ -0,0 +1,315 @@
+#include "schedule_cbor.h"
+#include <string.h>
+
+enum {
+    MAJOR_UINT = 0,
+    MAJOR_NINT = 1,
+    MAJOR_BYTES = 2,
+    MAJOR_TEXT = 3,
+    MAJOR_ARRAY = 4,
+    MAJOR_MAP = 5,
+    MAJOR_TAG = 6,
+    MAJOR_SIMPLE = 7
+};
+
+enum {
+    FIELD_START,
+    FIELD_DURATION,
+    FIELD_LABEL,
+    FIELD_PATH,
+    FIELD_COUNT,
+    FIELD_NONE = FIELD_COUNT
+};
+
+static const char* const FIELD_KEYS[FIELD_COUNT] = {"start", "duration", "label", "path"};
+
+typedef struct {
+    ScheduleCborReadFn read;
+    void* ctx;
+    size_t pos;
+    size_t len;
+    uint8_t buf[SCHEDULE_CBOR_READ_CHUNK];
+} Reader;
+
+typedef struct {
+    uint8_t major;
+    bool indefinite;         // Indefinite length; for MAJOR_SIMPLE, the break code
+    uint64_t arg;
+} Head;
+
+static bool get_byte(Reader* r, uint8_t* b) {
+    if (r->pos == r->len) {
+        r->len = r->read(r->ctx, r->buf, sizeof(r->buf));
+        r->pos = 0;
+        if (r->len == 0) return false;
+    }
+    *b = r->buf[r->pos++];
+    return true;
+}
+
+/**
+ * Copy n bytes to dst, or drop them when dst is NULL
+ */
+static bool get_bytes(Reader* r, uint8_t* dst, uint64_t n) {
+    while (n > 0) {
+        if (r->pos == r->len) {
+            r->len = r->read(r->ctx, r->buf, sizeof(r->buf));
+            r->pos = 0;
+            if (r->len == 0) return false;
+        }
+        size_t take = r->len - r->pos;
+        if (take > n) take = (size_t)n;
+        if (dst) {
+            memcpy(dst, r->buf + r->pos, take);
+            dst += take;
+        }
+        r->pos += take;
+        n -= take;
+    }
+    return true;
+}
+
+static bool read_head(Reader* r, Head* h) {
+    uint8_t b;
+    if (!get_byte(r, &b)) return false;
+    h->major = b >> 5;
+    h->indefinite = false;
+    h->arg = 0;
+
+    uint8_t info = b & 0x1f;
+    if (info < 24) {
+        h->arg = info;
+    } else if (info <= 27) {
+        // 1, 2, 4 or 8 big-endian bytes follow
+        for (int i = 0; i < (1 << (info - 24)); i++) {
+            if (!get_byte(r, &b)) return false;
+            h->arg = (h->arg << 8) | b;
+        }
+    } else if (info == 31 && h->major != MAJOR_UINT && h->major != MAJOR_NINT && h->major != MAJOR_TAG) {
+        h->indefinite = true;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool is_break(const Head* h) {
+    return h->major == MAJOR_SIMPLE && h->indefinite;
+}
+
+/**
+ * Read the head of the next element of an array or map, or detect its end
+ * @param remaining Elements left in a definite-length container
+ * @return 1 with h filled, 0 at the end, -1 on malformed input
+ */
+static int next_element(Reader* r, const Head* container, uint64_t* remaining, Head* h) {
+    if (!container->indefinite) {
+        if (*remaining == 0) return 0;
+        (*remaining)--;
+        return read_head(r, h) ? 1 : -1;
+    }
+    if (!read_head(r, h)) return -1;
+    return is_break(h) ? 0 : 1;
+}
+
+static bool skip_item(Reader* r, const Head* h, int depth) {
+    if (depth > SCHEDULE_CBOR_MAX_DEPTH) return false;
+
+    switch (h->major) {
+        case MAJOR_UINT:
+        case MAJOR_NINT:
+            return true;
+
+        case MAJOR_BYTES:
+        case MAJOR_TEXT: {
+            if (!h->indefinite) return get_bytes(r, NULL, h->arg);
+            // Chunks of the same type, then a break
+            Head chunk;
+            for (;;) {
+                if (!read_head(r, &chunk)) return false;
+                if (is_break(&chunk)) return true;
+                if (chunk.major != h->major || chunk.indefinite) return false;
+                if (!get_bytes(r, NULL, chunk.arg)) return false;
+            }
+        }
+
+        case MAJOR_ARRAY:
+        case MAJOR_MAP: {
+            uint64_t remaining = h->arg;
+            if (h->major == MAJOR_MAP) {
+                if (remaining > UINT64_MAX / 2) return false;
+                remaining *= 2;
+            }
+            Head item;
+            int rc;
+            while ((rc = next_element(r, h, &remaining, &item)) == 1) {
+                if (!skip_item(r, &item, depth + 1)) return false;
+            }
+            return rc == 0;
+        }
+
+        case MAJOR_TAG: {
+            Head item;
+            return read_head(r, &item) && !is_break(&item) && skip_item(r, &item, depth + 1);
+        }
+
+        default:
+            // Simple values and floats are complete after the head; a stray break is not
+            return !is_break(h);
+    }
+}
+
+/**
+ * Read a definite text string into out (NUL-terminated)
+ * @param fits Set false (and the text skipped) when it does not fit
+ */
+static bool read_text(Reader* r, const Head* h, char* out, size_t out_size, bool* fits) {
+    if (h->arg >= out_size) {
+        *fits = false;
+        return get_bytes(r, NULL, h->arg);
+    }
+    if (!get_bytes(r, (uint8_t*)out, h->arg)) return false;
+    out[h->arg] = '\0';
+    *fits = true;
+    return true;
+}
+
+static int field_for_key(const char* key) {
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        if (strcmp(key, FIELD_KEYS[i]) == 0) return i;
+    }
+    return FIELD_NONE;
+}
+
+/**
+ * Decode one field value into cfg
+ * @param got Bit `field` is set when the value was usable
+ */
+static bool read_field(Reader* r, const Head* v, int field, readConfig* cfg, unsigned* got) {
+    switch (field) {
+        case FIELD_START:
+        case FIELD_DURATION:
+            if (v->major != MAJOR_UINT) return skip_item(r, v, 1);
+            if (v->arg <= 0xFFFF) {
+                if (field == FIELD_START) cfg->start = (uint16_t)v->arg;
+                else cfg->duration = (uint16_t)v->arg;
+                *got |= 1u << field;
+            }
+            return true;
+
+        case FIELD_LABEL:
+        case FIELD_PATH: {
+            if (v->major != MAJOR_TEXT || v->indefinite) return skip_item(r, v, 1);
+            char* out = field == FIELD_LABEL ? cfg->label : cfg->path;
+            size_t size = field == FIELD_LABEL ? sizeof(cfg->label) : sizeof(cfg->path);
+            bool fits;
+            if (!read_text(r, v, out, size, &fits)) return false;
+            if (fits) *got |= 1u << field;
+            return true;
+        }
+
+        default:
+            return skip_item(r, v, 1);
+    }
+}
+
+/**
+ * Decode one event (map or positional array)
+ * @param valid Set when all four fields were usable
+ */
+static bool read_event(Reader* r, const Head* h, readConfig* cfg, bool* valid) {
+    unsigned got = 0;
+    uint64_t remaining = h->arg;
+    Head item;
+    int rc;
+    *valid = false;
+
+    if (h->major == MAJOR_ARRAY) {
+        int field = 0;
+        while ((rc = next_element(r, h, &remaining, &item)) == 1) {
+            if (!read_field(r, &item, field < FIELD_COUNT ? field : FIELD_NONE, cfg, &got)) return false;
+            field++;
+        }
+    } else if (h->major == MAJOR_MAP) {
+        if (remaining > UINT64_MAX / 2) return false;
+        remaining *= 2;
+        while ((rc = next_element(r, h, &remaining, &item)) == 1) {
+            int field = FIELD_NONE;
+            if (item.major == MAJOR_TEXT && !item.indefinite) {
+                char key[12];
+                bool fits;
+                if (!read_text(r, &item, key, sizeof(key), &fits)) return false;
+                if (fits) field = field_for_key(key);
+            } else if (!skip_item(r, &item, 1)) {
+                return false;
+            }
+
+            Head value;
+            if (next_element(r, h, &remaining, &value) != 1) return false;
+            if (!read_field(r, &value, field, cfg, &got)) return false;
+        }
+    } else {
+        return skip_item(r, h, 0);
+    }
+
+    *valid = got == (1u << FIELD_COUNT) - 1;
+    return rc == 0;
+}
+
+bool schedule_cbor_decode(ScheduleCborReadFn read, void* ctx,
+                          readConfig* out_events, size_t max_events, size_t* out_count) {
+    Reader r;
+    r.read = read;
+    r.ctx = ctx;
+    r.pos = 0;
+    r.len = 0;
+    *out_count = 0;
+    if (out_events && max_events == 0) return true;
+
+    Head top;
+    if (!read_head(&r, &top) || top.major != MAJOR_MAP) return false;
+    uint64_t remaining = top.arg;
+    if (remaining > UINT64_MAX / 2) return false;
+    remaining *= 2;
+
+    Head key;
+    int rc;
+    while ((rc = next_element(&r, &top, &remaining, &key)) == 1) {
+        bool is_events = false;
+        if (key.major == MAJOR_TEXT && !key.indefinite) {
+            char name[8];
+            bool fits;
+            if (!read_text(&r, &key, name, sizeof(name), &fits)) return false;
+            is_events = fits && strcmp(name, "events") == 0;
+        } else if (!skip_item(&r, &key, 1)) {
+            return false;
+        }
+
+        Head value;
+        if (next_element(&r, &top, &remaining, &value) != 1) return false;
+        if (!is_events) {
+            if (!skip_item(&r, &value, 1)) return false;
+            continue;
+        }
+        if (value.major != MAJOR_ARRAY) return false;
+
+        // Nothing after the events is needed
+        uint64_t events_left = value.arg;
+        Head item;
+        int erc;
+        while ((erc = next_element(&r, &value, &events_left, &item)) == 1) {
+            readConfig cfg;
+            bool valid;
+            if (!read_event(&r, &item, &cfg, &valid)) return false;
+            if (!valid) continue;
+            if (out_events) {
+                out_events[*out_count] = cfg;
+                if (++*out_count == max_events) return true;
+            } else {
+                ++*out_count;
+            }
+        }
+        return erc == 0;
+    }
+    return false;
+}
@@ -1,5 +1,6 @@
 #include "schedule_manager.h"
 #include "JSON_reader.h"
+#include "crc32.h"
 #include <time.h>
 #include <algorithm>
 
@@ -7,7 +8,9 @@
 static readConfig eventBuffer[16];  // Support up to 16 events per day (~1088 bytes)
 static size_t eventBufferCount = 0;
 static unsigned long lastFetchTime = 0;
+static bool cacheLoaded = false;  // Also when the schedule is empty, so it is not refetched on every call
 static const unsigned long CACHE_DURATION = 60000;  // 60 seconds
+static uint32_t scheduleGeneration = 0;  // CRC-32 of the loaded events
 
 /**
  * Invalidate the event cache (called after new JSON is saved via BLE)
@@ -15,6 +18,7 @@ static const unsigned long CACHE_DURATION = 60000;  // 60 seconds
 void invalidateScheduleCache() {
     eventBufferCount = 0;
     lastFetchTime = 0;
+    cacheLoaded = false;
     Serial.println("[SCHEDULE] Cache invalidated, will refetch from SD card");
 }
 
@@ -27,6 +31,21 @@ uint16_t getCurrentMinutesSinceMidnight() {
     return (timeinfo->tm_hour * 60) + timeinfo->tm_min;
 }
 
+/**
+ * CRC-32 of the events' fields (not the structs, whose padding is undefined)
+ */
+static uint32_t eventsGeneration() {
+    uint32_t crc = 0;
+    for (size_t i = 0; i < eventBufferCount; i++) {
+        const readConfig& e = eventBuffer[i];
+        crc = crc32_update(crc, &e.start, sizeof(e.start));
+        crc = crc32_update(crc, &e.duration, sizeof(e.duration));
+        crc = crc32_update(crc, e.label, strnlen(e.label, sizeof(e.label)));
+        crc = crc32_update(crc, e.path, strnlen(e.path, sizeof(e.path)));
+    }
+    return crc;
+}
+
 /**
  * Fetch and cache events from JSON (with caching to avoid repeated SD reads)
  * Events are expected to have start times in MINUTES SINCE MIDNIGHT (0-1439)
@@ -35,7 +54,7 @@ static void fetchEventsIfNeeded() {
     unsigned long now = millis();
     
     // Only refetch if cache is stale or empty
-    if (eventBufferCount == 0 || (now - lastFetchTime > CACHE_DURATION)) {
+    if (!cacheLoaded || (now - lastFetchTime > CACHE_DURATION)) {
         Serial.printf("[SCHEDULE] Fetching events from SD card (count=%u, age=%lu ms)\n", 
             eventBufferCount, now - lastFetchTime);
         
@@ -59,7 +78,9 @@ static void fetchEventsIfNeeded() {
         } else {
             Serial.println("[SCHEDULE] Failed to load events from JSON");
         }
+        scheduleGeneration = eventsGeneration();
         lastFetchTime = now;
+        cacheLoaded = true;
     }
 }
 
@@ -164,6 +185,38 @@ size_t getAllScheduleEvents(ScheduleEvent** out_events, size_t max_events) {
     return count;
 }
 
+/**
+ * Current and next event by the same rules as getCurrentScheduleEvent() and
+ * getNextScheduleEvent(), with the countdown to the second
+ */
+uint32_t getSchedulePosition(int* current_index, int* next_index, uint32_t* seconds_remaining) {
+    fetchEventsIfNeeded();
+
+    time_t now = time(nullptr);
+    struct tm* timeinfo = localtime(&now);
+    uint16_t currentMinutes = (timeinfo->tm_hour * 60) + timeinfo->tm_min;
+    uint32_t currentSeconds = (uint32_t)currentMinutes * 60 + timeinfo->tm_sec;
+
+    *current_index = -1;
+    *next_index = -1;
+    *seconds_remaining = 0;
+    for (size_t i = 0; i < eventBufferCount; i++) {
+        uint16_t eventEnd = eventBuffer[i].start + (eventBuffer[i].duration / 60);
+        if (*current_index < 0 && currentMinutes >= eventBuffer[i].start && currentMinutes < eventEnd) {
+            *current_index = (int)i;
+            *seconds_remaining = (uint32_t)eventEnd * 60 - currentSeconds;
+        }
+        if (eventBuffer[i].start > currentMinutes) {
+            *next_index = (int)i;
+            if (*current_index < 0) {
+                *seconds_remaining = (uint32_t)eventBuffer[i].start * 60 - currentSeconds;
+            }
+            break;
+        }
+    }
+    return scheduleGeneration;
+}
+
 /**
  * Convert minutes since midnight to HH:MM format for display
  * Input: minutes (0-1439)
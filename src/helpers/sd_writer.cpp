@@ -0,0 +1,256 @@
+#include "sd_writer.h"
+#include "crc32.h"
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+enum {
+    MSG_BLOCK,      // Write a filled block
+    MSG_FINISH      // Drain, optionally sync, close and signal done_sem
+};
+
+typedef struct {
+    uint8_t type;
+    uint8_t block;
+    bool sync;
+    uint32_t len;
+} WriterMsg;
+
+static uint8_t* blocks[SD_WRITER_BLOCKS];
+static QueueHandle_t free_q = NULL;    // Block indices the loop may fill
+static QueueHandle_t work_q = NULL;    // WriterMsg for the task
+static SemaphoreHandle_t done_sem = NULL;
+static TaskHandle_t writer_task = NULL;
+
+// Owned by the task while a file is active
+static File file;
+static uint32_t written = 0;
+static uint32_t written_crc = 0;
+static uint32_t checkpoint_every = 0;
+static uint32_t checkpoint_align = 0;
+static uint32_t last_checkpoint = 0;
+static SdWriterCheckpointFn checkpoint_fn = NULL;
+static void* checkpoint_ctx = NULL;
+static volatile bool write_failed = false;
+
+// Owned by the loop
+static bool active = false;
+static int fill_block = -1;
+static uint32_t fill_len = 0;
+static uint32_t fill_cap = 0;
+static uint32_t fill_offset = 0;       // File offset the next queued byte lands at
+
+static SdWriterStats stats = {0};
+
+static void sync_file() {
+    uint32_t t0 = micros();
+    file.flush();
+    uint32_t us = micros() - t0;
+    stats.write_us += us;
+    stats.sync_us += us;
+    stats.syncs++;
+}
+
+/**
+ * Write a block at the end of the file
+ * @return false (and the writer fails) on a short write
+ */
+static bool write_block(const uint8_t* data, uint32_t len) {
+    uint32_t t0 = micros();
+    size_t n = file.write(data, len);
+    stats.write_us += micros() - t0;
+    written_crc = crc32_update(written_crc, data, n);
+    written += n;
+    stats.bytes += n;
+    stats.blocks++;
+    if (n != len) {
+        Serial.printf("[SD WRITER] ERROR: Wrote %u of %u bytes\n", (unsigned int)n, (unsigned int)len);
+        write_failed = true;
+    }
+    return !write_failed;
+}
+
+/**
+ * Sync and report a checkpoint when one is due after writing data, which
+ * started at file offset start with the file's CRC then at start_crc
+ */
+static void maybe_checkpoint(const uint8_t* data, uint32_t start, uint32_t start_crc) {
+    if (write_failed || !checkpoint_every || written - last_checkpoint < checkpoint_every) return;
+
+    // Report the last aligned offset in this block, with the CRC up to it
+    uint32_t aligned = checkpoint_align ? written - written % checkpoint_align : written;
+    if (aligned < start) return;
+    sync_file();
+    last_checkpoint = written;
+    uint32_t crc = crc32_update(start_crc, data, aligned - start);
+    if (checkpoint_fn) checkpoint_fn(checkpoint_ctx, aligned, crc);
+}
+
+static void writer_task_fn(void* arg) {
+    WriterMsg msg;
+    for (;;) {
+        if (xQueueReceive(work_q, &msg, portMAX_DELAY) != pdTRUE) continue;
+
+        if (msg.type == MSG_BLOCK) {
+            uint32_t block_start = written;
+            uint32_t block_crc = written_crc;
+            if (!write_failed && write_block(blocks[msg.block], msg.len)) {
+                maybe_checkpoint(blocks[msg.block], block_start, block_crc);
+            }
+            xQueueSend(free_q, &msg.block, portMAX_DELAY);
+        } else {
+            if (msg.sync && !write_failed) sync_file();
+            file.close();
+            xSemaphoreGive(done_sem);
+        }
+    }
+}
+
+static bool ensure_task() {
+    if (writer_task) return true;
+
+    for (int i = 0; i < SD_WRITER_BLOCKS; i++) {
+        blocks[i] = (uint8_t*)heap_caps_malloc(SD_WRITER_BLOCK_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (!blocks[i]) {
+            Serial.println("[SD WRITER] ERROR: Failed to allocate blocks");
+            return false;
+        }
+    }
+    free_q = xQueueCreate(SD_WRITER_BLOCKS, sizeof(uint8_t));
+    work_q = xQueueCreate(SD_WRITER_BLOCKS + 1, sizeof(WriterMsg));
+    done_sem = xSemaphoreCreateBinary();
+    if (!free_q || !work_q || !done_sem) {
+        Serial.println("[SD WRITER] ERROR: Failed to create queues");
+        return false;
+    }
+    for (uint8_t i = 0; i < SD_WRITER_BLOCKS; i++) xQueueSend(free_q, &i, 0);
+
+    if (xTaskCreatePinnedToCore(writer_task_fn, "sd_writer", SD_WRITER_TASK_STACK, NULL,
+                                SD_WRITER_TASK_PRIORITY, &writer_task, SD_WRITER_TASK_CORE) != pdPASS) {
+        Serial.println("[SD WRITER] ERROR: Failed to start task");
+        writer_task = NULL;
+        return false;
+    }
+    return true;
+}
+
+static void note_stall(uint32_t t0) {
+    uint32_t us = micros() - t0;
+    stats.stall_us += us;
+    if (us > stats.max_stall_us) stats.max_stall_us = us;
+}
+
+/**
+ * Queue the block being filled (if any) for writing
+ */
+static void submit_fill() {
+    if (fill_block < 0) return;
+    if (fill_len > 0) {
+        WriterMsg msg = {MSG_BLOCK, (uint8_t)fill_block, false, fill_len};
+        xQueueSend(work_q, &msg, portMAX_DELAY);
+    } else {
+        uint8_t block = (uint8_t)fill_block;
+        xQueueSend(free_q, &block, portMAX_DELAY);
+    }
+    fill_block = -1;
+    fill_len = 0;
+}
+
+bool sd_writer_begin(File f, uint32_t offset, uint32_t crc, uint32_t checkpoint_bytes,
+                     uint32_t align, SdWriterCheckpointFn checkpoint, void* ctx) {
+    if (active) sd_writer_finish(true, NULL, NULL);
+    if (!SD_WRITER_DIRECT && !ensure_task()) return false;
+
+    // The task is idle here (the last finish drained it)
+    file = f;
+    written = offset;
+    written_crc = crc;
+    checkpoint_every = checkpoint_bytes;
+    checkpoint_align = align;
+    last_checkpoint = offset;
+    checkpoint_fn = checkpoint;
+    checkpoint_ctx = ctx;
+    write_failed = false;
+
+    memset(&stats, 0, sizeof(stats));
+    fill_offset = offset;
+    active = true;
+    return true;
+}
+
+bool sd_writer_write(const uint8_t* data, size_t len) {
+    if (!active || write_failed) return false;
+
+    if (SD_WRITER_DIRECT) {
+        // The whole write, and any checkpoint it triggers, stalls the caller
+        uint32_t t0 = micros();
+        uint32_t start = written;
+        uint32_t start_crc = written_crc;
+        if (write_block(data, len)) maybe_checkpoint(data, start, start_crc);
+        note_stall(t0);
+        return !write_failed;
+    }
+
+    while (len > 0) {
+        if (fill_block < 0) {
+            uint8_t block;
+            uint32_t t0 = micros();
+            xQueueReceive(free_q, &block, portMAX_DELAY);
+            note_stall(t0);
+            fill_block = block;
+            fill_len = 0;
+            // End blocks on block-size file offsets so the card gets aligned writes
+            fill_cap = SD_WRITER_BLOCK_SIZE - fill_offset % SD_WRITER_BLOCK_SIZE;
+        }
+
+        size_t n = fill_cap - fill_len;
+        if (n > len) n = len;
+        memcpy(blocks[fill_block] + fill_len, data, n);
+        fill_len += n;
+        fill_offset += n;
+        data += n;
+        len -= n;
+
+        if (fill_len == fill_cap) submit_fill();
+    }
+    return true;
+}
+
+bool sd_writer_finish(bool sync, uint32_t* bytes, uint32_t* crc) {
+    if (!active) return false;
+
+    uint32_t t0 = micros();
+    if (SD_WRITER_DIRECT) {
+        if (sync && !write_failed) sync_file();
+        file.close();
+    } else {
+        submit_fill();
+        WriterMsg msg = {MSG_FINISH, 0, sync, 0};
+        xQueueSend(work_q, &msg, portMAX_DELAY);
+        xSemaphoreTake(done_sem, portMAX_DELAY);
+    }
+    note_stall(t0);
+
+    active = false;
+    stats.error = write_failed;
+    if (bytes) *bytes = written;
+    if (crc) *crc = written_crc;
+    return !write_failed;
+}
+
+bool sd_writer_active() {
+    return active;
+}
+
+void sd_writer_get_stats(SdWriterStats* out) {
+    *out = stats;
+}
+
+void sd_writer_log_stats() {
+    uint32_t kbps = stats.write_us ? (uint32_t)((uint64_t)stats.bytes * 1000 / stats.write_us) : 0;
+    Serial.printf("[SD WRITER] %s: %lu bytes in %lu blocks, %lu syncs (%lu ms): %lu ms writing (%lu KB/s); loop stalled %lu ms total, %lu us max%s\n",
+        SD_WRITER_DIRECT ? "direct" : "buffered", stats.bytes, stats.blocks, stats.syncs, stats.sync_us / 1000,
+        stats.write_us / 1000, kbps, stats.stall_us / 1000, stats.max_stall_us, stats.error ? " (write error)" : "");
+}
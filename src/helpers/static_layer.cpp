@@ -0,0 +1,122 @@
+#include "static_layer.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+static lv_obj_t* layer_screen = NULL;
+static lv_obj_t* layer_image = NULL;
+static lv_obj_t* static_objs[STATIC_LAYER_MAX_OBJS];
+static int static_count = 0;
+static lv_draw_buf_t snapshot;
+static bool rebuild_pending = false;
+
+static bool is_static(lv_obj_t* obj) {
+    for (int i = 0; i < static_count; i++) {
+        if (static_objs[i] == obj) return true;
+    }
+    return obj == layer_image;
+}
+
+static void set_static_visible(bool visible) {
+    for (int i = 0; i < static_count; i++) {
+        if (visible) {
+            lv_obj_remove_flag(static_objs[i], LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(static_objs[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+}
+
+/**
+ * Render the screen with only its static children visible into the snapshot
+ */
+static void rebuild() {
+    uint32_t start = micros();
+
+    // Hide the dynamic children and remember which were already hidden
+    uint32_t child_count = lv_obj_get_child_count(layer_screen);
+    uint32_t was_hidden[(64 + 31) / 32] = {0};
+    for (uint32_t i = 0; i < child_count && i < 64; i++) {
+        lv_obj_t* child = lv_obj_get_child(layer_screen, i);
+        if (is_static(child)) continue;
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+            was_hidden[i / 32] |= 1u << (i % 32);
+        } else {
+            lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    lv_obj_add_flag(layer_image, LV_OBJ_FLAG_HIDDEN);
+    set_static_visible(true);
+
+    lv_result_t res = lv_snapshot_take_to_draw_buf(layer_screen, LV_COLOR_FORMAT_RGB565, &snapshot);
+
+    set_static_visible(false);
+    lv_obj_remove_flag(layer_image, LV_OBJ_FLAG_HIDDEN);
+    for (uint32_t i = 0; i < child_count && i < 64; i++) {
+        lv_obj_t* child = lv_obj_get_child(layer_screen, i);
+        if (is_static(child) || (was_hidden[i / 32] & (1u << (i % 32)))) continue;
+        lv_obj_remove_flag(child, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    if (res != LV_RESULT_OK) {
+        // Fall back to drawing the layers live
+        Serial.println("[LAYER] Snapshot failed, drawing background layers live");
+        lv_obj_add_flag(layer_image, LV_OBJ_FLAG_HIDDEN);
+        set_static_visible(true);
+        return;
+    }
+
+    lv_image_cache_drop(&snapshot);
+    lv_obj_invalidate(layer_image);
+    Serial.printf("[LAYER] Background snapshot rebuilt in %lu us\n", (unsigned long)(micros() - start));
+}
+
+static void rebuild_async_cb(void* user_data) {
+    (void)user_data;
+    rebuild_pending = false;
+    rebuild();
+}
+
+bool static_layer_init(lv_obj_t* screen, lv_obj_t* const* objs, int count) {
+#if STATIC_LAYER_CACHE
+    if (!screen || layer_screen || count > STATIC_LAYER_MAX_OBJS) return false;
+
+    lv_obj_update_layout(screen);
+    int32_t w = lv_obj_get_width(screen);
+    int32_t h = lv_obj_get_height(screen);
+    uint32_t stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+    uint32_t size = stride * h;
+    void* data = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!data) {
+        Serial.printf("[LAYER] No PSRAM for %u byte snapshot, drawing layers live\n", (unsigned)size);
+        return false;
+    }
+    lv_draw_buf_init(&snapshot, w, h, LV_COLOR_FORMAT_RGB565, stride, data, size);
+
+    layer_screen = screen;
+    static_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (objs[i]) static_objs[static_count++] = objs[i];
+    }
+
+    // Snapshot image goes underneath everything
+    layer_image = lv_image_create(screen);
+    lv_obj_remove_flag(layer_image, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_set_pos(layer_image, 0, 0);
+    lv_obj_move_to_index(layer_image, 0);
+    lv_image_set_src(layer_image, &snapshot);
+
+    rebuild();
+    return true;
+#else
+    (void)screen;
+    (void)objs;
+    (void)count;
+    return false;
+#endif
+}
+
+void static_layer_invalidate(void) {
+    if (!layer_screen || rebuild_pending) return;
+    rebuild_pending = true;
+    lv_async_call(rebuild_async_cb, NULL);
+}
@@ -0,0 +1,77 @@
+#include "strip_decoder.h"
+#include <string.h>
+
+void strip_decoder_init(StripDecoder* d, strip_read_fn read, void* ctx, uint8_t blk,
+                        bool compressed, uint32_t payload_size) {
+    d->read = read;
+    d->ctx = ctx;
+    d->compressed = compressed;
+    d->blk = blk;
+    d->literal = false;
+    d->run_left = 0;
+    d->in_left = payload_size;
+    d->in_pos = 0;
+    d->in_len = 0;
+}
+
+/**
+ * Copy up to len compressed bytes, refilling the input buffer as needed
+ */
+static bool pull(StripDecoder* d, uint8_t* out, uint32_t len) {
+    while (len > 0) {
+        if (d->in_pos == d->in_len) {
+            if (d->in_left == 0) return false;
+            uint32_t want = d->in_left < STRIP_DECODER_IN_BUF ? d->in_left : STRIP_DECODER_IN_BUF;
+            int32_t n = d->read(d->ctx, d->in, want);
+            if (n <= 0) return false;
+            d->in_len = (uint32_t)n;
+            d->in_pos = 0;
+            d->in_left -= (uint32_t)n;
+        }
+        uint32_t n = d->in_len - d->in_pos;
+        if (n > len) n = len;
+        memcpy(out, d->in + d->in_pos, n);
+        d->in_pos += n;
+        out += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool strip_decoder_read(StripDecoder* d, uint8_t* out, uint32_t len) {
+    if (!d->compressed) {
+        while (len > 0) {
+            int32_t n = d->read(d->ctx, out, len);
+            if (n <= 0) return false;
+            out += n;
+            len -= (uint32_t)n;
+        }
+        return true;
+    }
+
+    uint32_t blocks = len / d->blk;
+    while (blocks > 0) {
+        if (d->run_left == 0) {
+            uint8_t ctrl;
+            if (!pull(d, &ctrl, 1)) return false;
+            d->literal = (ctrl & 0x80) != 0;
+            d->run_left = ctrl & 0x7F;
+            if (!d->literal && d->run_left > 0 && !pull(d, d->rep, d->blk)) return false;
+            continue;
+        }
+
+        uint32_t n = d->run_left < blocks ? d->run_left : blocks;
+        if (d->literal) {
+            if (!pull(d, out, n * d->blk)) return false;
+            out += n * d->blk;
+        } else {
+            for (uint32_t i = 0; i < n; i++) {
+                memcpy(out, d->rep, d->blk);
+                out += d->blk;
+            }
+        }
+        d->run_left -= n;
+        blocks -= n;
+    }
+    return true;
+}
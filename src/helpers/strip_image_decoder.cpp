@@ -0,0 +1,156 @@
+#include "strip_image_decoder.h"
+#include "strip_decoder.h"
+#include "src/draw/lv_image_decoder_private.h"
+#include <Arduino.h>
+
+typedef struct {
+    lv_fs_file_t file;
+    uint32_t payload_offset;   // File offset of the first pixel (or RLE) byte
+    uint32_t payload_size;
+    bool compressed;
+    lv_draw_buf_t* strip;
+    StripDecoder dec;
+} StripContext;
+
+static int32_t file_read(void* ctx, uint8_t* buf, uint32_t len) {
+    uint32_t br = 0;
+    if (lv_fs_read((lv_fs_file_t*)ctx, buf, len, &br) != LV_FS_RES_OK) return -1;
+    return (int32_t)br;
+}
+
+/**
+ * Read and validate the .bin headers
+ * @return Payload offset, or 0 if the file is not a streamable RGB565 image
+ */
+static uint32_t read_headers(lv_fs_file_t* f, lv_image_header_t* header, bool* compressed, uint32_t* payload_size) {
+    uint32_t br = 0;
+    if (lv_fs_read(f, header, sizeof(*header), &br) != LV_FS_RES_OK || br != sizeof(*header)) return 0;
+    if (header->magic != LV_IMAGE_HEADER_MAGIC || header->cf != LV_COLOR_FORMAT_RGB565) return 0;
+    if (header->stride == 0) header->stride = header->w * LV_COLOR_FORMAT_GET_SIZE(LV_COLOR_FORMAT_RGB565);
+
+    uint32_t decodedSize = (uint32_t)header->stride * header->h;
+    if (!(header->flags & LV_IMAGE_FLAGS_COMPRESSED)) {
+        *compressed = false;
+        *payload_size = decodedSize;
+        return sizeof(*header);
+    }
+
+    // Compression header: method, compressed size, decompressed size
+    uint32_t comp[3];
+    if (lv_fs_read(f, comp, sizeof(comp), &br) != LV_FS_RES_OK || br != sizeof(comp)) return 0;
+    if ((comp[0] & 0xF) != LV_IMAGE_COMPRESS_RLE || comp[2] != decodedSize) return 0;
+
+    *compressed = true;
+    *payload_size = comp[1];
+    return sizeof(*header) + sizeof(comp);
+}
+
+static lv_result_t decoder_info(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc, lv_image_header_t* header) {
+    if (dsc->src_type != LV_IMAGE_SRC_FILE || lv_strcmp(lv_fs_get_ext((const char*)dsc->src), "bin") != 0) {
+        return LV_RESULT_INVALID;
+    }
+
+    lv_fs_file_t f;
+    if (lv_fs_open(&f, (const char*)dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RESULT_INVALID;
+
+    bool compressed = false;
+    uint32_t payloadSize = 0;
+    uint32_t offset = read_headers(&f, header, &compressed, &payloadSize);
+    lv_fs_close(&f);
+    if (offset == 0) return LV_RESULT_INVALID;
+
+    // Callers see the decoded image
+    header->flags &= ~LV_IMAGE_FLAGS_COMPRESSED;
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decoder_open(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc) {
+    StripContext* ctx = (StripContext*)lv_malloc_zeroed(sizeof(StripContext));
+    if (!ctx) return LV_RESULT_INVALID;
+
+    if (lv_fs_open(&ctx->file, (const char*)dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        lv_free(ctx);
+        return LV_RESULT_INVALID;
+    }
+
+    lv_image_header_t header;
+    ctx->payload_offset = read_headers(&ctx->file, &header, &ctx->compressed, &ctx->payload_size);
+    if (ctx->payload_offset != 0) {
+        ctx->strip = lv_draw_buf_create(header.w, STRIP_IMAGE_ROWS, LV_COLOR_FORMAT_RGB565, header.stride);
+    }
+    if (!ctx->strip) {
+        lv_fs_close(&ctx->file);
+        lv_free(ctx);
+        return LV_RESULT_INVALID;
+    }
+
+    header.flags &= ~LV_IMAGE_FLAGS_COMPRESSED;
+    dsc->header = header;
+    dsc->user_data = ctx;
+    dsc->decoded = NULL;  // Draw through get_area, one strip at a time
+    return LV_RESULT_OK;
+}
+
+static lv_result_t decoder_get_area(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc,
+                                    const lv_area_t* full_area, lv_area_t* decoded_area) {
+    StripContext* ctx = (StripContext*)dsc->user_data;
+    uint32_t stride = dsc->header.stride;
+    uint8_t blk = LV_COLOR_FORMAT_GET_SIZE(LV_COLOR_FORMAT_RGB565);
+    int32_t row;
+
+    if (decoded_area->y1 == LV_COORD_MIN) {
+        // New pass: raw images can start at the first wanted row, RLE must start at the top
+        row = ctx->compressed ? 0 : full_area->y1;
+        uint32_t offset = ctx->payload_offset + (ctx->compressed ? 0 : (uint32_t)row * stride);
+        lv_fs_seek(&ctx->file, offset, LV_FS_SEEK_SET);
+        strip_decoder_init(&ctx->dec, file_read, &ctx->file, blk, ctx->compressed, ctx->payload_size);
+    } else {
+        row = decoded_area->y2 + 1;
+    }
+
+    // Rows above the wanted area still have to pass through the RLE decoder
+    while (row < full_area->y1) {
+        int32_t skip = LV_MIN(STRIP_IMAGE_ROWS, full_area->y1 - row);
+        if (!strip_decoder_read(&ctx->dec, ctx->strip->data, (uint32_t)skip * stride)) return LV_RESULT_INVALID;
+        row += skip;
+    }
+
+    if (row > full_area->y2) return LV_RESULT_INVALID;
+
+    int32_t rows = LV_MIN(STRIP_IMAGE_ROWS, full_area->y2 - row + 1);
+    if (!strip_decoder_read(&ctx->dec, ctx->strip->data, (uint32_t)rows * stride)) {
+        return LV_RESULT_INVALID;
+    }
+
+    decoded_area->x1 = 0;
+    decoded_area->x2 = dsc->header.w - 1;
+    decoded_area->y1 = row;
+    decoded_area->y2 = row + rows - 1;
+    dsc->decoded = ctx->strip;
+    return LV_RESULT_OK;
+}
+
+static void decoder_close(lv_image_decoder_t* decoder, lv_image_decoder_dsc_t* dsc) {
+    StripContext* ctx = (StripContext*)dsc->user_data;
+    if (!ctx) return;
+
+    lv_fs_close(&ctx->file);
+    lv_draw_buf_destroy(ctx->strip);
+    lv_free(ctx);
+    dsc->user_data = NULL;
+    dsc->decoded = NULL;
+}
+
+void strip_image_decoder_init() {
+    lv_image_decoder_t* dec = lv_image_decoder_create();
+    if (!dec) {
+        Serial.println("[STRIP] Failed to create image decoder");
+        return;
+    }
+    lv_image_decoder_set_info_cb(dec, decoder_info);
+    lv_image_decoder_set_open_cb(dec, decoder_open);
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
+    lv_image_decoder_set_close_cb(dec, decoder_close);
+
+    Serial.printf("[STRIP] Image decoder registered (%d-row strips)\n", STRIP_IMAGE_ROWS);
+}
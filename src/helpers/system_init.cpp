@@ -7,45 +7,60 @@
 #include "ui_callbacks.h"
 #include "squarelineUI/ui.h"
 #include "JSON_writer.h"
+#include "image_cache.h"
+#include "image_prefetch.h"
+#include "strip_image_decoder.h"
+#include "ui_view_model.h"
+#include "ring_arc.h"
+#include "digit_atlas.h"
+#include "static_layer.h"
 #include <Arduino.h>
 
 void system_state_init() {
     // ===== PERSISTENT STORAGE =====
     storage_init();
     
+    // ===== IMAGE CACHE (decoded SD card images in PSRAM) =====
+    image_cache_init(IMAGE_CACHE_BUDGET_BYTES);
+    image_prefetch_init();
+    strip_image_decoder_init();
+    
     // ===== DISPLAY STATE =====
     display_state_init();
     
-    // ===== BRIGHTNESS (load and restore UI) =====
+    // ===== BRIGHTNESS (load and apply) =====
     uint8_t saved_brightness = load_brightness();
     update_brightness(saved_brightness);
     
-    if (ui_Slider1) {
-        int32_t slider_value = (saved_brightness * 100) / 255;
-        lv_slider_set_value(ui_Slider1, slider_value, LV_ANIM_OFF);
-        Serial.printf("Restored brightness slider to: %d\n", slider_value);
-    }
-    
-    // ===== ALARM (initialize, load, and restore UI) =====
+    // ===== ALARM (initialize and load) =====
     alarm_init();
     
     bool saved_alarm_enabled = load_alarm_enabled();
     set_alarm_enabled(saved_alarm_enabled);
-    
-    if (ui_Switch1) {
-        if (saved_alarm_enabled) {
-            lv_obj_set_state(ui_Switch1, LV_STATE_CHECKED, 0);
-        } else {
-            lv_obj_clear_state(ui_Switch1, LV_STATE_CHECKED);
-        }
-        Serial.printf("Restored alarm state to: %s\n", saved_alarm_enabled ? "enabled" : "disabled");
-    }
+    Serial.printf("Restored brightness %u, alarm %s\n", saved_brightness,
+                  saved_alarm_enabled ? "enabled" : "disabled");
     
     // ===== BATTERY =====
     battery_init();
     
-    // ===== UI CALLBACKS =====
+    // ===== UI CALLBACKS (Screen 3 binds its own when built lazily) =====
     setup_ui_callbacks();
+    
+    // ===== TIMER ARCS (ring mask renderer; Screen2's attaches when built) =====
+    ring_arc_attach(ui_timer_arc);
+    ring_arc_attach(ui_timer_arc3);
+    
+    // ===== STATIC LAYER (Screen1 background composited once) =====
+    // Everything below the timer arc, plus the arrow image which does not overlap it
+    lv_obj_t* const screen1_static[] = {ui_Image1, ui_textBackground, ui_eventOverlay, ui_Image5};
+    static_layer_init(ui_Screen1, screen1_static, sizeof(screen1_static) / sizeof(screen1_static[0]));
+    
+    // ===== DIGIT ATLAS (countdown and clock blit prerendered glyphs) =====
+    digit_atlas_attach(ui_timeLabel);
+    digit_atlas_attach(ui_currentTimeLabel);
+    
+    // ===== VIEW MODEL (screens refresh only what they show) =====
+    view_model_init();
 
     // ===== TEST =====
 
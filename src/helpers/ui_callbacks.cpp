@@ -3,13 +3,21 @@
 #include "squarelineUI/ui.h"
 #include "alarm.h"
 #include "persistent_storage.h"
+#include "ui_view_model.h"
+#include "ring_arc.h"
 #include <Arduino.h>
 
 /**
  * BRIGHTNESS SLIDER CALLBACK (Screen 3)
- * Called whenever ui_Slider1 value changes
+ * Called whenever ui_Slider1 value changes, and when it is released
  */
 void brightness_slider_event_cb(lv_event_t * e) {
+    // Save to persistent storage once the drag ends, not on every step
+    if (lv_event_get_code(e) == LV_EVENT_RELEASED) {
+        save_brightness(display_state.brightness);
+        return;
+    }
+    
     // IMPORTANT: Cast void* to lv_obj_t* to fix the compiler error
     lv_obj_t * slider = (lv_obj_t *)lv_event_get_target(e);
     
@@ -17,14 +25,11 @@ void brightness_slider_event_cb(lv_event_t * e) {
     int32_t slider_value = lv_slider_get_value(slider);
     
     // Convert to brightness range (0-255)
-    uint8_t brightness = (slider_value * 255) / 100;
+    uint8_t brightness = brightness_from_slider(slider_value);
     
     // Update display brightness
     update_brightness(brightness);
     
-    // Save to persistent storage
-    save_brightness(brightness);
-    
     Serial.print("Brightness slider moved to: ");
     Serial.println(slider_value);
     Serial.print("Brightness value (0-255): ");
@@ -50,13 +55,18 @@ void alarm_toggle_event_cb(lv_event_t * e) {
 
 /**
  * Register all UI event callbacks
- * Call this in setup() after ui_init()
+ * Call this in setup() after ui_init(); screens built later call it again
  */
 void setup_ui_callbacks(void) {
+    // Screen 3 is built on first navigation (see ui_screen_created)
+    if (!ui_Screen3) return;
+
     // Register brightness slider callback (Screen 3)
     if (ui_Slider1 != NULL) {
         lv_obj_add_event_cb(ui_Slider1, brightness_slider_event_cb, 
                            LV_EVENT_VALUE_CHANGED, NULL);
+        lv_obj_add_event_cb(ui_Slider1, brightness_slider_event_cb, 
+                           LV_EVENT_RELEASED, NULL);
         Serial.println("Brightness slider callback registered");
     } else {
         Serial.println("ERROR: ui_Slider1 is NULL!");
@@ -71,3 +81,20 @@ void setup_ui_callbacks(void) {
         Serial.println("ERROR: ui_Switch1 is NULL!");
     }
 }
+
+void ui_screen_created(lv_obj_t* screen) {
+    if (screen == ui_Screen2) {
+        ring_arc_attach(ui_timer_arc3);
+    } else if (screen == ui_Screen3) {
+        setup_ui_callbacks();
+    }
+
+    // Widgets are filled from the view model when the screen starts loading
+    view_model_attach(screen);
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("[UI] Screen %s built, LVGL heap used %u bytes\n",
+                  screen == ui_Screen2 ? "2" : screen == ui_Screen3 ? "3" : "?",
+                  (unsigned)(mon.total_size - mon.free_size));
+}
@@ -0,0 +1,137 @@
+#include "ui_view_model.h"
+#include "squarelineUI/ui.h"
+#include "display_helpers.h"
+#include "battery_management.h"
+#include "alarm.h"
+#include <Arduino.h>
+#include <time.h>
+
+typedef struct {
+    lv_obj_t** screen;
+    uint32_t topics;
+    uint32_t stale;          // Topics published while the screen was hidden
+    vm_refresh_fn refresh;
+} VmSubscriber;
+
+static VmSubscriber subscribers[VM_MAX_SUBSCRIBERS];
+static int subscriber_count = 0;
+
+static VmSubscriber* find_subscriber(lv_obj_t* screen) {
+    if (!screen) return NULL;
+    for (int i = 0; i < subscriber_count; i++) {
+        if (*subscribers[i].screen == screen) return &subscribers[i];
+    }
+    return NULL;
+}
+
+static bool is_visible(const VmSubscriber* sub) {
+    return *sub->screen != NULL && *sub->screen == lv_screen_active();
+}
+
+static void catch_up(VmSubscriber* sub) {
+    uint32_t topics = sub->stale;
+    sub->stale = 0;
+    if (topics) sub->refresh(topics);
+}
+
+void view_model_subscribe(lv_obj_t** screen, uint32_t topics, vm_refresh_fn refresh) {
+    if (subscriber_count >= VM_MAX_SUBSCRIBERS) {
+        Serial.println("[VM] Too many subscribers");
+        return;
+    }
+    VmSubscriber* sub = &subscribers[subscriber_count++];
+    sub->screen = screen;
+    sub->topics = topics;
+    sub->stale = topics;
+    sub->refresh = refresh;
+}
+
+void view_model_publish(uint32_t topics) {
+    for (int i = 0; i < subscriber_count; i++) {
+        VmSubscriber* sub = &subscribers[i];
+        uint32_t mine = topics & sub->topics;
+        if (!mine) continue;
+
+        if (is_visible(sub)) {
+            sub->refresh(mine);
+        } else {
+            sub->stale |= mine;
+        }
+    }
+}
+
+static void screen_load_start_cb(lv_event_t* e) {
+    VmSubscriber* sub = find_subscriber(lv_event_get_target_obj(e));
+    if (sub) catch_up(sub);
+}
+
+void view_model_attach(lv_obj_t* screen) {
+    VmSubscriber* sub = find_subscriber(screen);
+    if (!sub) return;
+
+    // A freshly built screen shows nothing yet
+    sub->stale = sub->topics;
+    lv_obj_add_event_cb(screen, screen_load_start_cb, LV_EVENT_SCREEN_LOAD_START, NULL);
+
+    if (is_visible(sub)) catch_up(sub);
+}
+
+// ============ SCREEN BINDINGS ============
+
+static void screen1_refresh(uint32_t topics) {
+    if (topics & VM_TOPIC_TIMER) {
+        apply_timer_arc(ui_timer_arc);
+    }
+    if (topics & VM_TOPIC_CLOCK) {
+        // Countdown in timeLabel and event label
+        ui_Screen1_updateCountdown();
+
+        // Current time at bottom
+        if (ui_currentTimeLabel) {
+            time_t now = time(nullptr);
+            char currentTimeStr[32];
+            strftime(currentTimeStr, sizeof(currentTimeStr), "%H:%M:%S", localtime(&now));
+            update_label_text(ui_currentTimeLabel, currentTimeStr);
+        }
+    }
+}
+
+static void screen2_refresh(uint32_t topics) {
+    if (topics & VM_TOPIC_TIMER) {
+        apply_timer_arc(ui_timer_arc3);
+    }
+    if (topics & VM_TOPIC_SCHEDULE) {
+        ui_Screen2_updateScheduleDisplay();
+    }
+}
+
+static void screen3_refresh(uint32_t topics) {
+    if (topics & VM_TOPIC_BATTERY) {
+        battery_refresh_ui();
+    }
+    if (topics & VM_TOPIC_SETTINGS) {
+        // Leave a slider that already shows this brightness (e.g. the one being
+        // dragged): the conversion does not round-trip, and it would jump
+        if (ui_Slider1 && brightness_from_slider(lv_slider_get_value(ui_Slider1)) != display_state.brightness) {
+            lv_slider_set_value(ui_Slider1, (display_state.brightness * 100) / 255, LV_ANIM_OFF);
+        }
+        if (ui_Switch1) {
+            if (alarm_state.enabled) {
+                lv_obj_add_state(ui_Switch1, LV_STATE_CHECKED);
+            } else {
+                lv_obj_clear_state(ui_Switch1, LV_STATE_CHECKED);
+            }
+        }
+    }
+}
+
+void view_model_init() {
+    view_model_subscribe(&ui_Screen1, VM_TOPIC_TIMER | VM_TOPIC_CLOCK, screen1_refresh);
+    view_model_subscribe(&ui_Screen2, VM_TOPIC_TIMER | VM_TOPIC_SCHEDULE, screen2_refresh);
+    view_model_subscribe(&ui_Screen3, VM_TOPIC_BATTERY | VM_TOPIC_SETTINGS, screen3_refresh);
+
+    // Screens built by ui_init(); lazy ones attach through ui_screen_created()
+    view_model_attach(ui_Screen1);
+    view_model_attach(ui_Screen2);
+    view_model_attach(ui_Screen3);
+}
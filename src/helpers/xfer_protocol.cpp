@@ -0,0 +1,343 @@
+#include "xfer_protocol.h"
+#include <string.h>
+
+#define START_FIXED 19           // START without the name
+#define READY_LEN 13
+
+static inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint16_t get16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t get32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint32_t chunk_count(uint32_t size, uint16_t chunk) {
+    return chunk ? (size + chunk - 1) / chunk : 0;
+}
+
+static uint32_t chunk_length(const XferHeader* h, uint32_t total, uint32_t seq) {
+    if (seq + 1 < total) return h->chunk;
+    return h->size - seq * h->chunk;
+}
+
+// ============ RECEIVER ============
+
+void xfer_receiver_init(XferReceiver* r, const XferReceiverOps* ops, uint16_t max_chunk, uint8_t* slots) {
+    memset(r, 0, sizeof(*r));
+    r->ops = *ops;
+    r->max_chunk = max_chunk;
+    r->slots = slots;
+}
+
+static void send_sack(XferReceiver* r) {
+    uint8_t frame[XFER_FRAME_MAX];
+    frame[0] = XFER_OP_SACK;
+    put32(frame + 1, r->header.id);
+    put32(frame + 5, r->base);
+    frame[9] = 4;
+    put32(frame + 10, r->present);
+    r->ops.send(r->ops.ctx, frame, 14);
+
+    r->since_ack = 0;
+    r->ack_pending = false;
+    r->sacks_sent++;
+}
+
+static void finish(XferReceiver* r, XferEnd how) {
+    r->active = false;
+    r->completed = false;
+    r->ack_pending = false;
+    bool ok = !r->ops.on_end || r->ops.on_end(r->ops.ctx, how);
+    // A file that failed verification is not delivered: a repeated START must start it again
+    r->completed = how == XFER_END_COMPLETE && ok;
+}
+
+static void send_ready(XferReceiver* r) {
+    uint8_t ready[READY_LEN];
+    ready[0] = XFER_OP_READY;
+    put32(ready + 1, r->header.id);
+    put16(ready + 5, r->header.chunk);
+    put16(ready + 7, r->header.window);
+    put32(ready + 9, r->header.resume);
+    r->ops.send(r->ops.ctx, ready, sizeof(ready));
+}
+
+static void handle_start(XferReceiver* r, const uint8_t* f, size_t len) {
+    if (len < START_FIXED || f[1] != XFER_VERSION) return;
+    XferHeader h;
+    memset(&h, 0, sizeof(h));
+    h.id = get32(f + 2);
+    h.size = get32(f + 6);
+    h.crc = get32(f + 10);
+    h.chunk = get16(f + 14);
+    h.window = get16(f + 16);
+    size_t name_len = f[18];
+    if (name_len > XFER_NAME_MAX || START_FIXED + name_len > len) return;
+    memcpy(h.name, f + START_FIXED, name_len);
+
+    // A repeated START (lost READY) is answered again without restarting
+    if ((r->active || r->completed) && r->header.id == h.id) {
+        r->header.resume = r->base;
+        send_ready(r);
+        return;
+    }
+    if (r->active) finish(r, XFER_END_SUSPENDED);
+
+    if (h.chunk == 0 || h.chunk > r->max_chunk) h.chunk = r->max_chunk;
+    if (h.window == 0 || h.window > XFER_WINDOW_MAX) h.window = XFER_WINDOW_MAX;
+    h.resume = 0;
+    if (!r->ops.on_start(r->ops.ctx, &h)) return;
+    if (h.chunk == 0 || h.chunk > r->max_chunk) h.chunk = r->max_chunk;
+    if (h.window == 0 || h.window > XFER_WINDOW_MAX) h.window = XFER_WINDOW_MAX;
+
+    r->header = h;
+    r->total_chunks = chunk_count(h.size, h.chunk);
+    if (h.resume > r->total_chunks) r->header.resume = r->total_chunks;
+    r->base = r->header.resume;
+    r->present = 0;
+    r->since_ack = 0;
+    r->ack_pending = false;
+    r->duplicates = 0;
+    r->out_of_window = 0;
+    r->sacks_sent = 0;
+    r->completed = false;
+    r->active = true;
+
+    send_ready(r);
+
+    // Empty, or everything already stored before a reboot
+    if (r->base == r->total_chunks) {
+        send_sack(r);
+        finish(r, XFER_END_COMPLETE);
+    }
+}
+
+/**
+ * Hand buffered chunks from base onwards to the sink
+ */
+static bool deliver(XferReceiver* r, const uint8_t* data, size_t len) {
+    if (!r->ops.on_data(r->ops.ctx, data, len)) return false;
+    r->base++;
+    while (r->present & 1u) {
+        uint32_t slot = r->base % XFER_WINDOW_MAX;
+        if (!r->ops.on_data(r->ops.ctx, r->slots + (size_t)slot * r->max_chunk, r->slot_len[slot])) return false;
+        r->present >>= 1;
+        r->base++;
+    }
+    r->present >>= 1;
+    return true;
+}
+
+static void handle_data(XferReceiver* r, const uint8_t* f, size_t len, uint32_t now_ms) {
+    if (len < XFER_DATA_HEADER) return;
+    if (!r->active) {
+        // The final SACK was lost and the sender is still retransmitting
+        if (r->completed) send_sack(r);
+        return;
+    }
+    uint32_t seq = get32(f + 1);
+    const uint8_t* payload = f + XFER_DATA_HEADER;
+    size_t payload_len = len - XFER_DATA_HEADER;
+    r->last_rx_ms = now_ms;
+
+    if (seq >= r->total_chunks || payload_len != chunk_length(&r->header, r->total_chunks, seq)) return;
+
+    uint32_t ahead = seq - r->base;
+    if (seq >= r->base && ahead >= r->header.window) {
+        r->out_of_window++;
+        return;
+    }
+    // ahead < window <= 32 from here, so the bit test is defined
+    if (seq < r->base || (ahead > 0 && (r->present & (1u << (ahead - 1))))) {
+        // Already have it: our SACK was probably lost, repeat it soon
+        r->duplicates++;
+        r->ack_pending = true;
+        return;
+    }
+
+    if (ahead == 0) {
+        if (!deliver(r, payload, payload_len)) {
+            finish(r, XFER_END_SUSPENDED);
+            return;
+        }
+    } else {
+        uint32_t slot = seq % XFER_WINDOW_MAX;
+        memcpy(r->slots + (size_t)slot * r->max_chunk, payload, payload_len);
+        r->slot_len[slot] = (uint16_t)payload_len;
+        r->present |= 1u << (ahead - 1);
+        // A gap: tell the sender straight away
+        r->ack_pending = true;
+    }
+
+    r->since_ack++;
+    if (r->base == r->total_chunks) {
+        send_sack(r);
+        finish(r, XFER_END_COMPLETE);
+    } else if (r->since_ack >= XFER_ACK_EVERY || (r->ack_pending && ahead > 0 && r->since_ack >= 2)) {
+        send_sack(r);
+    } else {
+        r->ack_pending = true;
+    }
+}
+
+void xfer_receiver_input(XferReceiver* r, const uint8_t* frame, size_t len, uint32_t now_ms) {
+    if (len == 0) return;
+    switch (frame[0]) {
+        case XFER_OP_START:
+            handle_start(r, frame, len);
+            break;
+        case XFER_OP_DATA:
+            handle_data(r, frame, len, now_ms);
+            break;
+        case XFER_OP_CANCEL:
+            if (r->active && len >= 5 && get32(frame + 1) == r->header.id) finish(r, XFER_END_CANCELLED);
+            break;
+        default:
+            break;
+    }
+}
+
+void xfer_receiver_poll(XferReceiver* r, uint32_t now_ms) {
+    if (r->active && r->ack_pending && now_ms - r->last_rx_ms >= XFER_ACK_IDLE_MS) {
+        send_sack(r);
+    }
+}
+
+void xfer_receiver_abort(XferReceiver* r) {
+    if (r->active) finish(r, XFER_END_SUSPENDED);
+}
+
+uint32_t xfer_receiver_bytes(const XferReceiver* r) {
+    uint32_t bytes = r->base * r->header.chunk;
+    return bytes < r->header.size ? bytes : r->header.size;
+}
+
+// ============ SENDER ============
+
+static bool send_start(XferSender* s) {
+    uint8_t frame[XFER_FRAME_MAX];
+    size_t name_len = strlen(s->header.name);
+    frame[0] = XFER_OP_START;
+    frame[1] = XFER_VERSION;
+    put32(frame + 2, s->header.id);
+    put32(frame + 6, s->header.size);
+    put32(frame + 10, s->header.crc);
+    put16(frame + 14, s->header.chunk);
+    put16(frame + 16, s->header.window);
+    frame[18] = (uint8_t)name_len;
+    memcpy(frame + START_FIXED, s->header.name, name_len);
+    return s->ops.send(s->ops.ctx, frame, START_FIXED + name_len);
+}
+
+void xfer_sender_start(XferSender* s, const XferSenderOps* ops, const XferHeader* header, uint32_t now_ms) {
+    memset(s, 0, sizeof(*s));
+    s->ops = *ops;
+    s->header = *header;
+    if (s->header.window == 0 || s->header.window > XFER_WINDOW_MAX) s->header.window = XFER_WINDOW_MAX;
+    if (send_start(s)) s->start_sent_ms = now_ms;
+}
+
+static bool send_chunk(XferSender* s, uint32_t seq, uint32_t now_ms) {
+    uint8_t frame[XFER_DATA_HEADER + 1024];
+    size_t len = chunk_length(&s->header, s->total_chunks, seq);
+    if (len > sizeof(frame) - XFER_DATA_HEADER) return false;
+
+    frame[0] = XFER_OP_DATA;
+    put32(frame + 1, seq);
+    s->ops.read(s->ops.ctx, seq * s->header.chunk, frame + XFER_DATA_HEADER, len);
+    if (!s->ops.send(s->ops.ctx, frame, XFER_DATA_HEADER + len)) return false;
+
+    uint32_t slot = seq % XFER_WINDOW_MAX;
+    s->sent_ms[slot] = now_ms;
+    s->sent_order[slot] = ++s->frames_sent;
+    return true;
+}
+
+static bool is_acked(const XferSender* s, uint32_t seq) {
+    if (seq < s->base) return true;
+    uint32_t ahead = seq - s->base;
+    return ahead > 0 && ahead <= 32 && (s->acked & (1u << (ahead - 1)));
+}
+
+void xfer_sender_input(XferSender* s, const uint8_t* f, size_t len, uint32_t now_ms) {
+    (void)now_ms;
+    if (len < 5 || get32(f + 1) != s->header.id) return;
+
+    if (f[0] == XFER_OP_READY && len >= READY_LEN) {
+        if (s->ready) return;
+        s->header.chunk = get16(f + 5);
+        s->header.window = get16(f + 7);
+        s->total_chunks = chunk_count(s->header.size, s->header.chunk);
+        s->base = s->next = get32(f + 9);
+        s->ready = true;
+        s->done = s->base >= s->total_chunks;
+        return;
+    }
+    if (f[0] != XFER_OP_SACK || len < 10 || !s->ready) return;
+
+    uint32_t base = get32(f + 5);
+    uint32_t bits = 0;
+    for (uint32_t i = 0; i < f[9] && i < 4 && 10 + i < len; i++) bits |= (uint32_t)f[10 + i] << (8 * i);
+    if (base < s->base || base > s->next) return;  // Stale or corrupt
+
+    s->base = base;
+    s->acked = bits;
+    if (s->base >= s->total_chunks) {
+        s->done = true;
+        return;
+    }
+
+    // A chunk is lost once one sent after it has arrived (a resent chunk gets a new turn)
+    uint32_t latest = 0;
+    for (uint32_t seq = base + 1; seq < s->next; seq++) {
+        uint32_t order = s->sent_order[seq % XFER_WINDOW_MAX];
+        if (is_acked(s, seq) && order > latest) latest = order;
+    }
+    s->resend = 0;
+    for (uint32_t seq = base; seq < s->next; seq++) {
+        if (!is_acked(s, seq) && s->sent_order[seq % XFER_WINDOW_MAX] < latest) s->resend |= 1u << (seq - base);
+    }
+}
+
+void xfer_sender_poll(XferSender* s, uint32_t now_ms) {
+    if (s->done) return;
+    if (!s->ready) {
+        if (now_ms - s->start_sent_ms >= XFER_RETRANSMIT_MS && send_start(s)) s->start_sent_ms = now_ms;
+        return;
+    }
+
+    // Gaps reported by SACK first
+    for (uint32_t i = 0; s->resend && i < 32; i++) {
+        if (!(s->resend & (1u << i))) continue;
+        if (!send_chunk(s, s->base + i, now_ms)) return;
+        s->resend &= ~(1u << i);
+        s->retransmits++;
+    }
+
+    // Then chunks nothing has covered for too long
+    for (uint32_t seq = s->base; seq < s->next; seq++) {
+        if (is_acked(s, seq)) continue;
+        if (now_ms - s->sent_ms[seq % XFER_WINDOW_MAX] < XFER_RETRANSMIT_MS) continue;
+        if (!send_chunk(s, seq, now_ms)) return;
+        s->retransmits++;
+    }
+
+    // Then new chunks while the window allows
+    while (s->next < s->total_chunks && s->next < s->base + s->header.window) {
+        if (!send_chunk(s, s->next, now_ms)) return;
+        s->next++;
+    }
+}
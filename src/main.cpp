@@ -12,6 +12,13 @@
 #include "logic_fsm.h"
 #include "ble_service.h"
 #include "schedule_manager.h"
+#include "image_loader.h"
+#include "image_prefetch.h"
+#include "lv_fs_sd.h"
+#include "ui_view_model.h"
+#include "render_stats.h"
+#include "digit_atlas.h"
+#include "refresh_governor.h"
 #include "squarelineUI/ui.h"
 //#include "ui_fsm.h"
 
@@ -33,18 +40,16 @@ void setup()
   // Initialize the device state machine
   logic_fsm_init();
   
-  // Load schedule from SD card and display on Screen 2
-  ui_Screen2_updateScheduleDisplay();
-  
-  // Update Screen 1 with countdown to next event
-  ui_Screen1_updateCountdown();
+  // Schedule is loaded from SD card; Screen 1 shows the countdown,
+  // Screen 2 picks the list up when it is opened
+  view_model_publish(VM_TOPIC_SCHEDULE | VM_TOPIC_CLOCK);
   
   Serial.println("Setup complete!");
 }
 
 void loop()
 {  
-    // Update battery display. Screen 3 is dynamic, screen 1 is not
+    // Sample the battery; Screen 3 renders it only while shown
     update_battery_display();
 
     // Logic tick function, controls the timers and the alarms
@@ -56,6 +61,9 @@ void loop()
     // Render all display state changes
     render_display_state();
     
+    // Load the next event's image into the cache ahead of its start
+    image_prefetch_tick();
+    
     // Periodically update NVS with current time (ensures it's never stale after reboot)
     updateNVSTimeIfNeeded();
     
@@ -68,10 +76,13 @@ void loop()
     // Process any pending BLE file transfers (must be in main loop to avoid stack overflow)
     processBLEFileData();
     
+    // Notify the phone of schedule, battery, clock and transfer changes
+    updateBLEDeviceState();
+    
     // Check if Screen 2 needs update after time sync (thread-safe flag from BLE callback)
     if (shouldUpdateScreen2AfterTimeSync()) {
         Serial.println("[MAIN] Updating Screen 2 after time sync");
-        ui_Screen2_updateScheduleDisplay();
+        view_model_publish(VM_TOPIC_SCHEDULE);
     }
     
     // Check schedule every minute and log state
@@ -101,34 +112,35 @@ void loop()
             }
         }
         
-        // Update Screen 2 schedule display with current data from duration.json
-        ui_Screen2_updateScheduleDisplay();
+        image_loader_log_stats();
+        lv_fs_sd_log_stats();
+        render_stats_log();
+        digit_atlas_log_stats();
+        refresh_governor_log_stats();
         
-        // Update Screen 1 countdown display
-        ui_Screen1_updateCountdown();
+        // Past/current/future highlighting in the Screen 2 list moves with the clock
+        view_model_publish(VM_TOPIC_SCHEDULE);
     }
     
     // LVGL GUI handler
     lv_timer_handler();
     
+    static bool firstFrameLogged = false;
+    if (!firstFrameLogged) {
+        firstFrameLogged = true;
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        Serial.printf("[UI] First frame at %lu ms, LVGL heap used %u bytes\n",
+                      millis(), (unsigned)(mon.total_size - mon.free_size));
+    }
+    
     // Update time and countdown displays (every second)
     static unsigned long lastDisplayUpdate = 0;
     if (millis() - lastDisplayUpdate > 1000) {
         lastDisplayUpdate = millis();
         
-        // Get current time for display
-        time_t now = time(nullptr);
-        struct tm* timeinfo = localtime(&now);
-        char currentTimeStr[32];
-        strftime(currentTimeStr, sizeof(currentTimeStr), "%H:%M:%S", timeinfo);
-        
-        // Update countdown in timeLabel and event label on Screen 1
-        ui_Screen1_updateCountdown();
-        
-        // Update current time at bottom
-        if (ui_currentTimeLabel) {
-            lv_label_set_text(ui_currentTimeLabel, currentTimeStr);
-        }
+        // Countdown, event label and current time on Screen 1
+        view_model_publish(VM_TOPIC_CLOCK);
     }
     
     delay(5);
@@ -26,6 +26,7 @@ extern "C" {
 #include "ui_events.h"
 #include "ui_theme_manager.h"
 #include "ui_themes.h"
+#include "ui_shared_styles.h"
 
 ///////////////////// SCREENS ////////////////////
 #include "ui_Screen1.h"
@@ -44,10 +45,26 @@ extern lv_obj_t *ui____initial_actions0;
 // LV_IMG_DECLARE( ui_img_rightarrow2_png);   // assets/rightArrow2.png
 // LV_IMG_DECLARE( ui_img_cog_png);   // assets/cog.png
 
+// LAZY SCREENS
+// Screen1 is built by ui_init(); Screen2 and Screen3 are built on first
+// navigation and, with UI_DESTROY_ON_LEAVE, deleted again when unloaded.
+#ifndef UI_LAZY_SCREENS
+#define UI_LAZY_SCREENS 1
+#endif
+#ifndef UI_DESTROY_ON_LEAVE
+#define UI_DESTROY_ON_LEAVE 1
+#endif
+
 // UI INIT
 void ui_init(void);
 void ui_destroy(void);
 
+/**
+ * Called after a screen is built on navigation, so the firmware can bind
+ * callbacks and fill it with current state. Implemented in ui_callbacks.cpp.
+ */
+void ui_screen_created(lv_obj_t *screen);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
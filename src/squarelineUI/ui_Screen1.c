@@ -50,8 +50,7 @@ void ui_Screen1_screen_init(void)
 {
 ui_Screen1 = lv_obj_create(NULL);
 lv_obj_remove_flag( ui_Screen1, LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_Screen1, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Screen1, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Screen1, &ui_style_bg_black, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Image1 = lv_image_create(ui_Screen1);
 // lv_image_set_src(ui_Image1, &ui_img_backpacks_png);  // Image moved to SD card
@@ -75,8 +74,7 @@ lv_obj_set_style_arc_opa(ui_textBackground, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_arc_width(ui_textBackground, 100, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_arc_rounded(ui_textBackground, false, LV_PART_MAIN| LV_STATE_DEFAULT);
 
-lv_obj_set_style_bg_color(ui_textBackground, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_textBackground, 0, LV_PART_KNOB| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_textBackground, &ui_style_bg_clear, LV_PART_KNOB | LV_STATE_DEFAULT);
 
 ui_eventOverlay = lv_obj_create(ui_Screen1);
 lv_obj_set_width( ui_eventOverlay, 480);
@@ -85,8 +83,7 @@ lv_obj_set_align( ui_eventOverlay, LV_ALIGN_CENTER );
 lv_obj_remove_flag( ui_eventOverlay, LV_OBJ_FLAG_SCROLLABLE );    /// Flags
 lv_obj_set_style_bg_color(ui_eventOverlay, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
 lv_obj_set_style_bg_opa(ui_eventOverlay, 70, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_border_color(ui_eventOverlay, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_border_opa(ui_eventOverlay, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_eventOverlay, &ui_style_border_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_timer_arc = lv_arc_create(ui_Screen1);
 lv_obj_set_width( ui_timer_arc, 480);
@@ -97,16 +94,13 @@ lv_arc_set_value(ui_timer_arc, 90);
 lv_arc_set_bg_angles(ui_timer_arc,0,360);
 lv_arc_set_mode(ui_timer_arc, LV_ARC_MODE_REVERSE);
 lv_arc_set_rotation(ui_timer_arc,270);
-lv_obj_set_style_arc_color(ui_timer_arc, lv_color_hex(0x304B59), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_arc_opa(ui_timer_arc, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_arc_width(ui_timer_arc, 30, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc, &ui_style_timer_track, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_object_set_themeable_style_property(ui_timer_arc, LV_PART_INDICATOR| LV_STATE_DEFAULT, LV_STYLE_ARC_COLOR, _ui_theme_color_Baby_Blue);
 ui_object_set_themeable_style_property(ui_timer_arc, LV_PART_INDICATOR| LV_STATE_DEFAULT, LV_STYLE_ARC_OPA, _ui_theme_alpha_Baby_Blue);
-lv_obj_set_style_arc_width(ui_timer_arc, 30, LV_PART_INDICATOR| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc, &ui_style_arc_width_30, LV_PART_INDICATOR | LV_STATE_DEFAULT);
 
-lv_obj_set_style_bg_color(ui_timer_arc, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_timer_arc, 0, LV_PART_KNOB| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc, &ui_style_bg_clear, LV_PART_KNOB | LV_STATE_DEFAULT);
 
 ui_Image5 = lv_image_create(ui_Screen1);
 // lv_image_set_src(ui_Image5, &ui_img_rightarrow2_png);  // Image moved to SD card
@@ -127,10 +121,7 @@ lv_obj_set_y( ui_pageChangeButton, 1 );
 lv_obj_set_align( ui_pageChangeButton, LV_ALIGN_CENTER );
 lv_obj_add_flag( ui_pageChangeButton, LV_OBJ_FLAG_SCROLL_ON_FOCUS );   /// Flags
 lv_obj_remove_flag( ui_pageChangeButton, LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_pageChangeButton, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_pageChangeButton, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_color(ui_pageChangeButton, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_shadow_opa(ui_pageChangeButton, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_pageChangeButton, &ui_style_button_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Container5 = lv_obj_create(ui_Screen1);
 lv_obj_remove_style_all(ui_Container5);
@@ -151,10 +142,8 @@ lv_obj_set_y( ui_timeLabel, -47 );
 lv_obj_set_align( ui_timeLabel, LV_ALIGN_CENTER );
 lv_label_set_long_mode(ui_timeLabel,LV_LABEL_LONG_SCROLL);
 lv_label_set_text(ui_timeLabel,"5:48");
-lv_obj_set_style_text_color(ui_timeLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_text_opa(ui_timeLabel, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_text_decor(ui_timeLabel, LV_TEXT_DECOR_NONE, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_text_font(ui_timeLabel, &lv_font_montserrat_48, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timeLabel, &ui_style_text_white, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timeLabel, &ui_style_font_48, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_eventLabel = lv_label_create(ui_Container5);
 lv_obj_set_width( ui_eventLabel, lv_pct(98));
@@ -165,10 +154,9 @@ lv_obj_set_align( ui_eventLabel, LV_ALIGN_CENTER );
 lv_label_set_text(ui_eventLabel,"School");
 lv_obj_remove_flag( ui_eventLabel, LV_OBJ_FLAG_PRESS_LOCK | LV_OBJ_FLAG_CLICK_FOCUSABLE | LV_OBJ_FLAG_GESTURE_BUBBLE | LV_OBJ_FLAG_SNAPPABLE | LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM | LV_OBJ_FLAG_SCROLL_CHAIN );    /// Flags
 lv_obj_set_scrollbar_mode(ui_eventLabel, LV_SCROLLBAR_MODE_OFF);
-lv_obj_set_style_text_color(ui_eventLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_text_opa(ui_eventLabel, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_eventLabel, &ui_style_text_white, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_eventLabel, &ui_style_font_32, LV_PART_MAIN | LV_STATE_DEFAULT);
 lv_obj_set_style_text_align(ui_eventLabel, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_text_font(ui_eventLabel, &lv_font_montserrat_32, LV_PART_MAIN| LV_STATE_DEFAULT);
 
 ui_Container14 = lv_obj_create(ui_Screen1);
 lv_obj_remove_style_all(ui_Container14);
@@ -189,21 +177,14 @@ lv_obj_set_height( ui_batteryBar3, 20);
 lv_obj_set_x( ui_batteryBar3, 78 );
 lv_obj_set_y( ui_batteryBar3, 63 );
 lv_obj_set_align( ui_batteryBar3, LV_ALIGN_CENTER );
-lv_obj_set_style_bg_color(ui_batteryBar3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_batteryBar3, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_border_color(ui_batteryBar3, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_border_opa(ui_batteryBar3, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryBar3, &ui_style_battery_bar, LV_PART_MAIN | LV_STATE_DEFAULT);
 lv_obj_set_style_border_width(ui_batteryBar3, 2, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_border_side(ui_batteryBar3, LV_BORDER_SIDE_FULL, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_outline_color(ui_batteryBar3, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_outline_opa(ui_batteryBar3, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_pad_left(ui_batteryBar3, 3, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_pad_right(ui_batteryBar3, 3, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_pad_top(ui_batteryBar3, 3, LV_PART_MAIN| LV_STATE_DEFAULT);
 lv_obj_set_style_pad_bottom(ui_batteryBar3, 3, LV_PART_MAIN| LV_STATE_DEFAULT);
 
-lv_obj_set_style_bg_color(ui_batteryBar3, lv_color_hex(0x00FF00), LV_PART_INDICATOR | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_batteryBar3, 255, LV_PART_INDICATOR| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryBar3, &ui_style_battery_fill, LV_PART_INDICATOR | LV_STATE_DEFAULT);
 
 //Compensating for LVGL9.1 draw crash with bar/slider max value when top-padding is nonzero and right-padding is 0
 if (lv_obj_get_style_pad_top(ui_batteryBar3,LV_PART_MAIN) > 0) lv_obj_set_style_pad_right( ui_batteryBar3, lv_obj_get_style_pad_right(ui_batteryBar3,LV_PART_MAIN) + 1, LV_PART_MAIN );
@@ -218,7 +199,7 @@ lv_obj_set_flex_align(ui_batteryPercent3, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_STA
 lv_label_set_text(ui_batteryPercent3,"75%");
 ui_object_set_themeable_style_property(ui_batteryPercent3, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR, _ui_theme_color_white);
 ui_object_set_themeable_style_property(ui_batteryPercent3, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA, _ui_theme_alpha_white);
-lv_obj_set_style_text_font(ui_batteryPercent3, &lv_font_montserrat_20, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryPercent3, &ui_style_font_20, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 lv_obj_add_event_cb(ui_pageChangeButton, ui_event_pageChangeButton, LV_EVENT_ALL, NULL);
 lv_obj_add_event_cb(ui_timer_arc, ui_event_timer_arc, LV_EVENT_VALUE_CHANGED, NULL);
@@ -232,8 +213,8 @@ lv_obj_set_x( ui_currentTimeLabel, 0 );
 lv_obj_set_y( ui_currentTimeLabel, 180 );
 lv_obj_set_align( ui_currentTimeLabel, LV_ALIGN_CENTER );
 lv_label_set_text(ui_currentTimeLabel, "00:00:00");
-lv_obj_set_style_text_color(ui_currentTimeLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_text_font(ui_currentTimeLabel, &lv_font_montserrat_32, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_currentTimeLabel, &ui_style_text_white, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_currentTimeLabel, &ui_style_font_32, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 }
 
@@ -278,9 +259,7 @@ void ui_Screen1_updateCountdown(void)
             snprintf(countdownStr, sizeof(countdownStr), "%u:%02u", mins, secs);
         }
         
-        // Update labels directly AND via display_state to prevent overwriting
-        lv_label_set_text(ui_timeLabel, countdownStr);
-        lv_label_set_text(ui_eventLabel, currentEvent->label);
+        // Via display_state so render_display_state() keeps the same text
         update_event_text(currentEvent->label);
         update_time_text(countdownStr);
         
@@ -289,16 +268,12 @@ void ui_Screen1_updateCountdown(void)
                currentEvent->start + (currentEvent->duration / 60));
     } else if (nextEvent) {
         // No current event - hide labels but keep arc animating silently
-        lv_label_set_text(ui_eventLabel, "");
-        lv_label_set_text(ui_timeLabel, "");
         update_event_text("");
         update_time_text("");
         
         printf("[SCREEN1] No current event, waiting for next event\\n");
     } else {
         // No events today - show blank labels
-        lv_label_set_text(ui_eventLabel, "");
-        lv_label_set_text(ui_timeLabel, "");
         update_event_text("");
         update_time_text("");
         printf("[SCREEN1] No events today\\n");
@@ -75,6 +75,9 @@ static void ui_Screen2_scroll_event_cb(lv_event_t * e)
 // Update schedule display with actual data from duration.json
 void ui_Screen2_updateScheduleDisplay(void)
 {
+    // Not built yet (or torn down); it is filled in when navigated to
+    if (!ui_Screen2) return;
+
     printf("[SCREEN2] updateScheduleDisplay() called\n");
     
     // Get all events for the day
@@ -94,17 +97,6 @@ void ui_Screen2_updateScheduleDisplay(void)
         return;
     }
     
-    // Configure container for scroll effect
-    lv_obj_set_size(ui_Container2, 380, 300);  // Make container larger
-    lv_obj_set_flex_flow(ui_Container2, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_scroll_dir(ui_Container2, LV_DIR_VER);
-    lv_obj_set_scroll_snap_y(ui_Container2, LV_SCROLL_SNAP_CENTER);
-    lv_obj_set_scrollbar_mode(ui_Container2, LV_SCROLLBAR_MODE_OFF);
-    lv_obj_set_style_bg_opa(ui_Container2, 0, LV_PART_MAIN);  // Transparent background
-    
-    // Add scroll event callback for transform effect
-    lv_obj_add_event_cb(ui_Container2, ui_Screen2_scroll_event_cb, LV_EVENT_SCROLL, NULL);
-    
     // Clear existing children (delete all event rows)
     lv_obj_t* child;
     while ((child = lv_obj_get_child(ui_Container2, 0)) != NULL) {
@@ -140,10 +132,7 @@ void ui_Screen2_updateScheduleDisplay(void)
                 lv_obj_t* nowContainer = lv_obj_create(ui_Container2);
                 lv_obj_set_width(nowContainer, lv_pct(100));
                 lv_obj_set_height(nowContainer, 90);
-                lv_obj_set_style_pad_all(nowContainer, 10, LV_PART_MAIN);
-                lv_obj_set_style_border_side(nowContainer, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
-                lv_obj_set_style_bg_color(nowContainer, lv_color_hex(0xF5F5F5), LV_PART_MAIN);
-                lv_obj_set_style_bg_opa(nowContainer, 0, LV_PART_MAIN);
+                lv_obj_add_style(nowContainer, &ui_style_schedule_row, LV_PART_MAIN);
                 lv_obj_set_flex_flow(nowContainer, LV_FLEX_FLOW_ROW);
                 lv_obj_set_flex_align(nowContainer, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
                 lv_obj_remove_flag(nowContainer, LV_OBJ_FLAG_SCROLLABLE);
@@ -154,8 +143,7 @@ void ui_Screen2_updateScheduleDisplay(void)
                 snprintf(nowTimeStr, sizeof(nowTimeStr), "%02d:%02d", timeinfo->tm_hour, timeinfo->tm_min);
                 lv_label_set_text(nowTimeLabel, nowTimeStr);
                 lv_obj_set_width(nowTimeLabel, 80);
-                lv_obj_set_style_text_font(nowTimeLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-                lv_obj_set_style_text_color(nowTimeLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+                lv_obj_add_style(nowTimeLabel, &ui_style_schedule_time, LV_PART_MAIN);
                 
                 // "Now" label
                 lv_obj_t* nowLabelScroll = lv_obj_create(nowContainer);
@@ -163,14 +151,12 @@ void ui_Screen2_updateScheduleDisplay(void)
                 lv_obj_set_height(nowLabelScroll, 70);
                 lv_obj_set_scroll_dir(nowLabelScroll, LV_DIR_HOR);
                 lv_obj_set_scrollbar_mode(nowLabelScroll, LV_SCROLLBAR_MODE_OFF);
-                lv_obj_set_style_bg_opa(nowLabelScroll, 0, LV_PART_MAIN);
-                lv_obj_set_style_border_side(nowLabelScroll, LV_BORDER_SIDE_NONE, LV_PART_MAIN);
+                lv_obj_add_style(nowLabelScroll, &ui_style_schedule_scroll, LV_PART_MAIN);
                 lv_obj_remove_flag(nowLabelScroll, LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM);
                 
                 lv_obj_t* nowLabel = lv_label_create(nowLabelScroll);
                 lv_label_set_text(nowLabel, "Now");
-                lv_obj_set_style_text_font(nowLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-                lv_obj_set_style_text_color(nowLabel, lv_color_hex(0xFFD700), LV_PART_MAIN);
+                lv_obj_add_style(nowLabel, &ui_style_schedule_current, LV_PART_MAIN);
                 lv_obj_set_align(nowLabel, LV_ALIGN_LEFT_MID);
                 
                 goldEventContainer = nowContainer;  // Track this as the gold container
@@ -183,10 +169,7 @@ void ui_Screen2_updateScheduleDisplay(void)
         lv_obj_t* eventContainer = lv_obj_create(ui_Container2);
         lv_obj_set_width(eventContainer, lv_pct(100));
         lv_obj_set_height(eventContainer, 90);
-        lv_obj_set_style_pad_all(eventContainer, 10, LV_PART_MAIN);
-        lv_obj_set_style_border_side(eventContainer, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(eventContainer, lv_color_hex(0xF5F5F5), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(eventContainer, 0, LV_PART_MAIN);
+        lv_obj_add_style(eventContainer, &ui_style_schedule_row, LV_PART_MAIN);
         lv_obj_set_flex_flow(eventContainer, LV_FLEX_FLOW_ROW);
         lv_obj_set_flex_align(eventContainer, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
         lv_obj_remove_flag(eventContainer, LV_OBJ_FLAG_SCROLLABLE);
@@ -197,8 +180,7 @@ void ui_Screen2_updateScheduleDisplay(void)
         getTimeDisplayFormat(event->start, timeStr, sizeof(timeStr));
         lv_label_set_text(timeLabel, timeStr);
         lv_obj_set_width(timeLabel, 80);
-        lv_obj_set_style_text_font(timeLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-        lv_obj_set_style_text_color(timeLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+        lv_obj_add_style(timeLabel, &ui_style_schedule_time, LV_PART_MAIN);
         
         // Create scroll container for event label (handles horizontal overflow)
         lv_obj_t* eventLabelScroll = lv_obj_create(eventContainer);
@@ -206,32 +188,30 @@ void ui_Screen2_updateScheduleDisplay(void)
         lv_obj_set_height(eventLabelScroll, 70);
         lv_obj_set_scroll_dir(eventLabelScroll, LV_DIR_HOR);
         lv_obj_set_scrollbar_mode(eventLabelScroll, LV_SCROLLBAR_MODE_OFF);
-        lv_obj_set_style_bg_opa(eventLabelScroll, 0, LV_PART_MAIN);  // Transparent background
-        lv_obj_set_style_border_side(eventLabelScroll, LV_BORDER_SIDE_NONE, LV_PART_MAIN);
+        lv_obj_add_style(eventLabelScroll, &ui_style_schedule_scroll, LV_PART_MAIN);
         lv_obj_remove_flag(eventLabelScroll, LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM);
         
         // Create event label inside scroll container
         lv_obj_t* eventLabel = lv_label_create(eventLabelScroll);
-        lv_obj_set_style_text_font(eventLabel, &lv_font_montserrat_28, LV_PART_MAIN);
         lv_obj_set_align(eventLabel, LV_ALIGN_LEFT_MID);
         
         // Set text and color based on event state
         if (isCurrent) {
             // Current event - shown in gold
             lv_label_set_text(eventLabel, event->label);
-            lv_obj_set_style_text_color(eventLabel, lv_color_hex(0xFFD700), LV_PART_MAIN);
+            lv_obj_add_style(eventLabel, &ui_style_schedule_current, LV_PART_MAIN);
             goldEventContainer = eventContainer;  // Track current event for scroll
             printf("[SCREEN2] Event %u: %s (CURRENT)\n", 
                 (unsigned int)i, event->label);
         } else if (isPast) {
             // Past event - show in gray
             lv_label_set_text(eventLabel, event->label);
-            lv_obj_set_style_text_color(eventLabel, lv_color_hex(0x808080), LV_PART_MAIN);
+            lv_obj_add_style(eventLabel, &ui_style_schedule_past, LV_PART_MAIN);
             printf("[SCREEN2] Event %u: %s (past)\n", (unsigned int)i, event->label);
         } else {
             // Future event - show in white
             lv_label_set_text(eventLabel, event->label);
-            lv_obj_set_style_text_color(eventLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+            lv_obj_add_style(eventLabel, &ui_style_schedule_future, LV_PART_MAIN);
             printf("[SCREEN2] Event %u: %s (upcoming)\n", (unsigned int)i, event->label);
         }
     }
@@ -253,10 +233,7 @@ void ui_Screen2_updateScheduleDisplay(void)
         lv_obj_move_to_index(nowContainer, 0);  // Move to front
         lv_obj_set_width(nowContainer, lv_pct(100));
         lv_obj_set_height(nowContainer, 90);
-        lv_obj_set_style_pad_all(nowContainer, 10, LV_PART_MAIN);
-        lv_obj_set_style_border_side(nowContainer, LV_BORDER_SIDE_BOTTOM, LV_PART_MAIN);
-        lv_obj_set_style_bg_color(nowContainer, lv_color_hex(0xF5F5F5), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(nowContainer, 0, LV_PART_MAIN);
+        lv_obj_add_style(nowContainer, &ui_style_schedule_row, LV_PART_MAIN);
         lv_obj_set_flex_flow(nowContainer, LV_FLEX_FLOW_ROW);
         lv_obj_set_flex_align(nowContainer, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
         lv_obj_remove_flag(nowContainer, LV_OBJ_FLAG_SCROLLABLE);
@@ -267,8 +244,7 @@ void ui_Screen2_updateScheduleDisplay(void)
         snprintf(nowTimeStr, sizeof(nowTimeStr), "%02d:%02d", timeinfo->tm_hour, timeinfo->tm_min);
         lv_label_set_text(nowTimeLabel, nowTimeStr);
         lv_obj_set_width(nowTimeLabel, 80);
-        lv_obj_set_style_text_font(nowTimeLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-        lv_obj_set_style_text_color(nowTimeLabel, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+        lv_obj_add_style(nowTimeLabel, &ui_style_schedule_time, LV_PART_MAIN);
         
         // "Now" label
         lv_obj_t* nowLabelScroll = lv_obj_create(nowContainer);
@@ -276,14 +252,12 @@ void ui_Screen2_updateScheduleDisplay(void)
         lv_obj_set_height(nowLabelScroll, 70);
         lv_obj_set_scroll_dir(nowLabelScroll, LV_DIR_HOR);
         lv_obj_set_scrollbar_mode(nowLabelScroll, LV_SCROLLBAR_MODE_OFF);
-        lv_obj_set_style_bg_opa(nowLabelScroll, 0, LV_PART_MAIN);
-        lv_obj_set_style_border_side(nowLabelScroll, LV_BORDER_SIDE_NONE, LV_PART_MAIN);
+        lv_obj_add_style(nowLabelScroll, &ui_style_schedule_scroll, LV_PART_MAIN);
         lv_obj_remove_flag(nowLabelScroll, LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM);
         
         lv_obj_t* nowLabel = lv_label_create(nowLabelScroll);
         lv_label_set_text(nowLabel, "Now");
-        lv_obj_set_style_text_font(nowLabel, &lv_font_montserrat_28, LV_PART_MAIN);
-        lv_obj_set_style_text_color(nowLabel, lv_color_hex(0xFFD700), LV_PART_MAIN);
+        lv_obj_add_style(nowLabel, &ui_style_schedule_current, LV_PART_MAIN);
         lv_obj_set_align(nowLabel, LV_ALIGN_LEFT_MID);
         
         goldEventContainer = nowContainer;  // Track "Now" for scroll
@@ -308,8 +282,7 @@ void ui_Screen2_screen_init(void)
 {
 ui_Screen2 = lv_obj_create(NULL);
 lv_obj_remove_flag( ui_Screen2, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_SCROLL_ELASTIC | LV_OBJ_FLAG_SCROLL_MOMENTUM );
-lv_obj_set_style_bg_color(ui_Screen2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Screen2, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Screen2, &ui_style_bg_black, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 // Minimal setup - disabled most elements for debugging
 /*
@@ -332,18 +305,15 @@ lv_obj_remove_flag(ui_timer_arc3, LV_OBJ_FLAG_CLICKABLE);  // Make non-interacti
 lv_obj_add_flag(ui_timer_arc3, LV_OBJ_FLAG_IGNORE_LAYOUT);  // Don't interfere with layout
 
 // Background arc styling
-lv_obj_set_style_arc_color(ui_timer_arc3, lv_color_hex(0x304B59), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_arc_opa(ui_timer_arc3, 255, LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_arc_width(ui_timer_arc3, 30, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc3, &ui_style_timer_track, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 // Indicator arc styling (countdown)
 ui_object_set_themeable_style_property(ui_timer_arc3, LV_PART_INDICATOR | LV_STATE_DEFAULT, LV_STYLE_ARC_COLOR, _ui_theme_color_Baby_Blue);
 ui_object_set_themeable_style_property(ui_timer_arc3, LV_PART_INDICATOR | LV_STATE_DEFAULT, LV_STYLE_ARC_OPA, _ui_theme_alpha_Baby_Blue);
-lv_obj_set_style_arc_width(ui_timer_arc3, 30, LV_PART_INDICATOR | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc3, &ui_style_arc_width_30, LV_PART_INDICATOR | LV_STATE_DEFAULT);
 
 // Knob styling
-lv_obj_set_style_bg_color(ui_timer_arc3, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
-lv_obj_set_style_bg_opa(ui_timer_arc3, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_timer_arc3, &ui_style_bg_clear, LV_PART_KNOB | LV_STATE_DEFAULT);
 
 // Top panel
 ui_Panel7 = lv_obj_create(ui_Screen2);
@@ -356,8 +326,7 @@ lv_obj_remove_flag(ui_Panel7, LV_OBJ_FLAG_SCROLLABLE);
 lv_obj_set_style_radius(ui_Panel7, 30, LV_PART_MAIN | LV_STATE_DEFAULT);
 ui_object_set_themeable_style_property(ui_Panel7, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_BG_COLOR, _ui_theme_color_black);
 ui_object_set_themeable_style_property(ui_Panel7, LV_PART_MAIN | LV_STATE_DEFAULT, LV_STYLE_BG_OPA, _ui_theme_alpha_black);
-lv_obj_set_style_border_color(ui_Panel7, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_border_opa(ui_Panel7, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Panel7, &ui_style_border_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 // Hidden arc
 ui_Arc6 = lv_arc_create(ui_Screen2);
@@ -374,8 +343,7 @@ lv_obj_set_style_bg_color(ui_Arc6, lv_color_hex(0xFFFFFF), LV_PART_INDICATOR | L
 lv_obj_set_style_bg_opa(ui_Arc6, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
 lv_obj_set_style_arc_color(ui_Arc6, lv_color_hex(0x4040FF), LV_PART_INDICATOR | LV_STATE_DEFAULT);
 lv_obj_set_style_arc_opa(ui_Arc6, 0, LV_PART_INDICATOR | LV_STATE_DEFAULT);
-lv_obj_set_style_bg_color(ui_Arc6, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT);
-lv_obj_set_style_bg_opa(ui_Arc6, 0, LV_PART_KNOB | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Arc6, &ui_style_bg_clear, LV_PART_KNOB | LV_STATE_DEFAULT);
 
 
 // Right arrow image
@@ -399,16 +367,13 @@ lv_obj_set_y(ui_Button3, 0);
 lv_obj_set_align(ui_Button3, LV_ALIGN_CENTER);
 lv_obj_add_flag(ui_Button3, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
 lv_obj_remove_flag(ui_Button3, LV_OBJ_FLAG_SCROLLABLE);
-lv_obj_set_style_bg_color(ui_Button3, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_bg_opa(ui_Button3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_color(ui_Button3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_opa(ui_Button3, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Button3, &ui_style_button_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 // Schedule container (empty for now)
 ui_Container2 = lv_obj_create(ui_Screen2);
 lv_obj_remove_style_all(ui_Container2);
 lv_obj_set_width(ui_Container2, 380);
-lv_obj_set_height(ui_Container2, 480);  // Match arc height to extend top to bottom
+lv_obj_set_height(ui_Container2, 300);
 lv_obj_set_x(ui_Container2, 0);
 lv_obj_set_y(ui_Container2, 0);  // Center vertically to align with arc center
 lv_obj_set_align(ui_Container2, LV_ALIGN_CENTER);
@@ -417,8 +382,12 @@ lv_obj_set_flex_align(ui_Container2, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_START, L
 lv_obj_remove_flag(ui_Container2, LV_OBJ_FLAG_SCROLL_ON_FOCUS);  // Allow automatic scrolling
 lv_obj_set_scrollbar_mode(ui_Container2, LV_SCROLLBAR_MODE_OFF);  // No scrollbar
 lv_obj_set_scroll_dir(ui_Container2, LV_DIR_VER);
+lv_obj_set_scroll_snap_y(ui_Container2, LV_SCROLL_SNAP_CENTER);
 lv_obj_set_style_bg_opa(ui_Container2, 0, LV_PART_MAIN);  // Transparent background
 
+// Scroll event callback for transform effect (registered once; the rows are rebuilt)
+lv_obj_add_event_cb(ui_Container2, ui_Screen2_scroll_event_cb, LV_EVENT_SCROLL, NULL);
+
 // Bring arc to front so it overlaps the container
 lv_obj_move_foreground(ui_timer_arc3);
 
@@ -443,10 +412,7 @@ lv_obj_set_y(ui_Button4, 0);
 lv_obj_set_align(ui_Button4, LV_ALIGN_CENTER);
 lv_obj_add_flag(ui_Button4, LV_OBJ_FLAG_SCROLL_ON_FOCUS);
 lv_obj_remove_flag(ui_Button4, LV_OBJ_FLAG_SCROLLABLE);
-lv_obj_set_style_bg_color(ui_Button4, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_bg_opa(ui_Button4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_color(ui_Button4, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_opa(ui_Button4, 0, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Button4, &ui_style_button_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 // Bottom panel
 ui_Panel3 = lv_obj_create(ui_Screen2);
@@ -460,6 +426,9 @@ lv_obj_remove_flag(ui_Panel3, LV_OBJ_FLAG_SCROLLABLE);
 // Add event callbacks
 lv_obj_add_event_cb(ui_Button3, ui_event_Button4, LV_EVENT_ALL, NULL);
 lv_obj_add_event_cb(ui_Button4, ui_event_Button3, LV_EVENT_ALL, NULL);
+#if UI_DESTROY_ON_LEAVE
+lv_obj_add_event_cb(ui_Screen2, scr_unloaded_delete_cb, LV_EVENT_SCREEN_UNLOADED, ui_Screen2_screen_destroy);
+#endif
 
 }
 
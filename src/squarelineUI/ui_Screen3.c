@@ -38,13 +38,10 @@ void ui_Screen3_screen_init(void)
 {
 ui_Screen3 = lv_obj_create(NULL);
 lv_obj_remove_flag( ui_Screen3, LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_Screen3, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Screen3, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_bg_color(ui_Screen3, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_CHECKED );
-lv_obj_set_style_bg_opa(ui_Screen3, 255, LV_PART_MAIN| LV_STATE_CHECKED);
+lv_obj_add_style(ui_Screen3, &ui_style_bg_black, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Screen3, &ui_style_bg_white, LV_PART_MAIN | LV_STATE_CHECKED);
 
-lv_obj_set_style_bg_color(ui_Screen3, lv_color_hex(0xFFFFFF), LV_PART_SCROLLBAR | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Screen3, 255, LV_PART_SCROLLBAR| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Screen3, &ui_style_bg_white, LV_PART_SCROLLBAR | LV_STATE_DEFAULT);
 
 ui_Bar1 = lv_bar_create(ui_Screen3);
 lv_bar_set_value(ui_Bar1,25,LV_ANIM_OFF);
@@ -71,8 +68,7 @@ ui_object_set_themeable_style_property(ui_Arc2, LV_PART_MAIN| LV_STATE_DEFAULT,
 
 lv_obj_set_style_arc_width(ui_Arc2, 0, LV_PART_INDICATOR| LV_STATE_DEFAULT);
 
-lv_obj_set_style_bg_color(ui_Arc2, lv_color_hex(0xFFFFFF), LV_PART_KNOB | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Arc2, 0, LV_PART_KNOB| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Arc2, &ui_style_bg_clear, LV_PART_KNOB | LV_STATE_DEFAULT);
 
     /// Flags
 
@@ -83,9 +79,8 @@ lv_obj_set_x( ui_Label20, -190 );
 lv_obj_set_y( ui_Label20, 0 );
 lv_obj_set_align( ui_Label20, LV_ALIGN_CENTER );
 lv_label_set_text(ui_Label20,"<");
-lv_obj_set_style_text_color(ui_Label20, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_text_opa(ui_Label20, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_text_font(ui_Label20, &lv_font_montserrat_48, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Label20, &ui_style_text_white, LV_PART_MAIN | LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Label20, &ui_style_font_48, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Button5 = lv_button_create(ui_Screen3);
 lv_obj_set_width( ui_Button5, 80);
@@ -95,10 +90,7 @@ lv_obj_set_y( ui_Button5, 0 );
 lv_obj_set_align( ui_Button5, LV_ALIGN_CENTER );
 lv_obj_add_flag( ui_Button5, LV_OBJ_FLAG_SCROLL_ON_FOCUS );   /// Flags
 lv_obj_remove_flag( ui_Button5, LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_Button5, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Button5, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_shadow_color(ui_Button5, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_shadow_opa(ui_Button5, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Button5, &ui_style_button_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Container17 = lv_obj_create(ui_Screen3);
 lv_obj_remove_style_all(ui_Container17);
@@ -110,8 +102,7 @@ lv_obj_set_align( ui_Container17, LV_ALIGN_CENTER );
 lv_obj_add_flag( ui_Container17, LV_OBJ_FLAG_SCROLL_ON_FOCUS );   /// Flags
 lv_obj_set_scrollbar_mode(ui_Container17, LV_SCROLLBAR_MODE_OFF);
 lv_obj_remove_flag(ui_Container17, LV_OBJ_FLAG_SCROLLABLE); 
-lv_obj_set_style_bg_color(ui_Container17, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Container17, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Container17, &ui_style_bg_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 lv_obj_set_style_bg_color(ui_Container17, lv_color_hex(0xFFFFFF), LV_PART_SCROLLBAR | LV_STATE_DEFAULT );
 lv_obj_set_style_bg_opa(ui_Container17, 150, LV_PART_SCROLLBAR| LV_STATE_DEFAULT);
@@ -137,8 +128,7 @@ lv_obj_set_align( ui_Container10, LV_ALIGN_CENTER );
 lv_obj_set_flex_flow(ui_Container10,LV_FLEX_FLOW_COLUMN);
 lv_obj_set_flex_align(ui_Container10, LV_FLEX_ALIGN_SPACE_AROUND, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 lv_obj_remove_flag( ui_Container10, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_Container10, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Container10, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Container10, &ui_style_bg_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Label16 = lv_label_create(ui_Container10);
 lv_obj_set_width( ui_Label16, LV_SIZE_CONTENT);  /// 1
@@ -149,7 +139,7 @@ lv_obj_set_align( ui_Label16, LV_ALIGN_CENTER );
 lv_label_set_text(ui_Label16,"Screen\nBrightness");
 ui_object_set_themeable_style_property(ui_Label16, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR, _ui_theme_color_white);
 ui_object_set_themeable_style_property(ui_Label16, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA, _ui_theme_alpha_white);
-lv_obj_set_style_text_font(ui_Label16, &lv_font_montserrat_16, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Label16, &ui_style_font_16, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Label22 = lv_label_create(ui_Container10);
 lv_obj_set_width( ui_Label22, LV_SIZE_CONTENT);  /// 1
@@ -160,7 +150,7 @@ lv_obj_set_align( ui_Label22, LV_ALIGN_CENTER );
 lv_label_set_text(ui_Label22,"Alarm");
 ui_object_set_themeable_style_property(ui_Label22, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR, _ui_theme_color_white);
 ui_object_set_themeable_style_property(ui_Label22, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA, _ui_theme_alpha_white);
-lv_obj_set_style_text_font(ui_Label22, &lv_font_montserrat_16, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Label22, &ui_style_font_16, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Container11 = lv_obj_create(ui_Container12);
 lv_obj_remove_style_all(ui_Container11);
@@ -172,8 +162,7 @@ lv_obj_set_align( ui_Container11, LV_ALIGN_CENTER );
 lv_obj_set_flex_flow(ui_Container11,LV_FLEX_FLOW_COLUMN);
 lv_obj_set_flex_align(ui_Container11, LV_FLEX_ALIGN_SPACE_AROUND, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
 lv_obj_remove_flag( ui_Container11, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE );    /// Flags
-lv_obj_set_style_bg_color(ui_Container11, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_Container11, 0, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_Container11, &ui_style_bg_clear, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 ui_Slider1 = lv_slider_create(ui_Container11);
 lv_slider_set_value( ui_Slider1, 45, LV_ANIM_OFF);
@@ -231,17 +220,10 @@ lv_obj_set_height( ui_batteryBar2, 20);
 lv_obj_set_x( ui_batteryBar2, 78 );
 lv_obj_set_y( ui_batteryBar2, 63 );
 lv_obj_set_align( ui_batteryBar2, LV_ALIGN_CENTER );
-lv_obj_set_style_bg_color(ui_batteryBar2, lv_color_hex(0x000000), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_batteryBar2, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_border_color(ui_batteryBar2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_border_opa(ui_batteryBar2, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryBar2, &ui_style_battery_bar, LV_PART_MAIN | LV_STATE_DEFAULT);
 lv_obj_set_style_border_width(ui_batteryBar2, 1, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_border_side(ui_batteryBar2, LV_BORDER_SIDE_FULL, LV_PART_MAIN| LV_STATE_DEFAULT);
-lv_obj_set_style_outline_color(ui_batteryBar2, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_DEFAULT );
-lv_obj_set_style_outline_opa(ui_batteryBar2, 255, LV_PART_MAIN| LV_STATE_DEFAULT);
 
-lv_obj_set_style_bg_color(ui_batteryBar2, lv_color_hex(0x00FF00), LV_PART_INDICATOR | LV_STATE_DEFAULT );
-lv_obj_set_style_bg_opa(ui_batteryBar2, 255, LV_PART_INDICATOR| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryBar2, &ui_style_battery_fill, LV_PART_INDICATOR | LV_STATE_DEFAULT);
 
 //Compensating for LVGL9.1 draw crash with bar/slider max value when top-padding is nonzero and right-padding is 0
 if (lv_obj_get_style_pad_top(ui_batteryBar2,LV_PART_MAIN) > 0) lv_obj_set_style_pad_right( ui_batteryBar2, lv_obj_get_style_pad_right(ui_batteryBar2,LV_PART_MAIN) + 1, LV_PART_MAIN );
@@ -256,9 +238,12 @@ lv_obj_set_flex_align(ui_batteryPercent2, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_STA
 lv_label_set_text(ui_batteryPercent2,"75%");
 ui_object_set_themeable_style_property(ui_batteryPercent2, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_COLOR, _ui_theme_color_white);
 ui_object_set_themeable_style_property(ui_batteryPercent2, LV_PART_MAIN| LV_STATE_DEFAULT, LV_STYLE_TEXT_OPA, _ui_theme_alpha_white);
-lv_obj_set_style_text_font(ui_batteryPercent2, &lv_font_montserrat_20, LV_PART_MAIN| LV_STATE_DEFAULT);
+lv_obj_add_style(ui_batteryPercent2, &ui_style_font_20, LV_PART_MAIN | LV_STATE_DEFAULT);
 
 lv_obj_add_event_cb(ui_Button5, ui_event_Button5, LV_EVENT_ALL, NULL);
+#if UI_DESTROY_ON_LEAVE
+lv_obj_add_event_cb(ui_Screen3, scr_unloaded_delete_cb, LV_EVENT_SCREEN_UNLOADED, ui_Screen3_screen_destroy);
+#endif
 
 }
 
@@ -3,7 +3,9 @@
 // LVGL version: 9.1.0
 // Project name: SquareLine_Project
 
+#include "ui.h"
 #include "ui_helpers.h"
+#include "static_layer.h"
 
 void _ui_bar_set_property( lv_obj_t *target, int id, int val) 
 {
@@ -48,8 +50,10 @@ void _ui_slider_set_property( lv_obj_t *target, int id, int val)
 
 void _ui_screen_change( lv_obj_t ** target, lv_screen_load_anim_t fademode, int spd, int delay, void (*target_init)(void)) 
 {
-   if(*target == NULL)
+   if(*target == NULL) {
       target_init();
+      ui_screen_created(*target);
+   }
    lv_screen_load_anim(*target, fademode, spd, delay, false);
 }
 
@@ -259,6 +263,7 @@ void _ui_switch_theme(int val)
 {
 #ifdef UI_THEME_ACTIVE
     ui_theme_set(val);
+    static_layer_invalidate();
 #endif
 }
 
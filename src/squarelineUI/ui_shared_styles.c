@@ -0,0 +1,165 @@
+#include "ui_shared_styles.h"
+
+#define UI_WHITE    LV_COLOR_MAKE(0xFF, 0xFF, 0xFF)
+#define UI_BLACK    LV_COLOR_MAKE(0x00, 0x00, 0x00)
+#define UI_NAVY     LV_COLOR_MAKE(0x30, 0x4B, 0x59)
+#define UI_GOLD     LV_COLOR_MAKE(0xFF, 0xD7, 0x00)
+#define UI_GRAY     LV_COLOR_MAKE(0x80, 0x80, 0x80)
+
+// ============ BACKGROUNDS ============
+
+static const lv_style_const_prop_t bg_black_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_BLACK),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_bg_black, bg_black_props);
+
+static const lv_style_const_prop_t bg_white_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_WHITE),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_bg_white, bg_white_props);
+
+static const lv_style_const_prop_t bg_clear_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_WHITE),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_bg_clear, bg_clear_props);
+
+static const lv_style_const_prop_t border_clear_props[] = {
+    LV_STYLE_CONST_BORDER_COLOR(UI_BLACK),
+    LV_STYLE_CONST_BORDER_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_border_clear, border_clear_props);
+
+static const lv_style_const_prop_t button_clear_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_WHITE),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_SHADOW_COLOR(UI_BLACK),
+    LV_STYLE_CONST_SHADOW_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_button_clear, button_clear_props);
+
+// ============ TIMER RING ============
+
+static const lv_style_const_prop_t timer_track_props[] = {
+    LV_STYLE_CONST_ARC_COLOR(UI_NAVY),
+    LV_STYLE_CONST_ARC_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_ARC_WIDTH(30),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_timer_track, timer_track_props);
+
+static const lv_style_const_prop_t arc_width_30_props[] = {
+    LV_STYLE_CONST_ARC_WIDTH(30),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_arc_width_30, arc_width_30_props);
+
+// ============ TEXT ============
+
+static const lv_style_const_prop_t text_white_props[] = {
+    LV_STYLE_CONST_TEXT_COLOR(UI_WHITE),
+    LV_STYLE_CONST_TEXT_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_text_white, text_white_props);
+
+static const lv_style_const_prop_t font_16_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_16),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_font_16, font_16_props);
+
+static const lv_style_const_prop_t font_20_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_20),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_font_20, font_20_props);
+
+static const lv_style_const_prop_t font_32_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_32),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_font_32, font_32_props);
+
+static const lv_style_const_prop_t font_48_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_48),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_font_48, font_48_props);
+
+// ============ BATTERY ============
+
+static const lv_style_const_prop_t battery_bar_props[] = {
+    LV_STYLE_CONST_BG_COLOR(UI_BLACK),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_BORDER_COLOR(UI_WHITE),
+    LV_STYLE_CONST_BORDER_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_BORDER_SIDE(LV_BORDER_SIDE_FULL),
+    LV_STYLE_CONST_OUTLINE_COLOR(UI_WHITE),
+    LV_STYLE_CONST_OUTLINE_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_battery_bar, battery_bar_props);
+
+static const lv_style_const_prop_t battery_fill_props[] = {
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0x00, 0xFF, 0x00)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_COVER),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_battery_fill, battery_fill_props);
+
+// ============ SCHEDULE LIST ============
+
+static const lv_style_const_prop_t schedule_row_props[] = {
+    LV_STYLE_CONST_PAD_TOP(10),
+    LV_STYLE_CONST_PAD_BOTTOM(10),
+    LV_STYLE_CONST_PAD_LEFT(10),
+    LV_STYLE_CONST_PAD_RIGHT(10),
+    LV_STYLE_CONST_BORDER_SIDE(LV_BORDER_SIDE_BOTTOM),
+    LV_STYLE_CONST_BG_COLOR(LV_COLOR_MAKE(0xF5, 0xF5, 0xF5)),
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_row, schedule_row_props);
+
+static const lv_style_const_prop_t schedule_scroll_props[] = {
+    LV_STYLE_CONST_BG_OPA(LV_OPA_TRANSP),
+    LV_STYLE_CONST_BORDER_SIDE(LV_BORDER_SIDE_NONE),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_scroll, schedule_scroll_props);
+
+static const lv_style_const_prop_t schedule_time_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_28),
+    LV_STYLE_CONST_TEXT_COLOR(UI_WHITE),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_time, schedule_time_props);
+
+static const lv_style_const_prop_t schedule_current_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_28),
+    LV_STYLE_CONST_TEXT_COLOR(UI_GOLD),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_current, schedule_current_props);
+
+static const lv_style_const_prop_t schedule_past_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_28),
+    LV_STYLE_CONST_TEXT_COLOR(UI_GRAY),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_past, schedule_past_props);
+
+static const lv_style_const_prop_t schedule_future_props[] = {
+    LV_STYLE_CONST_TEXT_FONT(&lv_font_montserrat_28),
+    LV_STYLE_CONST_TEXT_COLOR(UI_WHITE),
+    LV_STYLE_CONST_PROPS_END
+};
+LV_STYLE_CONST_INIT(ui_style_schedule_future, schedule_future_props);
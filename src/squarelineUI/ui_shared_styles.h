@@ -0,0 +1,51 @@
+#ifndef _UI_SHARED_STYLES_H
+#define _UI_SHARED_STYLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl.h"
+
+/*
+ * Constant styles shared by the screens. They live in flash and are attached
+ * with lv_obj_add_style(), so repeated property sets cost one style reference
+ * per object instead of a local style allocated from the LVGL heap.
+ * Themeable properties still go through ui_object_set_themeable_style_property().
+ */
+
+// Backgrounds
+extern const lv_style_t ui_style_bg_black;       // Opaque black
+extern const lv_style_t ui_style_bg_white;       // Opaque white
+extern const lv_style_t ui_style_bg_clear;       // Transparent (containers, arc knobs)
+extern const lv_style_t ui_style_border_clear;   // Transparent border
+extern const lv_style_t ui_style_button_clear;   // Invisible touch area: no background or shadow
+
+// Timer ring
+extern const lv_style_t ui_style_timer_track;    // Navy 30 px arc track
+extern const lv_style_t ui_style_arc_width_30;
+
+// Text
+extern const lv_style_t ui_style_text_white;
+extern const lv_style_t ui_style_font_16;
+extern const lv_style_t ui_style_font_20;
+extern const lv_style_t ui_style_font_32;
+extern const lv_style_t ui_style_font_48;
+
+// Battery indicator
+extern const lv_style_t ui_style_battery_bar;    // Black bar with white border and outline
+extern const lv_style_t ui_style_battery_fill;
+
+// Schedule list (Screen2)
+extern const lv_style_t ui_style_schedule_row;
+extern const lv_style_t ui_style_schedule_scroll;
+extern const lv_style_t ui_style_schedule_time;
+extern const lv_style_t ui_style_schedule_current;
+extern const lv_style_t ui_style_schedule_past;
+extern const lv_style_t ui_style_schedule_future;
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif
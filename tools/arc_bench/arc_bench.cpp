@@ -0,0 +1,170 @@
+/**
+ * Host comparison of ring_mask with LVGL's stock arc renderer at the timer
+ * arc's geometry (r=240, w=30). Each case is drawn by lv_draw_arc into a
+ * transparent ARGB8888 canvas, and the canvas alpha is diffed against
+ * ring_mask_render's A8 output (same pixel grid, centre on the corner at
+ * (r, r)). Then both are timed: the stock draw against what ring_arc does
+ * per frame, a render plus an A8 recoloured image draw of the mask.
+ *
+ * Not run yet (no LVGL tree here), so ring_mask is not shown to match the
+ * stock arc until its output is recorded.
+ *
+ * Build liblvgl_host.a and set FLAGS as described in
+ * tools/blend_bench/blend_bench.cpp, then from the repository root:
+ *   g++ -std=c++17 $FLAGS tools/arc_bench/arc_bench.cpp src/helpers/ring_mask.cpp \
+ *       liblvgl_host.a -o arc_bench && ./arc_bench
+ */
+
+#include "lvgl.h"
+#include "ring_mask.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define RADIUS 240
+#define WIDTH 30
+#define SIZE (2 * RADIUS)
+#define DIFF_THRESHOLD 8         // Alpha steps a pixel may differ by before it is counted
+#define BENCH_REPS 50
+
+struct ArcCase {
+    int32_t start;               // Degrees, clockwise from +x
+    int32_t end;
+};
+
+static const ArcCase cases[] = {
+    {0, 90}, {30, 250}, {270, 45}, {0, 360}, {100, 101}, {180, 179},
+};
+
+static uint32_t canvasBuf[SIZE * SIZE];
+static uint8_t displayBuf[SIZE * 40 * 2];
+
+static void flush(lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+    (void)area;
+    (void)px;
+    lv_display_flush_ready(disp);
+}
+
+static double elapsedUs(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static void clearCanvas(lv_obj_t* canvas) {
+    lv_canvas_fill_bg(canvas, lv_color_black(), LV_OPA_TRANSP);
+}
+
+/**
+ * Stock arc into the canvas
+ * @return microseconds spent in the draw
+ */
+static double drawStock(lv_obj_t* canvas, const ArcCase& c, bool rounded) {
+    clearCanvas(canvas);
+    auto t0 = std::chrono::steady_clock::now();
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.color = lv_color_white();
+    dsc.opa = LV_OPA_COVER;
+    dsc.width = WIDTH;
+    dsc.radius = RADIUS;
+    dsc.center.x = RADIUS;
+    dsc.center.y = RADIUS;
+    dsc.start_angle = c.start;
+    dsc.end_angle = c.end;
+    dsc.rounded = rounded;
+    lv_draw_arc(&layer, &dsc);
+    lv_canvas_finish_layer(canvas, &layer);
+    return elapsedUs(t0);
+}
+
+/**
+ * ring_arc's per-frame work: render the mask, then draw it as a recoloured
+ * A8 image
+ * @return microseconds for both
+ */
+static double drawRing(lv_obj_t* canvas, RingMask* m, const lv_image_dsc_t* image, const ArcCase& c, bool rounded) {
+    clearCanvas(canvas);
+    auto t0 = std::chrono::steady_clock::now();
+    m->drawn_valid = false;
+    ring_mask_render(m, c.start * 100, c.end * 100, rounded);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = image;
+    img.recolor = lv_color_white();
+    img.recolor_opa = LV_OPA_COVER;
+    lv_area_t area = {0, 0, SIZE - 1, SIZE - 1};
+    lv_draw_image(&layer, &img, &area);
+    lv_canvas_finish_layer(canvas, &layer);
+    return elapsedUs(t0);
+}
+
+int main() {
+    lv_init();
+    lv_display_t* disp = lv_display_create(SIZE, SIZE);
+    lv_display_set_buffers(disp, displayBuf, NULL, sizeof(displayBuf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, flush);
+
+    lv_obj_t* canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, canvasBuf, SIZE, SIZE, LV_COLOR_FORMAT_ARGB8888);
+    uint32_t stride = lv_canvas_get_draw_buf(canvas)->header.stride;
+    const uint8_t* canvasBytes = (const uint8_t*)canvasBuf;
+
+    std::vector<uint32_t> maskBuf(ring_mask_buffer_size(RADIUS, WIDTH) / 4 + 1);
+    RingMask m;
+    auto t0 = std::chrono::steady_clock::now();
+    ring_mask_init(&m, RADIUS, WIDTH, maskBuf.data());
+    double initUs = elapsedUs(t0);
+
+    lv_image_dsc_t image;
+    lv_memzero(&image, sizeof(image));
+    image.header.magic = LV_IMAGE_HEADER_MAGIC;
+    image.header.cf = LV_COLOR_FORMAT_A8;
+    image.header.w = SIZE;
+    image.header.h = SIZE;
+    image.header.stride = SIZE;
+    image.data = m.alpha;
+    image.data_size = SIZE * SIZE;
+
+    printf("r=%d w=%d, ring_mask_init %.0f us, %u ring px\n\n", RADIUS, WIDTH, initUs, (unsigned)m.pixel_count);
+    printf("arc        caps   max diff  mean diff  px > %d   stock draw  ring render+draw\n", DIFF_THRESHOLD);
+
+    int worst = 0;
+    for (const ArcCase& c : cases) {
+        for (int rounded = 0; rounded < 2; rounded++) {
+            drawStock(canvas, c, rounded);
+            m.drawn_valid = false;
+            ring_mask_render(&m, c.start * 100, c.end * 100, rounded);
+
+            int maxDiff = 0;
+            long over = 0;
+            double sum = 0;
+            for (int y = 0; y < SIZE; y++) {
+                for (int x = 0; x < SIZE; x++) {
+                    int stockA = canvasBytes[y * stride + x * 4 + 3];
+                    int diff = abs(stockA - m.alpha[y * SIZE + x]);
+                    sum += diff;
+                    if (diff > maxDiff) maxDiff = diff;
+                    if (diff > DIFF_THRESHOLD) over++;
+                }
+            }
+            if (maxDiff > worst) worst = maxDiff;
+
+            double stockUs = 0, ringUs = 0;
+            for (int k = 0; k < BENCH_REPS; k++) {
+                stockUs += drawStock(canvas, c, rounded);
+                ringUs += drawRing(canvas, &m, &image, c, rounded);
+            }
+            printf("%3d..%-3d   %-5s  %8d  %9.3f  %7ld  %8.0f us  %12.0f us\n", (int)c.start, (int)c.end,
+                   rounded ? "round" : "flat", maxDiff, sum / (SIZE * SIZE), over, stockUs / BENCH_REPS,
+                   ringUs / BENCH_REPS);
+        }
+    }
+
+    printf("\nworst pixel differs by %d/255\n", worst);
+    return 0;
+}
@@ -0,0 +1,496 @@
+/**
+ * Host benchmark of the BLE protocol: a scripted phone drives ble_protocol.h
+ * over the simulated link in ble_loopback.h, with storage kept in memory.
+ * Reports time sync and config round trips, and file throughput across MTU,
+ * latency and loss, including a disconnect and resume and a retry after a
+ * failed verification, and how many device state notifications replace
+ * polling. Simulated time, so every run prints the same numbers.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Wall -Wextra -DBLE_PROTOCOL_QUIET -Iinclude tools/ble_bench/ble_bench.cpp \
+ *       tools/ble_bench/ble_loopback.cpp src/helpers/ble_protocol.cpp src/helpers/xfer_protocol.cpp \
+ *       src/helpers/crc32.cpp src/helpers/lz4_stream.cpp src/helpers/json_event_stream.cpp \
+ *       src/helpers/device_state.cpp -o ble_bench && ./ble_bench
+ */
+
+#include "ble_protocol.h"
+#include "ble_loopback.h"
+#include "crc32.h"
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define LOOP_MS 5                 // Device main loop period
+#define TIMEOUT_MS 600000
+
+// ============ DEVICE STORAGE ============
+
+struct Device {
+    std::vector<uint8_t> configPart;
+    std::vector<uint8_t> config;
+    uint64_t time;
+    XferHeader file;              // Transfer the part file belongs to
+    std::vector<uint8_t> filePart;
+    std::vector<uint8_t> fileDone;
+    bool corruptNext;             // Flip a bit in the next chunk stored, so verification fails
+};
+
+static Device dev;
+
+static bool configOpen(void* ctx, bool cbor) {
+    (void)ctx;
+    dev.configPart.clear();
+    return !cbor;                 // CBOR schedules are not exercised here
+}
+
+static bool configWrite(void* ctx, const uint8_t* data, size_t len) {
+    (void)ctx;
+    dev.configPart.insert(dev.configPart.end(), data, data + len);
+    return true;
+}
+
+static void configClose(void* ctx, bool keep) {
+    (void)ctx;
+    if (!keep) dev.configPart.clear();
+}
+
+static bool configCountCbor(void* ctx, size_t* events) {
+    (void)ctx;
+    (void)events;
+    return false;
+}
+
+static bool configCommit(void* ctx, bool cbor, uint32_t size, uint32_t crc) {
+    (void)ctx;
+    (void)cbor;
+    if (dev.configPart.size() != size || crc32_update(0, dev.configPart.data(), size) != crc) return false;
+    dev.config = dev.configPart;
+    return true;
+}
+
+static void timeSync(void* ctx, uint64_t unixTime) {
+    (void)ctx;
+    dev.time = unixTime;
+}
+
+static bool fileOpen(void* ctx, XferHeader* header, uint32_t* stored) {
+    (void)ctx;
+    bool resume = dev.file.id == header->id && dev.file.crc == header->crc &&
+                  strcmp(dev.file.name, header->name) == 0 && dev.file.chunk <= header->chunk;
+    if (resume) {
+        header->chunk = dev.file.chunk;
+    } else {
+        dev.filePart.clear();
+    }
+    dev.file = *header;
+    *stored = dev.filePart.size();
+    return true;
+}
+
+static bool fileWrite(void* ctx, const uint8_t* data, size_t len) {
+    (void)ctx;
+    dev.filePart.insert(dev.filePart.end(), data, data + len);
+    if (dev.corruptNext && len) {
+        dev.corruptNext = false;
+        dev.filePart.back() ^= 1;
+    }
+    return true;
+}
+
+static bool fileFinish(void* ctx) {
+    (void)ctx;
+    bool ok = dev.filePart.size() == dev.file.size &&
+              crc32_update(0, dev.filePart.data(), dev.filePart.size()) == dev.file.crc;
+    if (ok) dev.fileDone = dev.filePart;
+    dev.filePart.clear();
+    dev.file.id = 0;
+    return ok;
+}
+
+static void fileClose(void* ctx, XferEnd how) {
+    (void)ctx;
+    if (how == XFER_END_CANCELLED) {
+        dev.filePart.clear();
+        dev.file.id = 0;
+    }
+}
+
+static bool imageEntry(void* ctx, uint8_t seq, const uint8_t* hash, const char* name, bool* present) {
+    (void)ctx;
+    (void)seq;
+    (void)hash;
+    (void)name;
+    *present = false;
+    return true;
+}
+
+static bool imageCommit(void* ctx, uint8_t count, uint8_t* missing, uint8_t* removed) {
+    (void)ctx;
+    *missing = count;
+    *removed = 0;
+    return false;
+}
+
+static const BleProtocolOps storage = {
+    nullptr,
+    configOpen, configWrite, configClose, configCountCbor, configCommit,
+    timeSync,
+    fileOpen, fileWrite, fileFinish, fileClose,
+    imageEntry, imageCommit
+};
+
+// ============ SCRIPTED PHONE ============
+
+struct Phone {
+    BleLoopback link;
+    uint32_t now;
+    std::vector<std::string> statuses;
+    XferSender sender;
+    bool sending;
+    const std::vector<uint8_t>* file;
+    DeviceState state;            // Last device state notified
+    uint32_t stateAt;             // When it arrived
+    uint32_t stateNotifications;
+};
+
+static Phone phone;
+
+static void deviceRx(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    (void)ctx;
+    ble_protocol_write(channel, data, len);
+}
+
+static void phoneRx(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    (void)ctx;
+    if (channel == BLE_CHANNEL_DEVICE_STATE && device_state_decode(data, len, &phone.state)) {
+        phone.stateAt = phone.now;
+        phone.stateNotifications++;
+        return;
+    }
+    if (channel != BLE_CHANNEL_STATUS) return;
+    if (len > 0 && data[0] >= 0x80) {
+        if (phone.sending) xfer_sender_input(&phone.sender, data, len, phone.now);
+    } else {
+        phone.statuses.push_back(std::string((const char*)data, len));
+    }
+}
+
+static bool senderSend(void* ctx, const uint8_t* frame, size_t len) {
+    (void)ctx;
+    return ble_loopback_write(&phone.link, BLE_CHANNEL_FILE, frame, len);
+}
+
+static size_t senderRead(void* ctx, uint32_t offset, uint8_t* out, size_t len) {
+    (void)ctx;
+    memcpy(out, phone.file->data() + offset, len);
+    return len;
+}
+
+/**
+ * One millisecond: the link, then the device's main loop and the phone
+ */
+static void step() {
+    phone.now++;
+    ble_loopback_advance(&phone.link, phone.now);
+    if (phone.now % LOOP_MS == 0) {
+        ble_protocol_process_config();
+        ble_protocol_process_file(phone.now);
+    }
+    if (phone.sending) xfer_sender_poll(&phone.sender, phone.now);
+}
+
+static void connect(const BleLoopbackConfig& config) {
+    phone.now = 0;
+    phone.statuses.clear();
+    phone.sending = false;
+    phone.stateNotifications = 0;
+    dev = Device();
+    ble_loopback_init(&phone.link, &config, deviceRx, nullptr, phoneRx, nullptr);
+    ble_protocol_init(ble_loopback_transport(&phone.link), &storage);
+    ble_protocol_link(true);
+}
+
+/**
+ * Write with response: returns once the device has the write and the
+ * response is back
+ */
+static void writeAcked(BleChannel channel, const uint8_t* data, size_t len) {
+    while (!ble_loopback_write(&phone.link, channel, data, len)) step();
+    while (phone.link.to_device.count) step();
+    for (uint32_t i = 0; i < phone.link.config.interval_ms + phone.link.config.latency_ms; i++) step();
+}
+
+/**
+ * Run until a status starting with `prefix` arrives
+ * @return Milliseconds waited, or -1 on timeout
+ */
+static long waitStatus(const char* prefix, uint32_t start) {
+    size_t seen = 0;
+    while (phone.now - start < TIMEOUT_MS) {
+        for (; seen < phone.statuses.size(); seen++) {
+            if (phone.statuses[seen].compare(0, strlen(prefix), prefix) == 0) return phone.now - start;
+        }
+        step();
+    }
+    return -1;
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static std::string makeSchedule(int events) {
+    std::string json = "{\"events\":[";
+    for (int i = 0; i < events; i++) {
+        char event[128];
+        snprintf(event, sizeof(event), "%s{\"start\":%d,\"duration\":1800,\"label\":\"Event %d\",\"path\":\"/img%d.png\"}",
+                 i ? "," : "", 360 + i * 30, i, i % 8);
+        json += event;
+    }
+    return json + "]}";
+}
+
+static std::vector<uint8_t> makeFile(size_t size) {
+    std::vector<uint8_t> data(size);
+    uint32_t x = 12345;
+    for (size_t i = 0; i < size; i++) {
+        x = x * 1103515245 + 12345;
+        data[i] = (uint8_t)(x >> 16);
+    }
+    return data;
+}
+
+// ============ SCENARIOS ============
+
+static const BleLoopbackConfig BASE_LINK = {247, 15, 6, 0, 0, 1};
+
+static bool benchTimeSync() {
+    connect(BASE_LINK);
+    uint32_t start = phone.now;
+    const char text[] = "TIME:1760000000";
+    writeAcked(BLE_CHANNEL_TIME_SYNC, (const uint8_t*)text, sizeof(text) - 1);
+    long ms = waitStatus("3:Time synced", start);
+    printf("time sync                  %6ld ms\n", ms);
+    return ms >= 0 && dev.time == 1760000000ULL;
+}
+
+static bool benchJsonWrite() {
+    BleLoopbackConfig link = BASE_LINK;
+    link.mtu = 517;
+    connect(link);
+    std::string json = makeSchedule(4);
+    char trailer[24];
+    snprintf(trailer, sizeof(trailer), CONFIG_CRC_TRAILER "%08x", (unsigned)crc32_update(0, json.data(), json.size()));
+    std::string sent = json + trailer;
+
+    uint32_t start = phone.now;
+    writeAcked(BLE_CHANNEL_CONFIG, (const uint8_t*)sent.data(), sent.size());
+    long ms = waitStatus("3:Config saved", start);
+    printf("config, one write   %5u B %6ld ms\n", (unsigned)json.size(), ms);
+    return ms >= 0 && std::string(dev.config.begin(), dev.config.end()) == json;
+}
+
+static bool benchFramedConfig(int events) {
+    connect(BASE_LINK);
+    std::string json = makeSchedule(events);
+    uint32_t start = phone.now;
+
+    uint8_t frame[BLE_LOOPBACK_FRAME_MAX];
+    frame[0] = CONFIG_FRAME_BEGIN;
+    frame[1] = 0;
+    put32(frame + 2, json.size());
+    put32(frame + 6, crc32_update(0, json.data(), json.size()));
+    writeAcked(BLE_CHANNEL_CONFIG, frame, 10);
+
+    size_t payload = phone.link.config.mtu - 3 - 5;
+    for (size_t off = 0; off < json.size(); off += payload) {
+        size_t n = json.size() - off < payload ? json.size() - off : payload;
+        frame[0] = CONFIG_FRAME_DATA;
+        put32(frame + 1, off);
+        memcpy(frame + 5, json.data() + off, n);
+        writeAcked(BLE_CHANNEL_CONFIG, frame, 5 + n);
+    }
+    frame[0] = CONFIG_FRAME_COMMIT;
+    writeAcked(BLE_CHANNEL_CONFIG, frame, 1);
+
+    long ms = waitStatus("3:Config saved", start);
+    printf("config, framed     %6u B %6ld ms\n", (unsigned)json.size(), ms);
+    return ms >= 0 && std::string(dev.config.begin(), dev.config.end()) == json;
+}
+
+/**
+ * Send a file, optionally dropping the link once `drop_at` bytes have arrived
+ * and resuming with the same START
+ */
+static bool benchFile(const BleLoopbackConfig& link, size_t size, size_t drop_at) {
+    connect(link);
+    std::vector<uint8_t> data = makeFile(size);
+    phone.file = &data;
+
+    XferHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = 7;
+    header.size = size;
+    header.crc = crc32_update(0, data.data(), size);
+    header.chunk = BLE_PROTOCOL_FRAME_MAX - XFER_DATA_HEADER;
+    header.window = XFER_WINDOW_MAX;
+    strcpy(header.name, "bench.bin");
+
+    XferSenderOps ops = {nullptr, senderSend, senderRead};
+    uint32_t start = phone.now;
+    uint32_t frames = 0;
+    uint32_t retransmits = 0;
+    xfer_sender_start(&phone.sender, &ops, &header, phone.now);
+    phone.sending = true;
+
+    bool dropped = drop_at == 0;
+    while (!phone.sender.done && phone.now - start < TIMEOUT_MS) {
+        step();
+        if (!dropped && dev.filePart.size() >= drop_at) {
+            dropped = true;
+            frames += phone.sender.frames_sent;
+            retransmits += phone.sender.retransmits;
+            ble_loopback_set_connected(&phone.link, false);
+            ble_protocol_link(false);
+            for (int i = 0; i < 500; i++) step();
+            ble_loopback_set_connected(&phone.link, true);
+            ble_protocol_link(true);
+            xfer_sender_start(&phone.sender, &ops, &header, phone.now);
+        }
+    }
+    long ms = waitStatus("5:Complete", start);
+    phone.sending = false;
+    frames += phone.sender.frames_sent;
+    retransmits += phone.sender.retransmits;
+
+    uint32_t chunks = (size + phone.sender.header.chunk - 1) / phone.sender.header.chunk;
+    double kbps = ms > 0 ? size / 1024.0 / (ms / 1000.0) : 0;
+    printf("file %4u KB mtu %3u lat %3u ms loss %2u.%u%%%s %7ld ms %6.1f KB/s  %5u frames (%u chunks, %u resent, %u lost)\n",
+           (unsigned)(size / 1024), link.mtu, link.latency_ms, link.loss_permille / 10, link.loss_permille % 10,
+           drop_at ? " drop" : "     ", ms, kbps, frames, chunks, retransmits, phone.link.to_device.lost);
+    return ms >= 0 && dev.fileDone == data;
+}
+
+/**
+ * Store one chunk corrupted so the first attempt fails verification; the
+ * phone's retry with the same START must send the whole file again
+ */
+static bool benchFileRetry() {
+    connect(BASE_LINK);
+    std::vector<uint8_t> data = makeFile(64 * 1024);
+    phone.file = &data;
+
+    XferHeader header;
+    memset(&header, 0, sizeof(header));
+    header.id = 9;
+    header.size = data.size();
+    header.crc = crc32_update(0, data.data(), data.size());
+    header.chunk = BLE_PROTOCOL_FRAME_MAX - XFER_DATA_HEADER;
+    header.window = XFER_WINDOW_MAX;
+    strcpy(header.name, "retry.bin");
+
+    XferSenderOps ops = {nullptr, senderSend, senderRead};
+    uint32_t start = phone.now;
+    dev.corruptNext = true;
+    xfer_sender_start(&phone.sender, &ops, &header, phone.now);
+    phone.sending = true;
+    long failedMs = waitStatus("4:Verification failed", start);
+
+    uint32_t retry = phone.now;
+    xfer_sender_start(&phone.sender, &ops, &header, phone.now);
+    while (!phone.sender.ready && phone.now - retry < TIMEOUT_MS) step();
+    uint32_t resume = phone.sender.base;
+    long ms = waitStatus("5:Complete", retry);
+    phone.sending = false;
+
+    printf("file   64 KB, corrupted once: failed after %ld ms, retry resumed at chunk %u, %ld ms\n",
+           failedMs, resume, ms);
+    return failedMs >= 0 && resume == 0 && ms >= 0 && dev.fileDone == data;
+}
+
+/**
+ * Ten minutes of device state sampled every 250 ms: a countdown, an event
+ * ending, one battery step and a clock correction. The phone should hear
+ * about each change, not about each second.
+ */
+static bool benchDeviceState() {
+    connect(BASE_LINK);
+    const uint32_t duration = 10 * 60 * 1000;
+    uint32_t samples = 0;
+    uint32_t worstDrift = 0;
+    DeviceState state = {};
+
+    while (phone.now < duration) {
+        step();
+        if (phone.now % 250) continue;
+
+        // The phone counts down from the last record itself; compare with the previous sample
+        if (phone.stateNotifications && state.current_event == phone.state.current_event) {
+            uint32_t sampledAt = phone.now - 250;
+            uint32_t elapsed = sampledAt > phone.stateAt ? (sampledAt - phone.stateAt) / 1000 : 0;
+            uint32_t shown = phone.state.seconds_remaining > elapsed ? phone.state.seconds_remaining - elapsed : 0;
+            uint32_t drift = shown > state.seconds_remaining ? shown - state.seconds_remaining
+                                                             : state.seconds_remaining - shown;
+            if (drift > worstDrift) worstDrift = drift;
+        }
+
+        uint32_t s = phone.now / 1000;
+        state.flags = DEVICE_STATE_FLAG_TIME_VALID;
+        state.schedule_generation = 0x5eed;
+        state.battery = s < 400 ? 80 : 79;
+        if (s < 300) {
+            state.flags |= DEVICE_STATE_FLAG_EVENT_ACTIVE;
+            state.current_event = 2;
+            state.next_event = 3;
+            state.seconds_remaining = 300 - s;
+        } else {
+            state.current_event = DEVICE_STATE_NONE;
+            state.next_event = 3;
+            state.seconds_remaining = 900 - s - (s >= 500 ? 30 : 0);   // Clock corrected at 500 s
+        }
+        ble_protocol_device_state(&state, phone.now);
+        samples++;
+    }
+    for (int i = 0; i < 100; i++) step();
+
+    const DeviceState& last = phone.state;
+    bool current = last.flags == state.flags && last.current_event == state.current_event &&
+                   last.next_event == state.next_event && last.battery == state.battery &&
+                   last.schedule_generation == state.schedule_generation;
+    printf("device state  %5u samples %5u notifications, worst countdown error %u s (polling each second: %u reads)\n",
+           samples, phone.stateNotifications, worstDrift, duration / 1000);
+    return current && phone.stateNotifications == 4 && worstDrift <= DEVICE_STATE_DRIFT_S;
+}
+
+int main() {
+    bool ok = true;
+    ok &= benchTimeSync();
+    ok &= benchJsonWrite();
+    ok &= benchFramedConfig(16);
+    ok &= benchFramedConfig(200);
+    ok &= benchDeviceState();
+
+    static const uint16_t mtus[] = {185, 247, 517};
+    static const uint32_t latencies[] = {0, 50};
+    static const uint16_t losses[] = {0, 10, 50};
+    for (uint16_t mtu : mtus) {
+        for (uint32_t latency : latencies) {
+            for (uint16_t loss : losses) {
+                BleLoopbackConfig link = BASE_LINK;
+                link.mtu = mtu;
+                link.latency_ms = latency;
+                link.loss_permille = loss;
+                ok &= benchFile(link, 256 * 1024, 0);
+            }
+        }
+    }
+
+    BleLoopbackConfig link = BASE_LINK;
+    link.loss_permille = 10;
+    ok &= benchFile(link, 256 * 1024, 100 * 1024);
+    ok &= benchFileRetry();
+
+    printf("%s\n", ok ? "all scenarios passed" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,139 @@
+#include "ble_loopback.h"
+#include <string.h>
+
+/**
+ * xorshift32; deterministic for a given seed
+ */
+static uint32_t next_random(BleLoopback* lb) {
+    uint32_t x = lb->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    lb->rng = x;
+    return x;
+}
+
+/**
+ * Schedule a frame in the first interval with room, starting from now
+ * @param lossy Acknowledged writes are retried by the link layer and never lost
+ */
+static bool pipe_push(BleLoopback* lb, BleLoopbackPipe* p, BleChannel channel,
+                      const uint8_t* data, size_t len, bool lossy) {
+    const BleLoopbackConfig& c = lb->config;
+    if (!lb->connected || len == 0 || len > BLE_LOOPBACK_FRAME_MAX || len + 3 > c.mtu) return false;
+    if (p->count == BLE_LOOPBACK_PIPE_FRAMES) {
+        p->refused++;
+        return false;
+    }
+
+    uint32_t interval = c.interval_ms ? c.interval_ms : 1;
+    uint32_t slot = lb->now_ms - lb->now_ms % interval;
+    if (slot > p->slot_ms) {
+        p->slot_ms = slot;
+        p->slot_used = 0;
+    }
+    if (p->slot_used >= c.per_interval) {
+        p->slot_ms += interval;
+        p->slot_used = 0;
+    }
+    p->slot_used++;
+    p->sent++;
+    p->bytes += len;
+
+    if (lossy && c.loss_permille && next_random(lb) % 1000 < c.loss_permille) {
+        p->lost++;
+        return true;   // Sent, never arrives
+    }
+
+    BleLoopbackFrame* f = &p->frames[(p->head + p->count) % BLE_LOOPBACK_PIPE_FRAMES];
+    f->due_ms = p->slot_ms + interval + c.latency_ms;
+    f->channel = channel;
+    f->len = (uint16_t)len;
+    memcpy(f->data, data, len);
+    p->count++;
+    return true;
+}
+
+/**
+ * Deliver the oldest frame if it is due
+ */
+static bool pipe_deliver(BleLoopback* lb, BleLoopbackPipe* p, BleLoopbackRxFn rx, void* ctx) {
+    if (p->count == 0 || p->frames[p->head].due_ms > lb->now_ms) return false;
+    BleLoopbackFrame f = p->frames[p->head];
+    p->head = (p->head + 1) % BLE_LOOPBACK_PIPE_FRAMES;
+    p->count--;
+    if (rx) rx(ctx, f.channel, f.data, f.len);
+    return true;
+}
+
+static bool transport_notify(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    BleLoopback* lb = (BleLoopback*)ctx;
+    bool transferReply = len > 0 && data[0] >= 0x80;   // Binary frames; text statuses are below 0x80
+    return pipe_push(lb, &lb->to_phone, channel, data, len, transferReply);
+}
+
+static void transport_set_value(void* ctx, BleChannel channel, const uint8_t* data, size_t len) {
+    (void)ctx;
+    (void)channel;
+    (void)data;
+    (void)len;
+}
+
+static uint16_t transport_mtu(void* ctx) {
+    BleLoopback* lb = (BleLoopback*)ctx;
+    return lb->connected ? lb->config.mtu : 0;
+}
+
+void ble_loopback_init(BleLoopback* lb, const BleLoopbackConfig* config,
+                       BleLoopbackRxFn device_rx, void* device_ctx,
+                       BleLoopbackRxFn phone_rx, void* phone_ctx) {
+    memset(lb, 0, sizeof(*lb));
+    lb->config = *config;
+    if (lb->config.per_interval == 0) lb->config.per_interval = 1;
+    lb->device_rx = device_rx;
+    lb->device_ctx = device_ctx;
+    lb->phone_rx = phone_rx;
+    lb->phone_ctx = phone_ctx;
+    lb->rng = config->seed ? config->seed : 1;
+    lb->connected = true;
+    lb->transport.ctx = lb;
+    lb->transport.notify = transport_notify;
+    lb->transport.set_value = transport_set_value;
+    lb->transport.mtu = transport_mtu;
+}
+
+const BleTransport* ble_loopback_transport(BleLoopback* lb) {
+    return &lb->transport;
+}
+
+bool ble_loopback_write(BleLoopback* lb, BleChannel channel, const uint8_t* data, size_t len) {
+    return pipe_push(lb, &lb->to_device, channel, data, len, channel == BLE_CHANNEL_FILE);
+}
+
+void ble_loopback_set_connected(BleLoopback* lb, bool connected) {
+    lb->connected = connected;
+    if (!connected) {
+        lb->to_device.count = 0;
+        lb->to_phone.count = 0;
+    }
+}
+
+void ble_loopback_advance(BleLoopback* lb, uint32_t now_ms) {
+    lb->now_ms = now_ms;
+
+    // Deliveries can queue replies; keep going until nothing more is due
+    bool moved = true;
+    while (moved) {
+        moved = pipe_deliver(lb, &lb->to_device, lb->device_rx, lb->device_ctx);
+        moved |= pipe_deliver(lb, &lb->to_phone, lb->phone_rx, lb->phone_ctx);
+    }
+}
+
+uint32_t ble_loopback_next_due(const BleLoopback* lb) {
+    uint32_t due = UINT32_MAX;
+    if (lb->to_device.count) due = lb->to_device.frames[lb->to_device.head].due_ms;
+    if (lb->to_phone.count && lb->to_phone.frames[lb->to_phone.head].due_ms < due) {
+        due = lb->to_phone.frames[lb->to_phone.head].due_ms;
+    }
+    return due;
+}
@@ -0,0 +1,115 @@
+#ifndef BLE_LOOPBACK_H
+#define BLE_LOOPBACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ble_transport.h"
+
+/**
+ * Simulated BLE link between a scripted phone and ble_protocol.h, for host
+ * tests and benchmarks. Time is simulated: frames move when the caller
+ * advances the clock, so runs are repeatable.
+ *
+ * Each direction carries `per_interval` frames per connection interval and
+ * delivers them `latency_ms` later, in order. A full pipe refuses writes
+ * (the phone retries, as on a congested link). Loss applies only to the
+ * file transfer's frames: file-channel writes and binary notifications.
+ * Host only: it lives with the bench so it is not built into the firmware.
+ */
+
+#define BLE_LOOPBACK_PIPE_FRAMES 64      // Frames in flight per direction
+#define BLE_LOOPBACK_FRAME_MAX 512
+
+typedef struct {
+    uint16_t mtu;            // ATT MTU; a frame carries at most mtu - 3 bytes
+    uint32_t interval_ms;    // Connection interval
+    uint16_t per_interval;   // Frames per direction per interval
+    uint32_t latency_ms;     // Added one-way delay
+    uint16_t loss_permille;  // Chance that an unacknowledged frame is lost
+    uint32_t seed;
+} BleLoopbackConfig;
+
+/**
+ * Receives a delivered frame: a write at the device end, a notification at
+ * the phone end
+ */
+typedef void (*BleLoopbackRxFn)(void* ctx, BleChannel channel, const uint8_t* data, size_t len);
+
+typedef struct {
+    uint32_t due_ms;
+    BleChannel channel;
+    uint16_t len;
+    uint8_t data[BLE_LOOPBACK_FRAME_MAX];
+} BleLoopbackFrame;
+
+typedef struct {
+    BleLoopbackFrame frames[BLE_LOOPBACK_PIPE_FRAMES];
+    uint16_t head;
+    uint16_t count;
+    uint32_t slot_ms;        // Start of the interval frames are being scheduled in
+    uint16_t slot_used;
+
+    // Stats
+    uint32_t sent;
+    uint32_t bytes;
+    uint32_t lost;
+    uint32_t refused;        // Writes refused because the pipe was full
+} BleLoopbackPipe;
+
+typedef struct {
+    BleLoopbackConfig config;
+    BleLoopbackPipe to_device;
+    BleLoopbackPipe to_phone;
+    BleLoopbackRxFn device_rx;
+    void* device_ctx;
+    BleLoopbackRxFn phone_rx;
+    void* phone_ctx;
+    uint32_t now_ms;
+    uint32_t rng;
+    bool connected;
+    BleTransport transport;  // The device end
+} BleLoopback;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Set up a connected link at time 0
+ */
+void ble_loopback_init(BleLoopback* lb, const BleLoopbackConfig* config,
+                       BleLoopbackRxFn device_rx, void* device_ctx,
+                       BleLoopbackRxFn phone_rx, void* phone_ctx);
+
+/**
+ * Transport for ble_protocol_init(): notifications travel to the phone end
+ */
+const BleTransport* ble_loopback_transport(BleLoopback* lb);
+
+/**
+ * Phone writes to a characteristic
+ * @return false if the link is down or busy, or the frame exceeds the MTU
+ */
+bool ble_loopback_write(BleLoopback* lb, BleChannel channel, const uint8_t* data, size_t len);
+
+/**
+ * Drop or restore the link; frames in flight are lost when it drops
+ */
+void ble_loopback_set_connected(BleLoopback* lb, bool connected);
+
+/**
+ * Move the clock to now_ms, delivering every frame due by then
+ */
+void ble_loopback_advance(BleLoopback* lb, uint32_t now_ms);
+
+/**
+ * Time the next frame is due, or UINT32_MAX when none is in flight
+ */
+uint32_t ble_loopback_next_due(const BleLoopback* lb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLE_LOOPBACK_H */
@@ -0,0 +1,229 @@
+/**
+ * Host check and benchmark of blend_kernels against LVGL's own RGB565 blend
+ * loops (lv_draw_sw_blend_color_to_rgb565 / lv_draw_sw_blend_image_to_rgb565
+ * built with LV_DRAW_SW_ASM_NONE). The kernels are driven through the
+ * lv_blend_custom.h macros with LVGL's dispatch on opa and mask, so this
+ * covers what the device runs. Random sizes, strides, colours, opacities and
+ * masks must give the same destination buffer, padding included; then each
+ * of the eight cases is timed on a 480x40 band.
+ *
+ * Not run yet: it needs the LVGL tree, which PlatformIO fetches and this
+ * repository does not carry. Until its output is recorded, the kernels are
+ * unverified against LVGL.
+ *
+ * LVGL is the tree PlatformIO fetches (pio run), compiled once for the host
+ * with the stock loops. From the repository root:
+ *   LVGL=.pio/libdeps/esp32-s3-devkitm-1/lvgl
+ *   FLAGS="-O2 -DLV_CONF_INCLUDE_SIMPLE -DLV_USE_DRAW_SW_ASM=LV_DRAW_SW_ASM_NONE -Iinclude -I$LVGL"
+ *   mkdir -p lvgl_host && for c in $(find $LVGL/src -name '*.c'); do
+ *       o=lvgl_host/$(echo $c | tr / _).o; cc $FLAGS -c $c -o $o && ar rcs liblvgl_host.a $o || break; done
+ *   g++ -std=c++17 $FLAGS tools/blend_bench/blend_bench.cpp src/helpers/blend_kernels.cpp \
+ *       liblvgl_host.a -o blend_bench && ./blend_bench
+ */
+
+#include "lvgl.h"
+#include "lvgl_private.h"
+#include "src/draw/sw/blend/lv_draw_sw_blend_to_rgb565.h"
+#include "lv_blend_custom.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define CHECK_RUNS 4000
+#define BENCH_W 480
+#define BENCH_H 40
+#define BENCH_REPS 2000
+#define MAX_W 200
+#define MAX_H 40
+#define PAD 9                    // Extra pixels per row beyond the area, must stay untouched
+
+enum Variant { PLAIN, WITH_OPA, WITH_MASK, MASK_OPA, VARIANTS };
+static const char* variantNames[VARIANTS] = {"plain   ", "opa     ", "mask    ", "mask+opa"};
+
+/**
+ * What LVGL's dispatch does with LV_DRAW_SW_ASM_CUSTOM and lv_blend_custom.h
+ */
+static void customColor(lv_draw_sw_blend_fill_dsc_t* dsc) {
+    if (!dsc->mask_buf && dsc->opa >= LV_OPA_MAX) (void)LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc);
+    else if (!dsc->mask_buf) (void)LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_OPA(dsc);
+    else if (dsc->opa >= LV_OPA_MAX) (void)LV_DRAW_SW_COLOR_BLEND_TO_RGB565_WITH_MASK(dsc);
+    else (void)LV_DRAW_SW_COLOR_BLEND_TO_RGB565_MIX_MASK_OPA(dsc);
+}
+
+static void customImage(lv_draw_sw_blend_image_dsc_t* dsc) {
+    if (!dsc->mask_buf && dsc->opa >= LV_OPA_MAX) (void)LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc);
+    else if (!dsc->mask_buf) (void)LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_OPA(dsc);
+    else if (dsc->opa >= LV_OPA_MAX) (void)LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_WITH_MASK(dsc);
+    else (void)LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565_MIX_MASK_OPA(dsc);
+}
+
+// ============ INPUTS ============
+
+static void randomFill(std::vector<uint16_t>& buf) {
+    for (uint16_t& p : buf) p = (uint16_t)rand();
+}
+
+/**
+ * Mask like a glyph or arc edge: runs fully in or out with antialiased
+ * pixels between them
+ */
+static void edgeMask(std::vector<uint8_t>& mask) {
+    size_t i = 0;
+    bool in = rand() & 1;
+    while (i < mask.size()) {
+        size_t run = 1 + rand() % 24;
+        for (; run && i < mask.size(); run--) mask[i++] = in ? 255 : 0;
+        for (int aa = rand() % 3; aa && i < mask.size(); aa--) mask[i++] = (uint8_t)(1 + rand() % 254);
+        in = !in;
+    }
+}
+
+static lv_opa_t opaFor(Variant v) {
+    static const lv_opa_t edges[] = {3, 127, 128, 252, 253, 254, 255};
+    if (v == PLAIN || v == WITH_MASK) return LV_OPA_COVER;
+    return rand() % 4 ? (lv_opa_t)(3 + rand() % 250) : edges[rand() % 7];
+}
+
+static lv_color_t randomColor() {
+    return lv_color_make((uint8_t)rand(), (uint8_t)rand(), (uint8_t)rand());
+}
+
+static void setupFill(lv_draw_sw_blend_fill_dsc_t* d, uint16_t* dest, int w, int h, int destStride,
+                      lv_color_t color, lv_opa_t opa, const uint8_t* mask, int maskStride) {
+    memset(d, 0, sizeof(*d));
+    d->dest_buf = dest;
+    d->dest_w = w;
+    d->dest_h = h;
+    d->dest_stride = destStride * 2;
+    d->color = color;
+    d->opa = opa;
+    d->mask_buf = mask;
+    d->mask_stride = maskStride;
+    lv_area_set(&d->relative_area, 0, 0, w - 1, h - 1);
+}
+
+static void setupImage(lv_draw_sw_blend_image_dsc_t* d, uint16_t* dest, int w, int h, int destStride,
+                       const uint16_t* src, int srcStride, lv_opa_t opa, const uint8_t* mask, int maskStride) {
+    memset(d, 0, sizeof(*d));
+    d->dest_buf = dest;
+    d->dest_w = w;
+    d->dest_h = h;
+    d->dest_stride = destStride * 2;
+    d->src_buf = src;
+    d->src_stride = srcStride * 2;
+    d->src_color_format = LV_COLOR_FORMAT_RGB565;
+    d->opa = opa;
+    d->blend_mode = LV_BLEND_MODE_NORMAL;
+    d->mask_buf = mask;
+    d->mask_stride = maskStride;
+    lv_area_set(&d->relative_area, 0, 0, w - 1, h - 1);
+    lv_area_set(&d->src_area, 0, 0, w - 1, h - 1);
+}
+
+// ============ CHECK ============
+
+/**
+ * One random case of a variant, stock and custom on copies of the same
+ * destination
+ * @return false (after printing the first differing pixel) on a mismatch
+ */
+static bool checkOne(bool image, Variant v) {
+    int w = 1 + rand() % MAX_W, h = 1 + rand() % MAX_H;
+    int destStride = w + rand() % PAD, srcStride = w + rand() % PAD, maskStride = w + rand() % PAD;
+    lv_opa_t opa = opaFor(v);
+    lv_color_t color = randomColor();
+
+    std::vector<uint16_t> stock((size_t)destStride * h), custom, src((size_t)srcStride * h);
+    std::vector<uint8_t> mask((size_t)maskStride * h);
+    randomFill(stock);
+    randomFill(src);
+    edgeMask(mask);
+    custom = stock;
+    const uint8_t* m = (v == WITH_MASK || v == MASK_OPA) ? mask.data() : NULL;
+
+    if (image) {
+        lv_draw_sw_blend_image_dsc_t d;
+        setupImage(&d, stock.data(), w, h, destStride, src.data(), srcStride, opa, m, maskStride);
+        lv_draw_sw_blend_image_to_rgb565(&d);
+        setupImage(&d, custom.data(), w, h, destStride, src.data(), srcStride, opa, m, maskStride);
+        customImage(&d);
+    } else {
+        lv_draw_sw_blend_fill_dsc_t d;
+        setupFill(&d, stock.data(), w, h, destStride, color, opa, m, maskStride);
+        lv_draw_sw_blend_color_to_rgb565(&d);
+        setupFill(&d, custom.data(), w, h, destStride, color, opa, m, maskStride);
+        customColor(&d);
+    }
+
+    for (size_t i = 0; i < stock.size(); i++) {
+        if (stock[i] == custom[i]) continue;
+        int x = (int)(i % destStride), y = (int)(i / destStride);
+        printf("  %s %s: %dx%d opa %u, first diff at (%d, %d)%s: stock 0x%04x custom 0x%04x\n",
+               image ? "image" : "fill ", variantNames[v], w, h, opa, x, y, x >= w ? " (padding)" : "",
+               stock[i], custom[i]);
+        return false;
+    }
+    return true;
+}
+
+// ============ TIMING ============
+
+template <typename Fn>
+static double timeCalls(Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < BENCH_REPS; k++) fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / BENCH_REPS;
+}
+
+static void bench(bool image, Variant v) {
+    std::vector<uint16_t> dest(BENCH_W * BENCH_H), src(BENCH_W * BENCH_H);
+    std::vector<uint8_t> mask(BENCH_W * BENCH_H);
+    randomFill(dest);
+    randomFill(src);
+    edgeMask(mask);
+    lv_opa_t opa = (v == WITH_OPA || v == MASK_OPA) ? 128 : LV_OPA_COVER;
+    const uint8_t* m = (v == WITH_MASK || v == MASK_OPA) ? mask.data() : NULL;
+    lv_color_t color = lv_color_make(0x20, 0x90, 0xE0);
+
+    double stock, custom;
+    if (image) {
+        lv_draw_sw_blend_image_dsc_t d;
+        setupImage(&d, dest.data(), BENCH_W, BENCH_H, BENCH_W, src.data(), BENCH_W, opa, m, BENCH_W);
+        stock = timeCalls([&] { lv_draw_sw_blend_image_to_rgb565(&d); });
+        custom = timeCalls([&] { customImage(&d); });
+    } else {
+        lv_draw_sw_blend_fill_dsc_t d;
+        setupFill(&d, dest.data(), BENCH_W, BENCH_H, BENCH_W, color, opa, m, BENCH_W);
+        stock = timeCalls([&] { lv_draw_sw_blend_color_to_rgb565(&d); });
+        custom = timeCalls([&] { customColor(&d); });
+    }
+    printf("%s %s  %8.2f us %8.2f us  %5.2fx\n", image ? "image" : "fill ", variantNames[v], stock, custom,
+           stock / custom);
+}
+
+int main() {
+    lv_init();
+    srand(1);
+
+    int failures = 0;
+    for (int image = 0; image < 2; image++) {
+        for (int v = 0; v < VARIANTS; v++) {
+            int bad = 0;
+            for (int i = 0; i < CHECK_RUNS; i++) {
+                if (!checkOne(image, (Variant)v) && ++bad >= 3) break;
+            }
+            printf("%s %s  %s\n", image ? "image" : "fill ", variantNames[v], bad ? "DIFF" : "identical");
+            failures += bad;
+        }
+    }
+
+    printf("\n%dx%d band      LVGL     kernels  speedup\n", BENCH_W, BENCH_H);
+    for (int image = 0; image < 2; image++) {
+        for (int v = 0; v < VARIANTS; v++) bench(image, (Variant)v);
+    }
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
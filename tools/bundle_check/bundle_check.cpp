@@ -0,0 +1,187 @@
+/**
+ * Host check of asset_bundle_mount: a generated bundle must mount and find
+ * every asset, and each kind of malformed bundle (bad header, broken index,
+ * unterminated or duplicate names, unaligned, out-of-range or overlapping
+ * assets, asset bytes that do not match their CRC, failing reads) must be
+ * rejected with nothing left mounted. Then random damage to the header and
+ * index, with the index CRC recomputed so it gets past that check: any
+ * bundle that still mounts must only hold disjoint, in-range assets whose
+ * bytes match their CRCs.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/bundle_check/bundle_check.cpp src/helpers/asset_bundle.cpp \
+ *       src/helpers/crc32.cpp -o bundle_check && ./bundle_check
+ */
+
+#include "asset_bundle.h"
+#include "crc32.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <functional>
+#include <vector>
+
+#define ASSETS 5
+#define FUZZ_RUNS 5000
+
+typedef std::vector<uint8_t> Bytes;
+
+struct MemFile {
+    const Bytes* data;
+    uint32_t failAt;             // Reads touching this offset fail (UINT32_MAX: none)
+};
+
+static int32_t memReadAt(void* ctx, uint32_t offset, uint8_t* buf, uint32_t len) {
+    MemFile* f = (MemFile*)ctx;
+    if (offset >= f->data->size()) return 0;
+    if (f->failAt >= offset && f->failAt < offset + len) return -1;
+    uint32_t n = f->data->size() - offset < len ? f->data->size() - offset : len;
+    memcpy(buf, f->data->data() + offset, n);
+    return (int32_t)n;
+}
+
+static AssetBundleHeader* headerOf(Bytes& b) {
+    return (AssetBundleHeader*)b.data();
+}
+
+static AssetBundleEntry* entryOf(Bytes& b, int i) {
+    return (AssetBundleEntry*)(b.data() + sizeof(AssetBundleHeader)) + i;
+}
+
+static void sealIndex(Bytes& b) {
+    AssetBundleHeader* h = headerOf(b);
+    h->index_crc = crc32_update(0, entryOf(b, 0), h->count * sizeof(AssetBundleEntry));
+}
+
+/**
+ * ASSETS assets of varying size, each at the next aligned offset
+ */
+static Bytes makeBundle() {
+    uint32_t indexEnd = sizeof(AssetBundleHeader) + ASSETS * sizeof(AssetBundleEntry);
+    Bytes b(indexEnd);
+    AssetBundleHeader h = {ASSET_BUNDLE_MAGIC, ASSET_BUNDLE_VERSION, ASSETS, 0, 0};
+    memcpy(b.data(), &h, sizeof(h));
+    for (int i = 0; i < ASSETS; i++) {
+        b.resize((b.size() + ASSET_BUNDLE_ALIGN - 1) / ASSET_BUNDLE_ALIGN * ASSET_BUNDLE_ALIGN, 0);
+        AssetBundleEntry e = {};
+        snprintf(e.name, sizeof(e.name), "image%d.bin", i);
+        e.offset = b.size();
+        e.size = 300 + i * 1500;  // Under, across and over one verify chunk
+        for (uint32_t k = 0; k < e.size; k++) b.push_back((uint8_t)(k * 7 + i));
+        e.crc = crc32_update(0, &b[e.offset], e.size);
+        memcpy(entryOf(b, i), &e, sizeof(e));
+    }
+    sealIndex(b);
+    return b;
+}
+
+static bool mount(const Bytes& b, bool verify, uint32_t failAt = UINT32_MAX) {
+    MemFile f = {&b, failAt};
+    return asset_bundle_mount(memReadAt, &f, b.size(), "/lvgl_images/assets.crkb", verify);
+}
+
+/**
+ * Everything mounted is a disjoint range of the file holding the bytes its CRC names
+ */
+static bool mountedIsSound(const Bytes& b) {
+    const AssetBundleHeader* h = (const AssetBundleHeader*)b.data();
+    const AssetBundleEntry* entries = (const AssetBundleEntry*)(b.data() + sizeof(AssetBundleHeader));
+    std::vector<uint8_t> owner(b.size(), 0);
+    for (int i = 0; i < h->count; i++) {
+        const AssetBundleEntry* e = asset_bundle_find(entries[i].name);
+        if (!e || e->offset > b.size() || e->size > b.size() - e->offset) return false;
+        if (crc32_update(0, &b[e->offset], e->size) != e->crc) return false;
+        for (uint32_t k = e->offset; k < e->offset + e->size; k++) {
+            if (owner[k]++) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int failures = 0;
+    const Bytes good = makeBundle();
+    uint32_t indexEnd = sizeof(AssetBundleHeader) + ASSETS * sizeof(AssetBundleEntry);
+
+    bool ok = mount(good, true) && asset_bundle_lookup("/bundle/image3.bin") == asset_bundle_find("image3.bin") &&
+              asset_bundle_find("image3.bin") && !asset_bundle_find("image9.bin") && mountedIsSound(good);
+    printf("%-36s %s\n", "valid bundle", ok ? "mounted" : "FAILED");
+    if (!ok) failures++;
+
+    struct Case {
+        const char* name;
+        std::function<void(Bytes&)> damage;
+        bool sealed;                 // Recompute the index CRC after the damage
+        uint32_t failAt;
+    };
+    const Case cases[] = {
+        {"bad magic", [](Bytes& b) { headerOf(b)->magic ^= 1; }, false, UINT32_MAX},
+        {"unknown version", [](Bytes& b) { headerOf(b)->version = 2; }, false, UINT32_MAX},
+        {"too many entries", [](Bytes& b) { headerOf(b)->count = ASSET_BUNDLE_MAX_ENTRIES + 1; }, false, UINT32_MAX},
+        {"shorter than the header", [](Bytes& b) { b.resize(sizeof(AssetBundleHeader) - 1); }, false, UINT32_MAX},
+        {"index past the end", [indexEnd](Bytes& b) { b.resize(indexEnd - 1); }, false, UINT32_MAX},
+        {"index CRC mismatch", [](Bytes& b) { entryOf(b, 2)->size ^= 1; }, false, UINT32_MAX},
+        {"unterminated name", [](Bytes& b) { memset(entryOf(b, 1)->name, 'x', ASSET_BUNDLE_NAME_LEN); }, true,
+         UINT32_MAX},
+        {"empty name", [](Bytes& b) { entryOf(b, 1)->name[0] = '\0'; }, true, UINT32_MAX},
+        {"duplicate name", [](Bytes& b) { strcpy(entryOf(b, 4)->name, entryOf(b, 0)->name); }, true, UINT32_MAX},
+        {"unaligned offset", [](Bytes& b) { entryOf(b, 3)->offset += 4; }, true, UINT32_MAX},
+        {"offset inside the index", [](Bytes& b) { entryOf(b, 0)->offset = 0; }, true, UINT32_MAX},
+        {"offset past the end", [](Bytes& b) { entryOf(b, 4)->offset = (b.size() / 512 + 1) * 512; }, true,
+         UINT32_MAX},
+        {"size past the end", [](Bytes& b) { entryOf(b, 4)->size += 1; }, true, UINT32_MAX},
+        {"size wrapping 32 bits", [](Bytes& b) { entryOf(b, 4)->size = UINT32_MAX - 100; }, true, UINT32_MAX},
+        {"overlaps the next asset", [](Bytes& b) {
+             entryOf(b, 1)->size = entryOf(b, 2)->offset - entryOf(b, 1)->offset + 1;
+         }, true, UINT32_MAX},
+        {"same range as another", [](Bytes& b) { entryOf(b, 3)->offset = entryOf(b, 2)->offset; }, true, UINT32_MAX},
+        {"inside another", [](Bytes& b) {
+             entryOf(b, 0)->offset = entryOf(b, 4)->offset + ASSET_BUNDLE_ALIGN;
+             entryOf(b, 0)->size = 10;
+         }, true, UINT32_MAX},
+        {"asset byte flipped", [](Bytes& b) { b[entryOf(b, 2)->offset + 1234] ^= 0x10; }, false, UINT32_MAX},
+        {"asset CRC wrong", [](Bytes& b) { entryOf(b, 0)->crc ^= 0x80000000u; }, true, UINT32_MAX},
+        {"read error in the index", [](Bytes&) {}, false, sizeof(AssetBundleHeader) + 50},
+        {"read error in an asset", [](Bytes&) {}, false, 0},  // failAt set below
+    };
+
+    for (const Case& c : cases) {
+        Bytes b = good;
+        c.damage(b);
+        if (c.sealed) sealIndex(b);
+        uint32_t failAt = strcmp(c.name, "read error in an asset") == 0 ? entryOf(b, 4)->offset + 4000 : c.failAt;
+        bool mounted = mount(b, true, failAt);
+        bool rejected = !mounted && !asset_bundle_path() && !asset_bundle_find("image0.bin");
+        printf("%-36s %s\n", c.name, rejected ? "rejected" : "MOUNTED");
+        if (!rejected) failures++;
+    }
+
+    // Without verify_assets (boot), only the asset bytes go unchecked
+    Bytes flipped = good;
+    flipped[entryOf(flipped, 2)->offset + 1234] ^= 0x10;
+    ok = mount(flipped, false);
+    printf("%-36s %s\n", "asset byte flipped, not verified", ok ? "mounted" : "FAILED");
+    if (!ok) failures++;
+
+    // Random damage to the header and index, resealed so it reaches the entry checks
+    srand(1);
+    int mounted = 0, unsound = 0;
+    for (int i = 0; i < FUZZ_RUNS; i++) {
+        Bytes b = good;
+        for (int n = 1 + rand() % 4; n; n--) {
+            size_t at = rand() % indexEnd;
+            b[at] = rand() % 3 ? (uint8_t)(b[at] ^ (1 << (rand() % 8))) : (uint8_t)rand();
+        }
+        if (headerOf(b)->count <= ASSETS) sealIndex(b);
+        if (mount(b, true)) {
+            mounted++;
+            if (!mountedIsSound(b)) unsound++;
+        }
+    }
+    printf("\nrandom index damage: %d of %d still mounted, %d of them unsound\n", mounted, FUZZ_RUNS, unsound);
+    failures += unsound;
+
+    asset_bundle_unmount();
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,257 @@
+/**
+ * Host check of image_cache. Scripted cases cover least-recently-used
+ * eviction order, pinned entries surviving eviction, the entry limit, and
+ * a new generation of a path (or image_cache_invalidate) hiding the old one
+ * at once while freeing its bytes only when its last pin is released. Then
+ * random sequences of lookups, inserts, releases, discards, invalidations,
+ * clears and budget changes are run against a plain reference model: every
+ * hit, miss, returned buffer, eviction and byte count must agree.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/cache_check/cache_check.cpp src/helpers/image_cache.cpp \
+ *       -o cache_check && ./cache_check
+ */
+
+#include "image_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define BUDGET 100000
+#define RANDOM_RUNS 200
+#define RANDOM_OPS 2000
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what) {
+    printf("  %-58s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+}
+
+static bool cached(const char* path, uint32_t generation) {
+    void* p = image_cache_lookup(path, generation, NULL);
+    if (p) image_cache_release(p);
+    return p != NULL;
+}
+
+static ImageCacheStats stats() {
+    ImageCacheStats s;
+    image_cache_get_stats(&s);
+    return s;
+}
+
+static void scripted() {
+    printf("eviction order\n");
+    image_cache_init(BUDGET);
+    image_cache_release(image_cache_insert("a", 1, 30000));
+    image_cache_release(image_cache_insert("b", 1, 30000));
+    image_cache_release(image_cache_insert("c", 1, 30000));
+    cached("a", 1);                                      // a is now the most recent
+    image_cache_release(image_cache_insert("d", 1, 30000));
+    expect(!cached("b", 1) && cached("a", 1) && cached("c", 1) && cached("d", 1),
+           "least recently used (b) evicted, touched a kept");
+    image_cache_release(image_cache_insert("e", 1, 60000));
+    expect(!cached("a", 1) && !cached("c", 1) && cached("d", 1) && cached("e", 1),
+           "a and c evicted (oldest first) to fit a double-size entry");
+    expect(stats().evictions == 3 && stats().bytes_used == 90000, "3 evictions, 90000 bytes in use");
+
+    printf("pinned entries\n");
+    image_cache_init(BUDGET);
+    void* a = image_cache_insert("a", 1, 50000);
+    image_cache_release(image_cache_insert("b", 1, 40000));
+    image_cache_release(image_cache_insert("c", 1, 40000));
+    expect(cached("a", 1) && !cached("b", 1) && cached("c", 1), "pinned a survives; b evicted instead");
+    expect(image_cache_insert("d", 1, 60000) == NULL && cached("a", 1), "no room past a pinned entry: insert fails");
+    image_cache_release(a);
+    void* d = image_cache_insert("d", 1, 60000);
+    expect(d && !cached("a", 1), "once released, a can be evicted");
+    image_cache_release(d);
+
+    printf("entry limit\n");
+    image_cache_init(BUDGET);
+    char name[8];
+    for (int i = 0; i <= IMAGE_CACHE_MAX_ENTRIES; i++) {
+        snprintf(name, sizeof(name), "n%d", i);
+        image_cache_release(image_cache_insert(name, 1, 100));
+    }
+    snprintf(name, sizeof(name), "n%d", IMAGE_CACHE_MAX_ENTRIES);
+    expect(stats().entries == IMAGE_CACHE_MAX_ENTRIES && !cached("n0", 1) && cached("n1", 1) && cached(name, 1),
+           "entry past the limit evicts the oldest");
+
+    printf("generations\n");
+    image_cache_init(BUDGET);
+    image_cache_release(image_cache_insert("img", 1, 20000));
+    expect(!cached("img", 2) && cached("img", 1), "lookup of another generation misses");
+    image_cache_release(image_cache_insert("img", 2, 25000));
+    expect(!cached("img", 1) && cached("img", 2) && stats().bytes_used == 25000,
+           "new generation drops the old one and its bytes");
+    void* old = image_cache_lookup("img", 2, NULL);
+    void* fresh = image_cache_insert("img", 3, 30000);
+    expect(fresh && !cached("img", 2) && cached("img", 3) && stats().bytes_used == 55000,
+           "pinned old generation hidden at once, bytes held");
+    image_cache_release(old);
+    expect(stats().bytes_used == 30000 && stats().entries == 1, "its bytes freed on the last release");
+    image_cache_release(fresh);
+
+    printf("invalidate and discard\n");
+    void* held = image_cache_lookup("img", 3, NULL);
+    image_cache_invalidate("img");
+    expect(!cached("img", 3) && stats().bytes_used == 30000, "invalidated while pinned: hidden, bytes held");
+    image_cache_release(held);
+    expect(stats().bytes_used == 0 && stats().entries == 0, "freed on release");
+    void* failed = image_cache_insert("x", 1, 1000);
+    image_cache_discard(failed);
+    expect(!cached("x", 1) && stats().entries == 0, "discarded insert is gone");
+}
+
+// ============ REFERENCE MODEL ============
+
+struct ModelEntry {
+    std::string path;
+    uint32_t generation;
+    size_t size;
+    void* data;                  // Buffer the cache returned for it
+    int pins;
+    bool stale;
+};
+
+/**
+ * The cache as a list in use order (front = least recently used)
+ */
+struct Model {
+    std::vector<ModelEntry> list;
+    size_t budget = BUDGET;
+    uint32_t evictions = 0;
+
+    size_t bytes() const {
+        size_t n = 0;
+        for (const ModelEntry& e : list) n += e.size;
+        return n;
+    }
+
+    bool evictOne() {
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i].pins == 0) {
+                list.erase(list.begin() + i);
+                evictions++;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void unpin(size_t i) {
+        if (--list[i].pins == 0 && list[i].stale) list.erase(list.begin() + i);
+    }
+
+    int find(void* data) const {
+        for (size_t i = 0; i < list.size(); i++) {
+            if (list[i].data == data) return (int)i;
+        }
+        return -1;
+    }
+
+    void invalidate(const std::string& path) {
+        for (size_t i = list.size(); i-- > 0;) {
+            if (list[i].path != path) continue;
+            if (list[i].pins == 0) list.erase(list.begin() + i);
+            else list[i].stale = true;
+        }
+    }
+};
+
+static bool randomRun(unsigned seed) {
+    srand(seed);
+    image_cache_init(BUDGET);
+    Model m;
+    std::vector<void*> pins;     // One element per pin held
+    static const char* paths[] = {"/sdcard/a.png", "/sdcard/b.png", "/sdcard/c.png", "/bundle/d.bin",
+                                  "/lvgl_images/e.bin", "/sdcard/f.png"};
+
+    for (int op = 0; op < RANDOM_OPS; op++) {
+        std::string path = paths[rand() % 6];
+        uint32_t generation = 1 + rand() % 3;
+        int kind = rand() % 100;
+
+        if (kind < 35) {
+            void* got = image_cache_lookup(path.c_str(), generation, NULL);
+            void* want = NULL;
+            for (size_t i = 0; i < m.list.size(); i++) {
+                ModelEntry& e = m.list[i];
+                if (e.stale || e.path != path || e.generation != generation) continue;
+                want = e.data;
+                e.pins++;
+                m.list.push_back(e);     // Now the most recent
+                m.list.erase(m.list.begin() + i);
+                break;
+            }
+            if (got != want) return false;
+            if (got) pins.push_back(got);
+        } else if (kind < 60) {
+            size_t size = 1 + rand() % (BUDGET / 3);
+            void* got = image_cache_insert(path.c_str(), generation, size);
+            bool fits = size <= m.budget;
+            if (fits) {
+                m.invalidate(path);
+                while (m.bytes() + size > m.budget && m.evictOne()) {
+                }
+                if (m.list.size() >= IMAGE_CACHE_MAX_ENTRIES) m.evictOne();
+                fits = m.list.size() < IMAGE_CACHE_MAX_ENTRIES && m.bytes() + size <= m.budget;
+            }
+            if ((got != NULL) != fits) return false;
+            if (got) {
+                m.list.push_back({path, generation, size, got, 1, false});
+                pins.push_back(got);
+            }
+        } else if (kind < 85 && !pins.empty()) {
+            size_t k = rand() % pins.size();
+            void* data = pins[k];
+            pins.erase(pins.begin() + k);
+            int i = m.find(data);
+            if (i < 0) return false;
+            if (rand() % 4) {
+                image_cache_release(data);
+            } else {
+                image_cache_discard(data);
+                m.list[i].stale = true;
+            }
+            m.unpin(i);
+        } else if (kind < 93) {
+            image_cache_invalidate(path.c_str());
+            m.invalidate(path);
+        } else if (kind < 96) {
+            image_cache_clear();
+            for (size_t i = m.list.size(); i-- > 0;) {
+                if (m.list[i].pins == 0) m.list.erase(m.list.begin() + i);
+            }
+        } else {
+            m.budget = BUDGET / 2 + rand() % BUDGET;
+            image_cache_set_budget(m.budget);
+            while (m.bytes() > m.budget && m.evictOne()) {
+            }
+        }
+
+        ImageCacheStats s = stats();
+        if (s.bytes_used != m.bytes() || s.entries != m.list.size() || s.evictions != m.evictions) return false;
+    }
+
+    for (void* p : pins) image_cache_release(p);
+    return true;
+}
+
+int main() {
+    scripted();
+
+    int bad = 0;
+    for (int run = 0; run < RANDOM_RUNS; run++) {
+        if (!randomRun(run + 1)) bad++;
+    }
+    printf("\nrandom operation sequences against the model: %d of %d differ (%d ops each)\n", bad, RANDOM_RUNS,
+           RANDOM_OPS);
+    failures += bad;
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * Host benchmark of redrawing a dirty area of Screen1 with and without the
+ * static_layer snapshot.
+ *
+ * Live: what LVGL does per invalidated area under the dynamic widgets - fill
+ * the screen background, scale the 960x960 background image by 125/256
+ * (bilinear, a model of the software transform into a temporary buffer),
+ * blend it in and draw the 70-opa overlay. Cached: copy the area from the
+ * snapshot. The blends use blend_kernels, as on the device; the transform is
+ * plain C, so the live column is a lower bound on the host.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/layer_bench/layer_bench.cpp src/helpers/blend_kernels.cpp \
+ *       -o layer_bench && ./layer_bench
+ */
+
+#include "blend_kernels.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+#define SCREEN_W 480
+#define SCREEN_H 480
+#define SOURCE_W 960
+#define SCALE 125                // Background zoom, 256 = 1:1
+#define OVERLAY_OPA 70
+#define REDRAWS 2000
+
+struct Area {
+    const char* name;
+    int x, y, w, h;
+};
+
+// Areas the dynamic widgets invalidate
+static const Area areas[] = {
+    {"countdown + event (324x96)", 78, 129, 324, 96},
+    {"clock label (140x40)      ", 170, 400, 140, 40},
+    {"arc sector (40x40)        ", 400, 200, 40, 40},
+};
+
+static std::vector<uint16_t> source(SOURCE_W * SOURCE_W), snapshot(SCREEN_W * SCREEN_H),
+    layer(SCREEN_W * 96), scaled(SCREEN_W * 96);
+
+static uint16_t lerp565(uint16_t a, uint16_t b, uint32_t f) {
+    uint32_t rb = (((b & 0xF81Fu) * f + (a & 0xF81Fu) * (256 - f)) >> 8) & 0xF81Fu;
+    uint32_t g = (((b & 0x07E0u) * f + (a & 0x07E0u) * (256 - f)) >> 8) & 0x07E0u;
+    return (uint16_t)(rb | g);
+}
+
+/**
+ * Bilinear scale of the background into a w x h buffer for screen area (x1, y1)
+ */
+static void transform(int x1, int y1, int w, int h, uint16_t* out) {
+    for (int y = 0; y < h; y++) {
+        uint32_t sy = (uint32_t)(y1 + y) * 256 * 256 / SCALE;
+        const uint16_t* r0 = &source[(sy >> 8) * SOURCE_W];
+        const uint16_t* r1 = r0 + SOURCE_W;
+        for (int x = 0; x < w; x++) {
+            uint32_t sx = (uint32_t)(x1 + x) * 256 * 256 / SCALE;
+            uint32_t i = sx >> 8, fx = sx & 0xFF;
+            out[y * w + x] = lerp565(lerp565(r0[i], r0[i + 1], fx), lerp565(r1[i], r1[i + 1], fx), sy & 0xFF);
+        }
+    }
+}
+
+static void drawLive(const Area& a) {
+    int stride = a.w * 2;
+    blend_rgb565_fill(layer.data(), a.w, a.h, stride, 0x0000);
+    transform(a.x, a.y, a.w, a.h, scaled.data());
+    blend_rgb565_copy(layer.data(), a.w, a.h, stride, scaled.data(), stride);
+    blend_rgb565_fill_mix(layer.data(), a.w, a.h, stride, 0x0000, OVERLAY_OPA, nullptr, 0);
+}
+
+static void drawCached(const Area& a) {
+    blend_rgb565_copy(layer.data(), a.w, a.h, a.w * 2, &snapshot[a.y * SCREEN_W + a.x], SCREEN_W * 2);
+}
+
+template <typename Fn>
+static double timeRedraws(Fn fn) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < REDRAWS; k++) fn();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / REDRAWS;
+}
+
+int main() {
+    for (size_t i = 0; i < source.size(); i++) source[i] = (uint16_t)(i * 7);
+
+    for (const Area& a : areas) {
+        double live = timeRedraws([&] { drawLive(a); });
+        double cached = timeRedraws([&] { drawCached(a); });
+        printf("%s  live %7.1f us  snapshot %5.1f us per redraw\n", a.name, live, cached);
+    }
+    return 0;
+}
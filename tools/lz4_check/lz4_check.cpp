@@ -0,0 +1,205 @@
+/**
+ * Host check of the LZ4 config upload path: a generated 3000-event schedule
+ * is compressed into an lz4_stream (4 KB blocks from liblz4, stored when they
+ * do not shrink) and must decode to the same bytes when fed in random pieces.
+ * Then 2000 corrupted copies (flipped bits, noise, damaged block headers,
+ * truncation, dropped or repeated packets) go through the checks COMMIT
+ * applies: the decoder, a complete final block, the announced size, the
+ * CRC-32 and a complete "events" array. Every corrupted stream must fail one of them or still
+ * decode to the original document (LZ4 can say the same thing two ways, e.g.
+ * a match offset moved onto identical earlier bytes). Build it with
+ * -fsanitize=address,undefined as well, so the decoder is also checked for
+ * reads and writes out of bounds on bad input.
+ *
+ * Build and run from the repository root (liblz4-dev provides lz4.h):
+ *   g++ -std=c++17 -O2 -Iinclude tools/lz4_check/lz4_check.cpp src/helpers/lz4_stream.cpp \
+ *       src/helpers/json_event_stream.cpp src/helpers/crc32.cpp -llz4 -o lz4_check && ./lz4_check
+ */
+
+#include "lz4_stream.h"
+#include "json_event_stream.h"
+#include "crc32.h"
+#include <lz4.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define EVENTS 3000
+#define CORRUPT_RUNS 2000
+#define SPLIT_RUNS 200
+#define PACKET 500               // Payload of a full-MTU DATA frame
+
+typedef std::vector<uint8_t> Bytes;
+
+static Bytes makeSchedule() {
+    static const char* labels[] = {"Breakfast", "Play Time", "Lunch", "Feeding", "Nap Time", "Story Time",
+                                   "Bath", "Snack", "Music", "Outdoor Walk"};
+    std::string s = "{\n  \"events\": [\n";
+    char obj[192];
+    for (int i = 0; i < EVENTS; i++) {
+        snprintf(obj, sizeof(obj),
+                 "    {\n      \"start\": %d,\n      \"duration\": %d,\n      \"label\": \"%s\",\n"
+                 "      \"path\": \"/sdcard/img%04d.png\"\n    }%s\n",
+                 i * 1440 / EVENTS, 900 * (1 + i % 4), labels[i % 10], i % 400, i + 1 < EVENTS ? "," : "");
+        s += obj;
+    }
+    s += "  ]\n}\n";
+    return Bytes(s.begin(), s.end());
+}
+
+static Bytes compress(const Bytes& raw) {
+    Bytes out;
+    std::vector<char> block(LZ4_compressBound(LZ4_STREAM_BLOCK_MAX));
+    for (size_t off = 0; off < raw.size(); off += LZ4_STREAM_BLOCK_MAX) {
+        int n = (int)(raw.size() - off < LZ4_STREAM_BLOCK_MAX ? raw.size() - off : LZ4_STREAM_BLOCK_MAX);
+        int c = LZ4_compress_default((const char*)&raw[off], block.data(), n, (int)block.size());
+        bool stored = c <= 0 || c >= n;
+        uint16_t comp = stored ? (uint16_t)(n | LZ4_STREAM_STORED) : (uint16_t)c;
+        out.insert(out.end(), {(uint8_t)comp, (uint8_t)(comp >> 8), (uint8_t)n, (uint8_t)(n >> 8)});
+        if (stored) out.insert(out.end(), &raw[off], &raw[off] + n);
+        else out.insert(out.end(), block.data(), block.data() + c);
+    }
+    return out;
+}
+
+// What the upload keeps of the decoded document (ble_protocol.cpp's configOutput)
+struct Upload {
+    Bytes written;
+    uint32_t size;
+    uint32_t crc;
+    JsonEventStream events;
+};
+
+static bool countEvent(void* ctx, const char* object, size_t len) {
+    (void)ctx;
+    (void)object;
+    (void)len;
+    return true;
+}
+
+static bool output(void* ctx, const uint8_t* data, size_t len) {
+    Upload* u = (Upload*)ctx;
+    if (u->written.size() + len > u->size) return false;   // Larger than announced
+    u->crc = crc32_update(u->crc, data, len);
+    u->written.insert(u->written.end(), data, data + len);
+    json_event_stream_feed(&u->events, (const char*)data, len);
+    return true;
+}
+
+// INTACT: accepted, and decoded to the original anyway (a match moved onto identical bytes)
+enum Verdict { ACCEPTED, BAD_DATA, INCOMPLETE, BAD_CRC, NO_EVENTS, INTACT, VERDICTS };
+static const char* verdictNames[VERDICTS] = {"accepted", "decoder", "incomplete", "CRC", "events", "intact"};
+
+/**
+ * Feed a stream in pieces of 1..maxPiece bytes, then apply COMMIT's checks
+ */
+static Verdict upload(const Bytes& stream, const Bytes& raw, uint32_t rawCrc, size_t maxPiece, Bytes* decoded) {
+    static Lz4Stream lz;
+    static Upload u;
+    u.written.clear();
+    u.size = (uint32_t)raw.size();
+    u.crc = 0;
+    json_event_stream_init(&u.events, countEvent, NULL);
+    lz4_stream_init(&lz, output, &u);
+
+    for (size_t off = 0; off < stream.size();) {
+        size_t n = 1 + rand() % maxPiece;
+        if (n > stream.size() - off) n = stream.size() - off;
+        if (!lz4_stream_feed(&lz, &stream[off], n)) return BAD_DATA;
+        off += n;
+    }
+    if (decoded) *decoded = u.written;
+    if (!lz4_stream_complete(&lz) || u.written.size() != u.size) return INCOMPLETE;
+    if (u.crc != rawCrc) return BAD_CRC;
+    if (!json_event_stream_done(&u.events)) return NO_EVENTS;
+    return ACCEPTED;
+}
+
+/**
+ * A random damage of one of the kinds a lossy or hostile link could produce
+ */
+static Bytes corrupt(const Bytes& stream, int* kind) {
+    Bytes s = stream;
+    size_t at = rand() % s.size();
+    *kind = rand() % 6;
+    switch (*kind) {
+        case 0:  // Flip one bit
+            s[at] ^= (uint8_t)(1 << (rand() % 8));
+            break;
+        case 1:  // Overwrite a run with noise
+            for (size_t i = at, n = 1 + rand() % 64; i < s.size() && n; i++, n--) s[i] = (uint8_t)rand();
+            break;
+        case 2:  // Damage the first block header (length and stored flag fields)
+            s[rand() % 4] ^= (uint8_t)(1 + rand() % 255);
+            break;
+        case 3:  // Cut the stream short
+            s.resize(at);
+            break;
+        case 4:  // Drop a packet's worth of bytes from the middle
+            s.erase(s.begin() + at, s.begin() + (at + PACKET < s.size() ? at + PACKET : s.size()));
+            break;
+        default: {  // Repeat a packet (a resent frame applied twice)
+            size_t n = at + PACKET < s.size() ? PACKET : s.size() - at;
+            Bytes dup(s.begin() + at, s.begin() + at + n);
+            s.insert(s.begin() + at, dup.begin(), dup.end());
+            break;
+        }
+    }
+    return s;
+}
+
+int main() {
+    srand(1);
+    Bytes raw = makeSchedule();
+    Bytes stream = compress(raw);
+    uint32_t rawCrc = crc32_update(0, raw.data(), raw.size());
+    printf("schedule: %d events, %zu bytes; LZ4 stream %zu bytes (%.0f%%), %zu instead of %zu %d-byte packets\n",
+           EVENTS, raw.size(), stream.size(), 100.0 * stream.size() / raw.size(), (stream.size() + PACKET - 1) / PACKET,
+           (raw.size() + PACKET - 1) / PACKET, PACKET);
+
+    int failures = 0;
+    int splitBad = 0;
+    for (int i = 0; i < SPLIT_RUNS; i++) {
+        Bytes decoded;
+        size_t maxPiece = i % 2 ? PACKET : 1 + rand() % 8;
+        if (upload(stream, raw, rawCrc, maxPiece, &decoded) != ACCEPTED || decoded != raw) splitBad++;
+    }
+    printf("round trip at random split points: %d of %d wrong\n", splitBad, SPLIT_RUNS);
+    failures += splitBad;
+
+    static const char* kindNames[] = {"bit flip", "noise run", "header", "truncated", "dropped packet",
+                                      "repeated packet"};
+    int caught[6][VERDICTS] = {};
+    int unchanged = 0;
+    for (int i = 0; i < CORRUPT_RUNS; i++) {
+        int kind;
+        Bytes bad = corrupt(stream, &kind);
+        if (bad == stream) {
+            unchanged++;   // The noise happened to match; not a corruption
+            continue;
+        }
+        Bytes decoded;
+        Verdict v = upload(bad, raw, rawCrc, PACKET, &decoded);
+        caught[kind][v == ACCEPTED && decoded == raw ? INTACT : v]++;
+    }
+
+    printf("\n%-16s", "corruption");
+    for (int v = 0; v < VERDICTS; v++) printf(" %10s", verdictNames[v]);
+    printf("\n");
+    int accepted = 0;
+    for (int k = 0; k < 6; k++) {
+        printf("%-16s", kindNames[k]);
+        for (int v = 0; v < VERDICTS; v++) printf(" %10d", caught[k][v]);
+        printf("\n");
+        accepted += caught[k][ACCEPTED];
+    }
+    printf("%d of %d corrupted streams accepted with wrong content", accepted, CORRUPT_RUNS - unchanged);
+    if (unchanged) printf(" (%d mutations left the stream unchanged)", unchanged);
+    printf("\n");
+    failures += accepted;
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * Host check of round_clip on the 480x480 round panel. The span table must
+ * cover every pixel that touches the circle; round_clip_area and
+ * round_clip_visible_px must agree with a per-pixel walk of it; and
+ * round_clip_split, for random areas, band heights and area limits, must
+ * return at most max disjoint areas inside the input that together cover all
+ * its visible pixels. Then reports, per area limit, how many pixels a
+ * full-screen redraw and a top-bar redraw still render, and what a split
+ * costs.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/round_clip_check/round_clip_check.cpp src/helpers/round_clip.cpp \
+ *       -o round_clip_check && ./round_clip_check
+ */
+
+#include "round_clip.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#define W 480
+#define H 480
+#define BAND_ROWS 32             // As hardware_init.cpp
+#define CHECK_RUNS 20000
+#define BENCH_REPS 20000
+
+static RoundClipSpan rows[H];
+static RoundClip clip;
+
+static bool spanVisible(int32_t x, int32_t y) {
+    return x >= clip.rows[y].x0 && x < clip.rows[y].x1;
+}
+
+/**
+ * Whether any part of pixel (x, y) lies inside the inscribed circle
+ */
+static bool touchesCircle(int32_t x, int32_t y) {
+    double r = W / 2.0, cx = W / 2.0, cy = H / 2.0;
+    double nx = cx < x ? x : (cx > x + 1 ? x + 1 : cx);
+    double ny = cy < y ? y : (cy > y + 1 ? y + 1 : cy);
+    return (nx - cx) * (nx - cx) + (ny - cy) * (ny - cy) < r * r;
+}
+
+static RoundClipArea randomArea() {
+    int32_t x1 = rand() % (W + 40) - 20, y1 = rand() % (H + 40) - 20;
+    int32_t x2 = x1 + rand() % W, y2 = y1 + rand() % H;
+    return {x1, y1, x2, y2};
+}
+
+static bool inside(const RoundClipArea& inner, const RoundClipArea& outer) {
+    return inner.x1 >= outer.x1 && inner.y1 >= outer.y1 && inner.x2 <= outer.x2 && inner.y2 <= outer.y2;
+}
+
+static bool checkArea(const RoundClipArea& a) {
+    RoundClipArea box = {INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN};
+    uint32_t px = 0;
+    for (int32_t y = a.y1 < 0 ? 0 : a.y1; y <= a.y2 && y < H; y++) {
+        for (int32_t x = a.x1 < 0 ? 0 : a.x1; x <= a.x2 && x < W; x++) {
+            if (!spanVisible(x, y)) continue;
+            px++;
+            if (x < box.x1) box.x1 = x;
+            if (x > box.x2) box.x2 = x;
+            if (y < box.y1) box.y1 = y;
+            box.y2 = y;
+        }
+    }
+
+    RoundClipArea got = a;
+    bool any = round_clip_area(&clip, &got);
+    if (round_clip_visible_px(&clip, &a) != px || any != (px > 0)) return false;
+    return !any || (got.x1 == box.x1 && got.y1 == box.y1 && got.x2 == box.x2 && got.y2 == box.y2);
+}
+
+static bool checkSplit(const RoundClipArea& a, uint16_t bandRows, int max) {
+    std::vector<RoundClipArea> out(max);
+    int n = round_clip_split(&clip, &a, bandRows, out.data(), max);
+    if (n < 0 || n > max) return false;
+
+    std::vector<uint8_t> hits(W * H, 0);
+    for (int i = 0; i < n; i++) {
+        if (!inside(out[i], a) || round_clip_visible_px(&clip, &out[i]) == 0) return false;
+        for (int32_t y = out[i].y1; y <= out[i].y2; y++) {
+            for (int32_t x = out[i].x1; x <= out[i].x2; x++) {
+                if (hits[y * W + x]++) return false;   // Overlap renders twice
+            }
+        }
+    }
+    for (int32_t y = a.y1 < 0 ? 0 : a.y1; y <= a.y2 && y < H; y++) {
+        for (int32_t x = a.x1 < 0 ? 0 : a.x1; x <= a.x2 && x < W; x++) {
+            if (spanVisible(x, y) && !hits[y * W + x]) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Pixels LVGL renders for a once split into at most max areas
+ */
+static uint32_t renderedPx(const RoundClipArea& a, int max, int* areas) {
+    std::vector<RoundClipArea> out(max);
+    *areas = round_clip_split(&clip, &a, BAND_ROWS, out.data(), max);
+    uint32_t px = 0;
+    for (int i = 0; i < *areas; i++) px += (out[i].x2 - out[i].x1 + 1) * (out[i].y2 - out[i].y1 + 1);
+    return px;
+}
+
+int main() {
+    round_clip_init(&clip, W, H, rows);
+    int failures = 0;
+
+    // Span table against the circle: nothing visible may be clipped
+    long hidden = 0, extra = 0;
+    for (int32_t y = 0; y < H; y++) {
+        for (int32_t x = 0; x < W; x++) {
+            bool want = touchesCircle(x, y), got = spanVisible(x, y);
+            hidden += want && !got;
+            extra += got && !want;
+        }
+    }
+    printf("span table: %u visible px, %ld clipped that touch the circle, %ld kept that do not\n",
+           (unsigned)clip.visible_px, hidden, extra);
+    if (hidden) failures++;
+
+    // hardware_init.cpp marks all-corner invalidations with the top-left pixel
+    if (spanVisible(0, 0)) {
+        printf("top-left pixel is visible: the corner marker would be drawn\n");
+        failures++;
+    }
+
+    srand(1);
+    int badArea = 0, badSplit = 0;
+    for (int i = 0; i < CHECK_RUNS; i++) {
+        RoundClipArea a = randomArea();
+        if (!checkArea(a)) badArea++;
+        static const uint16_t bandRows[] = {1, 8, 32, 100};
+        if (i % 8 == 0 && !checkSplit(a, bandRows[rand() % 4], 1 + rand() % 20)) badSplit++;
+    }
+    printf("round_clip_area/visible_px: %d of %d wrong\n", badArea, CHECK_RUNS);
+    printf("round_clip_split: %d of %d wrong\n", badSplit, CHECK_RUNS / 8);
+    failures += badArea + badSplit;
+
+    struct {
+        const char* name;
+        RoundClipArea area;
+    } redraws[] = {
+        {"full screen", {0, 0, W - 1, H - 1}},
+        {"top bar 480x60", {0, 0, W - 1, 59}},
+    };
+    printf("\n%-16s %8s %6s %10s %8s\n", "redraw", "max", "areas", "render px", "saved");
+    for (auto& r : redraws) {
+        uint32_t full = (r.area.x2 - r.area.x1 + 1) * (r.area.y2 - r.area.y1 + 1);
+        static const int limits[] = {31, 15, 8, 4, 2, 1};
+        for (int max : limits) {
+            int areas;
+            uint32_t px = renderedPx(r.area, max, &areas);
+            printf("%-16s %8d %6d %10u %7.1f%%\n", r.name, max, areas, (unsigned)px, 100.0 * (full - px) / full);
+        }
+    }
+
+    RoundClipArea out[H / BAND_ROWS + 1];
+    RoundClipArea screen = {0, 0, W - 1, H - 1};
+    auto t0 = std::chrono::steady_clock::now();
+    int sink = 0;
+    for (int k = 0; k < BENCH_REPS; k++) sink += round_clip_split(&clip, &screen, BAND_ROWS, out, 31);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    printf("\nfull-screen split: %.2f us per invalidation (%d areas)\n", us / BENCH_REPS, sink / BENCH_REPS);
+
+    printf("%s\n", failures ? "FAILED" : "passed");
+    return failures ? 1 : 0;
+}
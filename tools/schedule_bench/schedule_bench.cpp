@@ -0,0 +1,278 @@
+/**
+ * Host comparison of the two schedule formats. The repo's duration.json and
+ * generated 16-event (the device's limit) and 200-event schedules are encoded
+ * as pretty JSON, minified JSON, CBOR with map events and CBOR with
+ * positional array events. Each encoding is then parsed into readConfig
+ * records as the device does: JSON through json_event_stream in 512-byte
+ * reads plus JSON_reader's field extraction (mirrored below without its
+ * Serial logging), CBOR through schedule_cbor_decode. Every encoding must
+ * give the same records. Prints wire size and parse time per load.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/schedule_bench/schedule_bench.cpp src/helpers/json_event_stream.cpp \
+ *       src/helpers/schedule_cbor.cpp -o schedule_bench && ./schedule_bench [duration.json]
+ */
+
+#include "JSON_reader.h"
+#include "json_event_stream.h"
+#include "schedule_cbor.h"
+#include <chrono>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#define JSON_READ_CHUNK 512      // As JSON_reader.cpp
+#define MAX_EVENTS 200
+#define BENCH_MS 300
+
+typedef std::vector<uint8_t> Bytes;
+typedef std::vector<readConfig> Events;
+
+// ============ JSON (as JSON_reader.cpp) ============
+
+static void skipSeparators(const char*& p) {
+    while (*p && (isspace((unsigned char)*p) || *p == ',')) p++;
+}
+
+static const char* valueOf(const char* buf, const char* key) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\"", key);
+    const char* p = strstr(buf, pattern);
+    if (!p) return NULL;
+    p += strlen(pattern);
+    skipSeparators(p);
+    if (*p != ':') return NULL;
+    p++;
+    skipSeparators(p);
+    return p;
+}
+
+static bool extractU16(const char* buf, const char* key, uint16_t& out) {
+    const char* p = valueOf(buf, key);
+    if (!p || !isdigit((unsigned char)*p)) return false;
+    uint64_t value = 0;
+    while (isdigit((unsigned char)*p)) {
+        value = value * 10 + (uint64_t)(*p++ - '0');
+        if (value > 0xFFFFFFFFULL) return false;
+    }
+    out = (uint16_t)value;
+    return true;
+}
+
+static bool extractString(const char* buf, const char* key, char* out, size_t outSize) {
+    const char* p = valueOf(buf, key);
+    if (!p || *p++ != '"') return false;
+    size_t i = 0;
+    while (*p && *p != '"') {
+        if (i + 1 >= outSize) return false;
+        out[i++] = *p++;
+    }
+    if (*p != '"') return false;
+    out[i] = '\0';
+    return true;
+}
+
+struct EventSink {
+    readConfig* out;
+    size_t max;
+    size_t count;
+};
+
+static bool collectEvent(void* ctx, const char* object, size_t len) {
+    (void)len;
+    EventSink* sink = (EventSink*)ctx;
+    readConfig cfg;
+    bool ok1 = extractU16(object, "start", cfg.start);
+    bool ok2 = extractU16(object, "duration", cfg.duration);
+    bool ok3 = extractString(object, "label", cfg.label, sizeof(cfg.label));
+    bool ok4 = extractString(object, "path", cfg.path, sizeof(cfg.path));
+    if (ok1 && ok2 && ok3 && ok4) sink->out[sink->count++] = cfg;
+    return sink->count < sink->max;
+}
+
+static size_t parseJson(const Bytes& doc, readConfig* out, size_t max) {
+    EventSink sink = {out, max, 0};
+    JsonEventStream stream;
+    json_event_stream_init(&stream, collectEvent, &sink);
+    for (size_t off = 0; off < doc.size(); off += JSON_READ_CHUNK) {
+        size_t n = doc.size() - off < JSON_READ_CHUNK ? doc.size() - off : JSON_READ_CHUNK;
+        if (!json_event_stream_feed(&stream, (const char*)&doc[off], n) || json_event_stream_done(&stream)) break;
+    }
+    return sink.count;
+}
+
+// ============ CBOR ============
+
+struct MemReader {
+    const Bytes* doc;
+    size_t pos;
+};
+
+static size_t readMem(void* ctx, uint8_t* buf, size_t len) {
+    MemReader* r = (MemReader*)ctx;
+    size_t n = r->doc->size() - r->pos < len ? r->doc->size() - r->pos : len;
+    memcpy(buf, r->doc->data() + r->pos, n);
+    r->pos += n;
+    return n;
+}
+
+static size_t parseCbor(const Bytes& doc, readConfig* out, size_t max) {
+    MemReader r = {&doc, 0};
+    size_t count = 0;
+    return schedule_cbor_decode(readMem, &r, out, max, &count) ? count : 0;
+}
+
+static void cborHead(Bytes& out, uint8_t major, uint32_t arg) {
+    major <<= 5;
+    if (arg < 24) {
+        out.push_back(major | arg);
+    } else if (arg < 0x100) {
+        out.insert(out.end(), {(uint8_t)(major | 24), (uint8_t)arg});
+    } else if (arg < 0x10000) {
+        out.insert(out.end(), {(uint8_t)(major | 25), (uint8_t)(arg >> 8), (uint8_t)arg});
+    } else {
+        out.insert(out.end(), {(uint8_t)(major | 26), (uint8_t)(arg >> 24), (uint8_t)(arg >> 16),
+                               (uint8_t)(arg >> 8), (uint8_t)arg});
+    }
+}
+
+static void cborText(Bytes& out, const char* s) {
+    cborHead(out, 3, strlen(s));
+    out.insert(out.end(), s, s + strlen(s));
+}
+
+static Bytes encodeCbor(const Events& events, bool positional) {
+    Bytes out;
+    cborHead(out, 5, 1);
+    cborText(out, "events");
+    cborHead(out, 4, events.size());
+    for (const readConfig& e : events) {
+        if (positional) {
+            cborHead(out, 4, 4);
+        } else {
+            cborHead(out, 5, 4);
+            cborText(out, "start");
+        }
+        cborHead(out, 0, e.start);
+        if (!positional) cborText(out, "duration");
+        cborHead(out, 0, e.duration);
+        if (!positional) cborText(out, "label");
+        cborText(out, e.label);
+        if (!positional) cborText(out, "path");
+        cborText(out, e.path);
+    }
+    return out;
+}
+
+// ============ SCHEDULES ============
+
+static Bytes encodeJson(const Events& events, bool pretty) {
+    std::string s = pretty ? "{\n  \"events\": [\n" : "{\"events\":[";
+    char obj[256];
+    for (size_t i = 0; i < events.size(); i++) {
+        const readConfig& e = events[i];
+        const char* sep = i + 1 < events.size() ? "," : "";
+        if (pretty) {
+            snprintf(obj, sizeof(obj),
+                     "    {\n      \"start\": %u,\n      \"duration\": %u,\n      \"label\": \"%s\",\n"
+                     "      \"path\": \"%s\"\n    }%s\n", e.start, e.duration, e.label, e.path, sep);
+        } else {
+            snprintf(obj, sizeof(obj), "{\"start\":%u,\"duration\":%u,\"label\":\"%s\",\"path\":\"%s\"}%s",
+                     e.start, e.duration, e.label, e.path, sep);
+        }
+        s += obj;
+    }
+    s += pretty ? "  ]\n}\n" : "]}";
+    return Bytes(s.begin(), s.end());
+}
+
+static Events generated(size_t n) {
+    static const char* labels[] = {"Breakfast", "Play Time", "Lunch", "Feeding", "Nap Time", "Story Time",
+                                   "Bath", "Snack", "Music", "Outdoor Walk"};
+    Events events(n);
+    for (size_t i = 0; i < n; i++) {
+        readConfig& e = events[i];
+        e.start = (uint16_t)(360 + i * 1080 / n);
+        e.duration = (uint16_t)(900 * (1 + i % 4));
+        snprintf(e.label, sizeof(e.label), "%s", labels[i % 10]);
+        snprintf(e.path, sizeof(e.path), "/sdcard/img%03u.png", (unsigned)i);
+    }
+    return events;
+}
+
+static bool sameEvents(const readConfig* got, size_t count, const Events& want) {
+    if (count != want.size()) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (got[i].start != want[i].start || got[i].duration != want[i].duration ||
+            strcmp(got[i].label, want[i].label) != 0 || strcmp(got[i].path, want[i].path) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return microseconds per parse
+ */
+static double timeParse(size_t (*parse)(const Bytes&, readConfig*, size_t), const Bytes& doc, readConfig* out) {
+    long reps = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double elapsed;
+    do {
+        for (int k = 0; k < 100; k++) parse(doc, out, MAX_EVENTS);
+        reps += 100;
+        elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    } while (elapsed < BENCH_MS * 1000.0);
+    return elapsed / reps;
+}
+
+int main(int argc, char** argv) {
+    const char* repoPath = argc > 1 ? argv[1] : "duration.json";
+    FILE* f = fopen(repoPath, "rb");
+    if (!f) {
+        printf("cannot open %s (run from the repository root)\n", repoPath);
+        return 1;
+    }
+    Bytes repoDoc;
+    for (int c; (c = fgetc(f)) != EOF;) repoDoc.push_back((uint8_t)c);
+    fclose(f);
+
+    static readConfig parsed[MAX_EVENTS];
+    Events repoEvents(parsed, parsed + parseJson(repoDoc, parsed, MAX_EVENTS));
+
+    struct Schedule {
+        std::string name;
+        Events events;
+    } schedules[] = {
+        {std::string(repoPath) + " (" + std::to_string(repoEvents.size()) + ")", repoEvents},
+        {"generated (16)", generated(16)},
+        {"generated (200)", generated(200)},
+    };
+
+    printf("%-24s %-13s %7s %10s\n", "schedule", "encoding", "bytes", "parse us");
+    int failures = 0;
+    for (const Schedule& s : schedules) {
+        struct {
+            const char* name;
+            Bytes doc;
+            size_t (*parse)(const Bytes&, readConfig*, size_t);
+        } encodings[] = {
+            {"JSON pretty", encodeJson(s.events, true), parseJson},
+            {"JSON min", encodeJson(s.events, false), parseJson},
+            {"CBOR maps", encodeCbor(s.events, false), parseCbor},
+            {"CBOR arrays", encodeCbor(s.events, true), parseCbor},
+        };
+        for (auto& e : encodings) {
+            bool ok = sameEvents(parsed, e.parse(e.doc, parsed, MAX_EVENTS), s.events);
+            double us = timeParse(e.parse, e.doc, parsed);
+            printf("%-24s %-13s %7zu %10.2f%s\n", s.name.c_str(), e.name, e.doc.size(), us, ok ? "" : "  MISMATCH");
+            if (!ok) failures++;
+        }
+    }
+
+    printf("%s\n", failures ? "FAILED" : "all encodings give the same records");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+/**
+ * Host check of strip_decoder: a 480x480 RGB565 image, raw and RLE, decoded
+ * in strips of varying height from a reader that returns short reads must
+ * match a full decode (image_transcoder's RLE decoder) pixel for pixel.
+ * Truncated payloads must fail instead of returning stale pixels.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/strip_check/strip_check.cpp src/helpers/strip_decoder.cpp \
+ *       src/helpers/image_transcoder.cpp -o strip_check && ./strip_check
+ */
+
+#include "strip_decoder.h"
+#include "image_transcoder.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define W 480
+#define H 480
+#define PIXELS (W * H)
+#define SHORT_READ 37            // Largest read the file hands back, to split runs across refills
+
+struct Payload {
+    const uint8_t* data;
+    size_t len;
+    size_t pos;
+};
+
+static int32_t readPayload(void* ctx, uint8_t* buf, uint32_t len) {
+    Payload* p = (Payload*)ctx;
+    size_t n = p->len - p->pos;
+    if (n > len) n = len;
+    if (n > SHORT_READ) n = SHORT_READ;
+    memcpy(buf, p->data + p->pos, n);
+    p->pos += n;
+    return (int32_t)n;
+}
+
+/**
+ * Test images: noise (all literals), a gradient (long runs), short runs
+ * mixed with noise, and a flat colour (runs longer than the 127-block limit)
+ */
+static void makeImage(int kind, std::vector<uint16_t>& img) {
+    srand(kind + 1);
+    for (int i = 0; i < PIXELS; i++) {
+        switch (kind) {
+            case 0: img[i] = (uint16_t)rand(); break;
+            case 1: img[i] = (uint16_t)(i / 777); break;
+            case 2: img[i] = (i % 13) < 5 ? 7 : (uint16_t)(rand() % 3); break;
+            default: img[i] = 0xABCD; break;
+        }
+    }
+}
+
+/**
+ * Decode the whole payload in strips whose heights cycle through a pattern
+ * @return false if the decoder reported an error
+ */
+static bool decodeStrips(const uint8_t* data, size_t len, bool compressed, std::vector<uint16_t>& out) {
+    static const int heights[] = {16, 3, 1, 16, 7};
+    Payload payload = {data, len, 0};
+    StripDecoder d;
+    strip_decoder_init(&d, readPayload, &payload, 2, compressed, (uint32_t)len);
+
+    int y = 0;
+    for (int k = 0; y < H; k++) {
+        int rows = heights[k % 5];
+        if (y + rows > H) rows = H - y;
+        if (!strip_decoder_read(&d, (uint8_t*)&out[(size_t)y * W], rows * W * 2)) return false;
+        y += rows;
+    }
+    return true;
+}
+
+/**
+ * First differing pixel, or -1
+ */
+static long firstDiff(const std::vector<uint16_t>& a, const std::vector<uint16_t>& b) {
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i] != b[i]) return (long)i;
+    }
+    return -1;
+}
+
+int main() {
+    static const char* names[] = {"noise", "gradient", "short runs", "flat"};
+    std::vector<uint16_t> img(PIXELS), full(PIXELS), strips(PIXELS);
+    std::vector<uint8_t> rle(PIXELS * 3);
+    int failures = 0;
+
+    for (int kind = 0; kind < 4; kind++) {
+        makeImage(kind, img);
+        size_t rleLen = transcoder_rle_encode((const uint8_t*)img.data(), PIXELS * 2, 2, rle.data(), rle.size());
+        size_t fullLen = transcoder_rle_decode(rle.data(), rleLen, (uint8_t*)full.data(), PIXELS * 2, 2);
+        bool fullOk = rleLen > 0 && fullLen == PIXELS * 2 && firstDiff(full, img) < 0;
+
+        // Raw payloads are compared with the image itself, RLE with the full decode
+        std::fill(strips.begin(), strips.end(), 0);
+        bool rawOk = decodeStrips((const uint8_t*)img.data(), PIXELS * 2, false, strips);
+        long rawDiff = firstDiff(strips, img);
+
+        std::fill(strips.begin(), strips.end(), 0);
+        bool rleOk = decodeStrips(rle.data(), rleLen, true, strips);
+        long rleDiff = firstDiff(strips, full);
+
+        // Cut mid-image: the decoder must report it
+        bool truncatedFails = !decodeStrips(rle.data(), rleLen / 2, true, strips);
+
+        bool ok = fullOk && rawOk && rawDiff < 0 && rleOk && rleDiff < 0 && truncatedFails;
+        printf("%-10s  rle %6u B  raw %s  rle %s  truncated %s  %s\n", names[kind], (unsigned)rleLen,
+               rawOk && rawDiff < 0 ? "match" : "DIFF ", rleOk && rleDiff < 0 ? "match" : "DIFF ",
+               truncatedFails ? "rejected" : "ACCEPTED", ok ? "ok" : "FAILED");
+        if (rawDiff >= 0) printf("  raw: first diff at (%ld, %ld)\n", rawDiff % W, rawDiff / W);
+        if (rleDiff >= 0) printf("  rle: first diff at (%ld, %ld)\n", rleDiff % W, rleDiff / W);
+        if (!ok) failures++;
+    }
+
+    printf("%s\n", failures ? "FAILED" : "all images matched");
+    return failures ? 1 : 0;
+}
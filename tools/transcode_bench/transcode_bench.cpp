@@ -0,0 +1,248 @@
+/**
+ * Host benchmark of image_transcoder: generated PNGs (gray, RGB, RGBA,
+ * palette; rows with None/Sub/Up/Average/Paeth filters) and BMPs are
+ * decoded, scaled to 480x480 RGB565 and RLE encoded, as image_ingest does on
+ * the device. Decoded pixels must match the generated ones and the RLE
+ * payload must decode back to the scaled image. Reports each stage's time
+ * and source throughput. Inflate is zlib here; the device uses the ROM's
+ * tinfl, so that column does not carry over.
+ *
+ * Build and run from the repository root:
+ *   g++ -std=c++17 -O2 -Iinclude tools/transcode_bench/transcode_bench.cpp src/helpers/image_transcoder.cpp \
+ *       -lz -o transcode_bench && ./transcode_bench
+ */
+
+#include "image_transcoder.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <zlib.h>
+
+#define TARGET_W 480
+#define TARGET_H 480
+#define REPS 5
+
+typedef std::vector<uint8_t> Bytes;
+
+struct ImageCase {
+    const char* name;
+    bool bmp;
+    int type;                    // PNG colour type, or BMP bits per pixel
+    uint32_t w, h;
+};
+
+static const ImageCase cases[] = {
+    {"PNG gray     800x800  ", false, 0, 800, 800},
+    {"PNG RGB      960x960  ", false, 2, 960, 960},
+    {"PNG RGBA    1080x1080 ", false, 6, 1080, 1080},
+    {"PNG palette  800x600  ", false, 3, 800, 600},
+    {"BMP 24-bit   960x960  ", true, 24, 960, 960},
+    {"BMP 32-bit  1280x720  ", true, 32, 1280, 720},
+};
+
+static int channelsOf(const ImageCase& c) {
+    if (c.bmp) return c.type / 8;
+    static const int channels[] = {1, 0, 3, 1, 2, 0, 4};
+    return channels[c.type];
+}
+
+/**
+ * Photo-like content: gradients with noise, and a flat band at the top
+ */
+static Bytes makePixels(const ImageCase& c) {
+    int ch = channelsOf(c);
+    Bytes px((size_t)c.w * c.h * ch);
+    srand(c.w + c.type);
+    for (uint32_t y = 0; y < c.h; y++) {
+        for (uint32_t x = 0; x < c.w; x++) {
+            uint8_t* p = &px[((size_t)y * c.w + x) * ch];
+            bool flat = y < c.h / 6;
+            for (int k = 0; k < ch; k++) {
+                int v = flat ? 40 + 60 * k : (int)((x * (k + 1) + y * (3 - k)) * 255 / (c.w + c.h)) + rand() % 17 - 8;
+                p[k] = (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+            }
+            if (c.type == 3 && !c.bmp) p[0] = flat ? 7 : (uint8_t)((x / 8 + y / 8) % 200);
+        }
+    }
+    return px;
+}
+
+static void putBE32(Bytes& out, uint32_t v) {
+    for (int i = 3; i >= 0; i--) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void putLE(Bytes& out, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; i++) out.push_back((uint8_t)(v >> (8 * i)));
+}
+
+static void pngChunk(Bytes& out, const char* type, const Bytes& data) {
+    putBE32(out, data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBE32(out, crc32(0, &out[start], out.size() - start));
+}
+
+static uint8_t paethPredict(int a, int b, int c) {
+    int p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    return (uint8_t)(pa <= pb && pa <= pc ? a : pb <= pc ? b : c);
+}
+
+static Bytes makePng(const ImageCase& c, const Bytes& px) {
+    int bpp = channelsOf(c);
+    size_t rowBytes = (size_t)c.w * bpp;
+    Bytes filtered;
+    for (uint32_t y = 0; y < c.h; y++) {
+        const uint8_t* cur = &px[y * rowBytes];
+        const uint8_t* prev = y ? cur - rowBytes : NULL;
+        uint8_t filter = (uint8_t)(y % 5);
+        filtered.push_back(filter);
+        for (size_t i = 0; i < rowBytes; i++) {
+            int a = i >= (size_t)bpp ? cur[i - bpp] : 0;
+            int b = prev ? prev[i] : 0;
+            int cc = prev && i >= (size_t)bpp ? prev[i - bpp] : 0;
+            int pred = filter == 1 ? a : filter == 2 ? b : filter == 3 ? (a + b) >> 1 : filter == 4 ? paethPredict(a, b, cc) : 0;
+            filtered.push_back((uint8_t)(cur[i] - pred));
+        }
+    }
+    uLongf zlen = compressBound(filtered.size());
+    Bytes z(zlen);
+    compress2(z.data(), &zlen, filtered.data(), filtered.size(), 6);
+    z.resize(zlen);
+
+    Bytes png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    Bytes ihdr;
+    putBE32(ihdr, c.w);
+    putBE32(ihdr, c.h);
+    ihdr.insert(ihdr.end(), {8, (uint8_t)c.type, 0, 0, 0});
+    pngChunk(png, "IHDR", ihdr);
+    if (c.type == 3) {
+        Bytes plte;
+        for (int i = 0; i < 256; i++) plte.insert(plte.end(), {(uint8_t)i, (uint8_t)(255 - i), (uint8_t)(i * 7)});
+        pngChunk(png, "PLTE", plte);
+    }
+    // Split the data over several IDAT chunks, as encoders do
+    for (size_t off = 0; off < z.size(); off += 65536) {
+        size_t n = z.size() - off < 65536 ? z.size() - off : 65536;
+        pngChunk(png, "IDAT", Bytes(z.begin() + off, z.begin() + off + n));
+    }
+    pngChunk(png, "IEND", Bytes());
+    return png;
+}
+
+/**
+ * Bottom-up BMP with BITMAPINFOHEADER; px is top-down RGB(A)
+ */
+static Bytes makeBmp(const ImageCase& c, const Bytes& px) {
+    int bpp = channelsOf(c);
+    uint32_t stride = (c.w * bpp + 3) & ~3u;
+    Bytes bmp = {'B', 'M'};
+    putLE(bmp, 54 + stride * c.h, 4);
+    putLE(bmp, 0, 4);
+    putLE(bmp, 54, 4);
+    putLE(bmp, 40, 4);
+    putLE(bmp, c.w, 4);
+    putLE(bmp, c.h, 4);
+    putLE(bmp, 1, 2);
+    putLE(bmp, c.type, 2);
+    putLE(bmp, 0, 4);
+    putLE(bmp, stride * c.h, 4);
+    putLE(bmp, 2835, 4);
+    putLE(bmp, 2835, 4);
+    putLE(bmp, 0, 4);
+    putLE(bmp, 0, 4);
+    for (uint32_t row = 0; row < c.h; row++) {
+        const uint8_t* p = &px[(size_t)(c.h - 1 - row) * c.w * bpp];
+        for (uint32_t x = 0; x < c.w; x++) {
+            bmp.insert(bmp.end(), {p[x * bpp + 2], p[x * bpp + 1], p[x * bpp]});
+            if (bpp == 4) bmp.push_back(p[x * bpp + 3]);
+        }
+        bmp.resize(bmp.size() + stride - c.w * bpp, 0);
+    }
+    return bmp;
+}
+
+static size_t zlibInflate(const uint8_t* in, size_t in_len, uint8_t* out, size_t out_len) {
+    uLongf n = out_len;
+    return uncompress(out, &n, in, in_len) == Z_OK ? n : 0;
+}
+
+/**
+ * Decoded pixels against the generated ones (BMP channels are stored BGR(A))
+ */
+static bool sourceMatches(const ImageCase& c, const TranscodeSource& src, const Bytes& px) {
+    int bpp = channelsOf(c);
+    if (src.w != c.w || src.h != c.h) return false;
+    for (uint32_t y = 0; y < c.h; y++) {
+        const uint8_t* row = src.data + (intptr_t)src.stride * y;
+        const uint8_t* want = &px[(size_t)y * c.w * bpp];
+        for (uint32_t x = 0; x < c.w; x++) {
+            for (int k = 0; k < bpp; k++) {
+                int from = c.bmp && k < 3 ? 2 - k : k;
+                if (row[x * bpp + from] != want[x * bpp + k]) return false;
+            }
+        }
+    }
+    return true;
+}
+
+static double msSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main() {
+    static TranscodeSource src;
+    std::vector<uint16_t> pixels(TARGET_W * TARGET_H), back(TARGET_W * TARGET_H);
+    Bytes rle(TARGET_W * TARGET_H * 2);
+    int failures = 0;
+
+    printf("source                    file KB  decode ms  scale ms  RLE ms  total ms   Kpx/s  .bin KB  check\n");
+    for (const ImageCase& c : cases) {
+        Bytes px = makePixels(c);
+        Bytes file = c.bmp ? makeBmp(c, px) : makePng(c, px);
+
+        double decodeMs = 0, scaleMs = 0, rleMs = 0;
+        bool ok = true;
+        size_t rleLen = 0;
+        for (int rep = 0; rep < REPS && ok; rep++) {
+            Bytes work = file;   // PNG decoding compacts the file buffer in place
+            Bytes raw;
+            auto t0 = std::chrono::steady_clock::now();
+            if (c.bmp) {
+                ok = transcoder_parse_bmp(work.data(), work.size(), &src);
+            } else {
+                raw.resize(transcoder_png_raw_size(work.data(), work.size(), NULL, NULL));
+                ok = !raw.empty() && transcoder_decode_png(work.data(), work.size(), raw.data(), raw.size(),
+                                                           zlibInflate, &src);
+            }
+            decodeMs += msSince(t0);
+            if (ok && rep == 0) ok = sourceMatches(c, src, px);
+            if (!ok) break;
+
+            t0 = std::chrono::steady_clock::now();
+            ok = transcoder_scale_to_rgb565(&src, pixels.data(), TARGET_W, TARGET_H);
+            scaleMs += msSince(t0);
+
+            t0 = std::chrono::steady_clock::now();
+            rleLen = transcoder_rle_encode((const uint8_t*)pixels.data(), pixels.size() * 2, 2, rle.data(),
+                                           rle.size() - 1);
+            rleMs += msSince(t0);
+        }
+        if (ok && rleLen) {
+            ok = transcoder_rle_decode(rle.data(), rleLen, (uint8_t*)back.data(), back.size() * 2, 2) ==
+                     back.size() * 2 && back == pixels;
+        }
+
+        double total = (decodeMs + scaleMs + rleMs) / REPS;
+        size_t binBytes = rleLen ? rleLen : pixels.size() * 2;
+        printf("%s %8.0f %10.1f %9.1f %7.1f %9.1f %7.0f %8.0f  %s\n", c.name, file.size() / 1024.0,
+               decodeMs / REPS, scaleMs / REPS, rleMs / REPS, total, c.w * c.h / total, binBytes / 1024.0,
+               ok ? "ok" : "FAILED");
+        if (!ok) failures++;
+    }
+
+    printf("%s\n", failures ? "FAILED" : "all images decoded and round-tripped");
+    return failures ? 1 : 0;
+}